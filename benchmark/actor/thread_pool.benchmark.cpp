@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// The single mutex/condition variable pool that ThreadPool replaced, kept as a baseline.
+class MutexThreadPool : public Scheduler {
+public:
+    MutexThreadPool(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            threads.emplace_back([this]() {
+                while (true) {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this] { return !queue.empty() || terminate; });
+                    if (terminate) {
+                        return;
+                    }
+                    auto mailbox = queue.front();
+                    queue.pop();
+                    lock.unlock();
+                    Mailbox::maybeReceive(mailbox);
+                }
+            });
+        }
+    }
+
+    ~MutexThreadPool() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            terminate = true;
+        }
+        cv.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void schedule(std::weak_ptr<Mailbox> mailbox) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push(mailbox);
+        }
+        cv.notify_one();
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::queue<std::weak_ptr<Mailbox>> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool terminate { false };
+};
+
+// Each actor does a small amount of work per message and forwards a message to the next actor,
+// approximating many tile workers talking to each other and to their sources.
+struct Worker {
+    std::vector<std::unique_ptr<Actor<Worker>>>& actors;
+    std::atomic<int>& remaining;
+    std::promise<void>& done;
+    std::size_t index;
+
+    Worker(ActorRef<Worker>, std::vector<std::unique_ptr<Actor<Worker>>>& actors_,
+           std::atomic<int>& remaining_, std::promise<void>& done_, std::size_t index_)
+        : actors(actors_), remaining(remaining_), done(done_), index(index_) {
+    }
+
+    void receive(int hops) {
+        volatile std::size_t sum = 0;
+        for (std::size_t i = 0; i < 256; ++i) {
+            sum += i * index;
+        }
+
+        if (hops > 0) {
+            actors[(index + 1) % actors.size()]->invoke(&Worker::receive, hops - 1);
+        } else if (--remaining == 0) {
+            done.set_value();
+        }
+    }
+};
+
+template <class Pool>
+void runMailboxes(benchmark::State& state, Pool& pool) {
+    const std::size_t mailboxCount = state.range(0);
+    const int messagesPerMailbox = 16;
+    const int hops = 8;
+
+    while (state.KeepRunning()) {
+        std::vector<std::unique_ptr<Actor<Worker>>> actors;
+        std::atomic<int> remaining { int(mailboxCount) * messagesPerMailbox };
+        std::promise<void> done;
+
+        for (std::size_t i = 0; i < mailboxCount; ++i) {
+            actors.emplace_back(std::make_unique<Actor<Worker>>(pool, std::ref(actors),
+                std::ref(remaining), std::ref(done), i));
+        }
+
+        for (int m = 0; m < messagesPerMailbox; ++m) {
+            for (auto& actor : actors) {
+                actor->invoke(&Worker::receive, hops);
+            }
+        }
+
+        done.get_future().wait();
+    }
+
+    state.SetItemsProcessed(state.iterations() * mailboxCount * messagesPerMailbox * (hops + 1));
+}
+
+} // end namespace
+
+static void Actor_MutexThreadPool(benchmark::State& state) {
+    MutexThreadPool pool { ThreadPool::defaultThreadCount() };
+    runMailboxes(state, pool);
+}
+
+static void Actor_ThreadPool(benchmark::State& state) {
+    ThreadPool pool { ThreadPool::defaultThreadCount() };
+    runMailboxes(state, pool);
+}
+
+BENCHMARK(Actor_MutexThreadPool)->Arg(16)->Arg(256)->Arg(2048);
+BENCHMARK(Actor_ThreadPool)->Arg(16)->Arg(256)->Arg(2048);
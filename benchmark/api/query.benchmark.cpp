@@ -40,6 +40,15 @@ public:
     ThreadPool threadPool{ 4 };
     Map map{ backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
     ScreenBox box{{ 0, 0 }, { 1000, 1000 }};
+
+    // Issues an asynchronous query and runs the loop until its results arrive.
+    template <class Query>
+    void wait(Query&& query) {
+        query([&] (std::vector<Feature>) {
+            loop.stop();
+        });
+        loop.run();
+    }
 };
 
 } // end namespace
@@ -68,6 +77,65 @@ static void API_queryRenderedFeaturesLayerFromHighDensity(::benchmark::State& st
     }
 }
 
+// Measures the latency of an asynchronous query, from issuing it to receiving the results.
+static void API_queryRenderedFeaturesAllAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.wait([&] (Map::FeatureQueryCallback callback) {
+            bench.map.queryRenderedFeatures(bench.box, {}, std::move(callback));
+        });
+    }
+}
+
+static void API_queryRenderedFeaturesLayerFromHighDensityAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.wait([&] (Map::FeatureQueryCallback callback) {
+            bench.map.queryRenderedFeatures(bench.box, {{{ "road-street" }}, {}}, std::move(callback));
+        });
+    }
+}
+
+// Measures how long an asynchronous query blocks the calling thread.
+static void API_queryRenderedFeaturesAllAsyncIssue(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.map.queryRenderedFeatures(bench.box, {}, [&] (std::vector<Feature>) {
+            bench.loop.stop();
+        });
+
+        state.PauseTiming();
+        bench.loop.run();
+        state.ResumeTiming();
+    }
+}
+
+static void API_querySourceFeatures(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.map.querySourceFeatures("composite", {{{ "road" }}, {}});
+    }
+}
+
+static void API_querySourceFeaturesAsync(::benchmark::State& state) {
+    QueryBenchmark bench;
+
+    while (state.KeepRunning()) {
+        bench.wait([&] (Map::FeatureQueryCallback callback) {
+            bench.map.querySourceFeatures("composite", {{{ "road" }}, {}}, std::move(callback));
+        });
+    }
+}
+
 BENCHMARK(API_queryRenderedFeaturesAll);
 BENCHMARK(API_queryRenderedFeaturesLayerFromLowDensity);
 BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensity);
+BENCHMARK(API_queryRenderedFeaturesAllAsync);
+BENCHMARK(API_queryRenderedFeaturesLayerFromHighDensityAsync);
+BENCHMARK(API_queryRenderedFeaturesAllAsyncIssue);
+BENCHMARK(API_querySourceFeatures);
+BENCHMARK(API_querySourceFeaturesAsync);
@@ -12,6 +12,7 @@
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/render_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 using namespace mbgl;
@@ -74,6 +75,79 @@ static void API_renderStill_recreate_map(::benchmark::State& state) {
     }
 }
 
+// Reads each image back through a pixel buffer while the next image renders, the way renderBatch()
+// in the Node bindings does. API_renderStill_reuse_map waits for every read instead.
+static void API_renderStill_pipelined_read(::benchmark::State& state) {
+    RenderBenchmark bench;
+    Map map { bench.backend, bench.view.getSize(), 1, bench.fileSource, bench.threadPool, MapMode::Still };
+    prepare(map);
+
+    bool pendingRead = false;
+    while (state.KeepRunning()) {
+        bool finished = false;
+        map.renderStill(bench.view, [&](std::exception_ptr error) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            bench.view.startStillImageRead();
+            finished = true;
+        });
+
+        while (!finished) {
+            util::RunLoop::Get()->runOnce();
+        }
+
+        // Collect the image of the previous iteration, whose read overlapped with this render.
+        if (pendingRead) {
+            bench.view.readStillImage();
+        }
+        pendingRead = true;
+    }
+
+    if (pendingRead) {
+        bench.view.readStillImage();
+    }
+}
+
+static void API_renderStill_pool(::benchmark::State& state) {
+    NetworkStatus::Set(NetworkStatus::Status::Offline);
+
+    util::RunLoop loop;
+    DefaultFileSource fileSource { "benchmark/fixtures/api/cache.db", "." };
+    fileSource.setAccessToken("foobar");
+    ThreadPool threadPool { 4 };
+
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    RenderPool pool { threads, fileSource, threadPool };
+
+    RenderPool::Job job;
+    job.style = util::read_file("benchmark/fixtures/api/style.json");
+    job.camera.center = LatLng { 40.726989, -73.992857 }; // Manhattan
+    job.camera.zoom = 15;
+    job.size = { 1000, 1000 };
+
+    // Each iteration renders one image per thread, so the time per iteration stays constant if
+    // throughput scales linearly with the number of threads.
+    while (state.KeepRunning()) {
+        std::size_t finished = 0;
+        for (std::size_t i = 0; i < threads; i++) {
+            pool.render(job, [&](std::exception_ptr error, PremultipliedImage) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+                finished++;
+            });
+        }
+        while (finished < threads) {
+            loop.runOnce();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * threads);
+}
+
 BENCHMARK(API_renderStill_reuse_map);
 BENCHMARK(API_renderStill_reuse_map_switch_styles);
 BENCHMARK(API_renderStill_recreate_map);
+BENCHMARK(API_renderStill_pipelined_read);
+BENCHMARK(API_renderStill_pool)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
@@ -2,6 +2,7 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
@@ -38,5 +39,59 @@ static void Parse_EvaluateFilter(benchmark::State& state) {
     }
 }
 
+// A road filter in the style of Mapbox Streets, evaluated against a mix of features that the
+// filter rejects early (wrong type), late (wrong structure), and ones that it accepts.
+static const char* roadFilter = R"FILTER(["all",
+    ["!=", "structure", "tunnel"],
+    ["!=", "structure", "bridge"],
+    ["in", "class", "motorway", "trunk", "primary", "secondary", "tertiary", "street"],
+    ["==", "$type", "LineString"]
+])FILTER";
+
+static std::vector<std::pair<FeatureType, PropertyMap>> roadFeatures() {
+    std::vector<std::pair<FeatureType, PropertyMap>> features;
+    for (const char* class_ : { "motorway", "street", "path", "service" }) {
+        for (const char* structure : { "none", "bridge", "tunnel" }) {
+            for (FeatureType type : { FeatureType::Point, FeatureType::LineString, FeatureType::Polygon }) {
+                features.emplace_back(type, PropertyMap {
+                    { "class", std::string(class_) },
+                    { "structure", std::string(structure) },
+                    { "oneway", std::string("false") },
+                    { "len", int64_t(120) },
+                });
+            }
+        }
+    }
+    return features;
+}
+
+template <class F>
+static void evaluate(benchmark::State& state, const F& filter) {
+    const auto features = roadFeatures();
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : features) {
+            benchmark::DoNotOptimize(filter(feature.first, {}, [&] (const std::string& key) -> optional<Value> {
+                auto it = feature.second.find(key);
+                if (it == feature.second.end())
+                    return {};
+                return it->second;
+            }));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * features.size());
+}
+
+static void Parse_EvaluateRoadFilter(benchmark::State& state) {
+    evaluate(state, parse(roadFilter));
+}
+
+static void Parse_EvaluateCompiledRoadFilter(benchmark::State& state) {
+    evaluate(state, style::CompiledFilter(parse(roadFilter)));
+}
+
 BENCHMARK(Parse_Filter);
 BENCHMARK(Parse_EvaluateFilter);
+BENCHMARK(Parse_EvaluateRoadFilter);
+BENCHMARK(Parse_EvaluateCompiledRoadFilter);
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A satellite imagery tile, in each of the formats that raster sources commonly serve.
+const char* const tiles[] = {
+    "test/fixtures/image/tile.jpeg",
+    "test/fixtures/image/tile.png",
+#if !defined(__APPLE__)
+    "test/fixtures/image/tile.webp",
+#endif
+};
+
+void tileArguments(::benchmark::internal::Benchmark* benchmark) {
+    for (std::size_t i = 0; i < sizeof(tiles) / sizeof(tiles[0]); ++i) {
+        benchmark->Arg(i);
+    }
+}
+
+} // end namespace
+
+// Decodes the way raster tiles were decoded before, premultiplying and then unpremultiplying.
+static void Parse_RasterTile_Premultiplied(::benchmark::State& state) {
+    const std::string data = util::read_file(tiles[state.range(0)]);
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(util::unpremultiply(decodeImage(data)));
+    }
+}
+
+static void Parse_RasterTile(::benchmark::State& state) {
+    const std::string data = util::read_file(tiles[state.range(0)]);
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(decodeUnassociatedImage(data));
+    }
+}
+
+static void Util_premultiply(::benchmark::State& state) {
+    const UnassociatedImage image = decodeUnassociatedImage(util::read_file(tiles[0]));
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(util::premultiply(image.clone()));
+    }
+}
+
+static void Util_unpremultiply(::benchmark::State& state) {
+    const PremultipliedImage image = decodeImage(util::read_file(tiles[0]));
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(util::unpremultiply(image.clone()));
+    }
+}
+
+BENCHMARK(Parse_RasterTile_Premultiplied)->Apply(tileArguments);
+BENCHMARK(Parse_RasterTile)->Apply(tileArguments);
+BENCHMARK(Util_premultiply);
+BENCHMARK(Util_unpremultiply);
@@ -3,6 +3,9 @@
 #include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/util/io.hpp>
 
+#include <memory>
+#include <vector>
+
 using namespace mbgl;
 
 static void Parse_VectorTile(benchmark::State& state) {
@@ -26,3 +29,61 @@ static void Parse_VectorTile(benchmark::State& state) {
 }
 
 BENCHMARK(Parse_VectorTile);
+
+// Simulates a layout in which every source layer is used by several style layers, each of which
+// filters all features and reads the geometries of the ones that pass.
+static const std::size_t styleLayersPerSourceLayer = 10;
+
+static std::size_t layOutSourceLayer(const GeometryTileLayer& layer) {
+    std::size_t length = 0;
+    const std::size_t count = layer.featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        auto feature = layer.getFeature(i);
+        if (feature->getValue("class") || feature->getType() == FeatureType::Polygon) {
+            length += feature->getGeometries().size();
+        }
+    }
+    return length;
+}
+
+static void Parse_VectorTile_DecodePerStyleLayer(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const auto names = VectorTileData(data).layerNames();
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        for (const auto& name : names) {
+            for (std::size_t j = 0; j < styleLayersPerSourceLayer; j++) {
+                // A separate tile data object per style layer decodes every feature again.
+                VectorTileData tile(data);
+                if (auto layer = tile.getLayer(name)) {
+                    length += layOutSourceLayer(*layer);
+                }
+            }
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+static void Parse_VectorTile_DecodeShared(benchmark::State& state) {
+    auto data = std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+    const auto names = VectorTileData(data).layerNames();
+
+    while (state.KeepRunning()) {
+        std::size_t length = 0;
+        VectorTileData tile(data);
+        for (const auto& name : names) {
+            std::vector<std::unique_ptr<GeometryTileLayer>> layers;
+            for (std::size_t j = 0; j < styleLayersPerSourceLayer; j++) {
+                if (auto layer = tile.getLayer(name)) {
+                    length += layOutSourceLayer(*layer);
+                    layers.push_back(std::move(layer));
+                }
+            }
+        }
+        benchmark::DoNotOptimize(length);
+    }
+}
+
+BENCHMARK(Parse_VectorTile_DecodePerStyleLayer);
+BENCHMARK(Parse_VectorTile_DecodeShared);
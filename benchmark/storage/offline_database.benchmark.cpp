@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/string.hpp>
+
+#include <random>
+
+using namespace mbgl;
+
+namespace {
+
+const std::string path = "benchmark/fixtures/offline_database.db";
+
+void deleteDatabase() {
+    for (const char* suffix : { "", "-wal", "-shm" }) {
+        try {
+            util::deleteFile(path + suffix);
+        } catch (const util::IOException&) {
+            // The file doesn't exist.
+        }
+    }
+}
+
+// Small tile responses that don't compress well, like most vector tiles.
+Response tileResponse(std::mt19937& generator) {
+    std::uniform_int_distribution<int> distribution(0, 255);
+    auto data = std::make_shared<std::string>(4 * 1024, 0);
+    for (char& c : *data) {
+        c = static_cast<char>(distribution(generator));
+    }
+    Response response;
+    response.data = data;
+    return response;
+}
+
+Resource tileResource(int32_t i) {
+    return Resource::tile("mapbox://tiles/{z}/{x}/{y}.vector.pbf", 1.0, i % 256, i / 256, 16, Tileset::Scheme::XYZ);
+}
+
+void put(benchmark::State& state, bool writeAheadLog, std::size_t batchSize) {
+    deleteDatabase();
+
+    std::mt19937 generator(0);
+    const Response response = tileResponse(generator);
+    int32_t i = 0;
+
+    {
+        OfflineDatabase db(path);
+        db.setWriteAheadLog(writeAheadLog);
+        db.setMaximumBatchSize(batchSize);
+
+        while (state.KeepRunning()) {
+            db.put(tileResource(i++), response);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    deleteDatabase();
+}
+
+void get(benchmark::State& state, bool writeAheadLog, std::size_t batchSize) {
+    deleteDatabase();
+
+    std::mt19937 generator(0);
+    const Response response = tileResponse(generator);
+    const int32_t count = 256;
+
+    {
+        OfflineDatabase db(path);
+        db.setWriteAheadLog(writeAheadLog);
+        db.setMaximumBatchSize(batchSize);
+
+        for (int32_t i = 0; i < count; ++i) {
+            db.put(tileResource(i), response);
+        }
+        db.flush();
+
+        int32_t i = 0;
+        while (state.KeepRunning()) {
+            benchmark::DoNotOptimize(db.get(tileResource(i++ % count)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    deleteDatabase();
+}
+
+} // namespace
+
+static void Storage_OfflineDatabase_Put(benchmark::State& state) {
+    put(state, false, 1);
+}
+
+static void Storage_OfflineDatabase_PutBatched(benchmark::State& state) {
+    put(state, true, state.range(0));
+}
+
+static void Storage_OfflineDatabase_Get(benchmark::State& state) {
+    get(state, false, 1);
+}
+
+static void Storage_OfflineDatabase_GetWriteAheadLog(benchmark::State& state) {
+    get(state, true, 1);
+}
+
+BENCHMARK(Storage_OfflineDatabase_Put);
+BENCHMARK(Storage_OfflineDatabase_PutBatched)->Arg(1)->Arg(16)->Arg(128);
+BENCHMARK(Storage_OfflineDatabase_Get);
+BENCHMARK(Storage_OfflineDatabase_GetWriteAheadLog);
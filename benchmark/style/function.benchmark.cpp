@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/style/function/source_function.hpp>
+#include <mbgl/util/interpolate.hpp>
+
+#include <map>
+#include <vector>
+
+using namespace mbgl;
+using namespace mbgl::style;
+
+namespace {
+
+// A line width ramp in the style of Mapbox Streets.
+const std::map<float, float> widthStops {
+    { 5.0f, 0.5f }, { 8.0f, 1.0f }, { 10.0f, 1.5f }, { 12.0f, 2.5f },
+    { 14.0f, 4.0f }, { 16.0f, 8.0f }, { 18.0f, 20.0f }, { 20.0f, 40.0f }
+};
+
+const float widthBase = 1.4f;
+
+std::vector<float> zooms() {
+    std::vector<float> result;
+    for (float z = 0.0f; z <= 22.0f; z += 0.1f) {
+        result.push_back(z);
+    }
+    return result;
+}
+
+class Feature {
+public:
+    optional<Value> getValue(const std::string& key) const {
+        auto it = properties.find(key);
+        if (it == properties.end())
+            return {};
+        return it->second;
+    }
+
+    PropertyMap properties;
+};
+
+std::vector<Feature> features() {
+    std::vector<Feature> result;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        Feature feature;
+        feature.properties.emplace("class", std::string("street"));
+        feature.properties.emplace("rank", int64_t(i % 30));
+        if (i % 10) {
+            feature.properties.emplace("height", double(i % 250));
+        }
+        result.push_back(std::move(feature));
+    }
+    return result;
+}
+
+} // end namespace
+
+// Evaluates the stops the way they were evaluated before they were lowered into flat arrays.
+static void Function_ExponentialStops_Map(benchmark::State& state) {
+    const auto zs = zooms();
+
+    while (state.KeepRunning()) {
+        for (float z : zs) {
+            auto it = widthStops.upper_bound(z);
+            if (it == widthStops.end()) {
+                benchmark::DoNotOptimize(widthStops.rbegin()->second);
+            } else if (it == widthStops.begin()) {
+                benchmark::DoNotOptimize(widthStops.begin()->second);
+            } else {
+                benchmark::DoNotOptimize(util::interpolate(std::prev(it)->second, it->second,
+                    util::interpolationFactor(widthBase, { std::prev(it)->first, it->first }, z)));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * zs.size());
+}
+
+static void Function_ExponentialStops(benchmark::State& state) {
+    const ExponentialStops<float> stops(widthStops, widthBase);
+    const auto zs = zooms();
+
+    while (state.KeepRunning()) {
+        for (float z : zs) {
+            benchmark::DoNotOptimize(stops.evaluate(z));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * zs.size());
+}
+
+static void Function_IntervalStops(benchmark::State& state) {
+    const IntervalStops<float> stops(widthStops);
+    const auto zs = zooms();
+
+    while (state.KeepRunning()) {
+        for (float z : zs) {
+            benchmark::DoNotOptimize(stops.evaluate(z));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * zs.size());
+}
+
+static void Function_SourceFunction(benchmark::State& state) {
+    const SourceFunction<float> function("height", ExponentialStops<float>({{ 0.0f, 0.0f }, { 100.0f, 1.0f }, { 250.0f, 0.2f }}, 1.2f));
+    const auto features_ = features();
+
+    while (state.KeepRunning()) {
+        for (const auto& feature : features_) {
+            benchmark::DoNotOptimize(function.evaluate(feature, 0.0f));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * features_.size());
+}
+
+BENCHMARK(Function_ExponentialStops_Map);
+BENCHMARK(Function_ExponentialStops);
+BENCHMARK(Function_IntervalStops);
+BENCHMARK(Function_SourceFunction);
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/image_encoder.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// Renders the benchmark style once, so that the images are encoded from real map output.
+const PremultipliedImage& renderedImage() {
+    static const PremultipliedImage image = [] {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+
+        util::RunLoop loop;
+        HeadlessBackend backend;
+        BackendScope scope { backend };
+        OffscreenView view { backend.getContext(), { 512, 512 } };
+        DefaultFileSource fileSource { "benchmark/fixtures/api/cache.db", "." };
+        fileSource.setAccessToken("foobar");
+        ThreadPool threadPool { 4 };
+
+        Map map { backend, view.getSize(), 1, fileSource, threadPool, MapMode::Still };
+        map.getStyle().loadJSON(util::read_file("benchmark/fixtures/api/style.json"));
+        map.setLatLngZoom({ 40.726989, -73.992857 }, 15); // Manhattan
+        mbgl::benchmark::render(map, view);
+        return view.readStillImage();
+    }();
+    return image;
+}
+
+} // end namespace
+
+static void Util_encodePNG(::benchmark::State& state) {
+    const PremultipliedImage& image = renderedImage();
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(encodePNG(image));
+    }
+}
+
+static void Util_ImageEncoder_encodePNG(::benchmark::State& state) {
+    const PremultipliedImage& image = renderedImage();
+    ImageEncoder::Options options;
+    options.compressionLevel = state.range(0);
+    ImageEncoder encoder(options);
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(encoder.encodePNG(image));
+    }
+}
+
+static void Util_ImageEncoder_encodePNG_palette(::benchmark::State& state) {
+    const PremultipliedImage& image = renderedImage();
+    ImageEncoder::Options options;
+    options.palette = true;
+    ImageEncoder encoder(options);
+
+    while (state.KeepRunning()) {
+        ::benchmark::DoNotOptimize(encoder.encodePNG(image));
+    }
+}
+
+BENCHMARK(Util_encodePNG);
+BENCHMARK(Util_ImageEncoder_encodePNG)->Arg(1)->Arg(6);
+BENCHMARK(Util_ImageEncoder_encodePNG_palette);
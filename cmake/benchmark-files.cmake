@@ -1,6 +1,9 @@
 # Do not edit. Regenerate this with ./scripts/generate-benchmark-files.sh
 
 set(MBGL_BENCHMARK_FILES
+    # actor
+    benchmark/actor/thread_pool.benchmark.cpp
+
     # api
     benchmark/api/query.benchmark.cpp
     benchmark/api/render.benchmark.cpp
@@ -10,6 +13,7 @@ set(MBGL_BENCHMARK_FILES
 
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/raster_tile.benchmark.cpp
     benchmark/parse/vector_tile.benchmark.cpp
 
     # src
@@ -19,4 +23,13 @@ set(MBGL_BENCHMARK_FILES
     benchmark/src/mbgl/benchmark/benchmark.cpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
+
+    # storage
+    benchmark/storage/offline_database.benchmark.cpp
+
+    # style
+    benchmark/style/function.benchmark.cpp
+
+    # util
+    benchmark/util/image_encoder.benchmark.cpp
 )
@@ -46,6 +46,8 @@ set(MBGL_CORE_FILES
     src/mbgl/geometry/feature_index.hpp
     src/mbgl/geometry/line_atlas.cpp
     src/mbgl/geometry/line_atlas.hpp
+    src/mbgl/geometry/source_feature_index.cpp
+    src/mbgl/geometry/source_feature_index.hpp
 
     # gl
     src/mbgl/gl/attribute.cpp
@@ -69,6 +71,7 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/index_buffer.hpp
     src/mbgl/gl/object.cpp
     src/mbgl/gl/object.hpp
+    src/mbgl/gl/pixel_buffer_extension.hpp
     src/mbgl/gl/primitives.hpp
     src/mbgl/gl/program.hpp
     src/mbgl/gl/program_binary_extension.hpp
@@ -79,6 +82,7 @@ set(MBGL_CORE_FILES
     src/mbgl/gl/stencil_mode.cpp
     src/mbgl/gl/stencil_mode.hpp
     src/mbgl/gl/texture.hpp
+    src/mbgl/gl/timer_query_extension.hpp
     src/mbgl/gl/types.hpp
     src/mbgl/gl/uniform.cpp
     src/mbgl/gl/uniform.hpp
@@ -107,10 +111,12 @@ set(MBGL_CORE_FILES
     include/mbgl/map/map_observer.hpp
     include/mbgl/map/mode.hpp
     include/mbgl/map/query.hpp
+    include/mbgl/map/render_profile.hpp
     include/mbgl/map/view.hpp
     src/mbgl/map/backend.cpp
     src/mbgl/map/backend_scope.cpp
     src/mbgl/map/map.cpp
+    src/mbgl/map/render_profile.cpp
     src/mbgl/map/transform.cpp
     src/mbgl/map/transform.hpp
     src/mbgl/map/transform_state.cpp
@@ -163,8 +169,12 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/cross_faded_property_evaluator.cpp
     src/mbgl/renderer/cross_faded_property_evaluator.hpp
     src/mbgl/renderer/data_driven_property_evaluator.hpp
+    src/mbgl/renderer/feature_query.cpp
+    src/mbgl/renderer/feature_query.hpp
     src/mbgl/renderer/frame_history.cpp
     src/mbgl/renderer/frame_history.hpp
+    src/mbgl/renderer/frame_profiler.cpp
+    src/mbgl/renderer/frame_profiler.hpp
     src/mbgl/renderer/group_by_layout.cpp
     src/mbgl/renderer/group_by_layout.hpp
     src/mbgl/renderer/image_atlas.cpp
@@ -195,6 +205,8 @@ set(MBGL_CORE_FILES
     src/mbgl/renderer/render_tile.hpp
     src/mbgl/renderer/style_diff.cpp
     src/mbgl/renderer/style_diff.hpp
+    src/mbgl/renderer/symbol_atlas.cpp
+    src/mbgl/renderer/symbol_atlas.hpp
     src/mbgl/renderer/tile_parameters.hpp
     src/mbgl/renderer/tile_pyramid.cpp
     src/mbgl/renderer/tile_pyramid.hpp
@@ -317,6 +329,7 @@ set(MBGL_CORE_FILES
     src/mbgl/storage/file_source_request.hpp
     src/mbgl/storage/http_file_source.hpp
     src/mbgl/storage/local_file_source.hpp
+    src/mbgl/storage/mbtiles_file_source.hpp
     src/mbgl/storage/network_status.cpp
     src/mbgl/storage/resource.cpp
     src/mbgl/storage/resource_transform.cpp
@@ -339,6 +352,8 @@ set(MBGL_CORE_FILES
     include/mbgl/style/types.hpp
     include/mbgl/style/undefined.hpp
     src/mbgl/style/collection.hpp
+    src/mbgl/style/compiled_filter.cpp
+    src/mbgl/style/compiled_filter.hpp
     src/mbgl/style/image.cpp
     src/mbgl/style/image_impl.cpp
     src/mbgl/style/image_impl.hpp
@@ -479,7 +494,6 @@ set(MBGL_CORE_FILES
     src/mbgl/text/get_anchors.hpp
     src/mbgl/text/glyph.cpp
     src/mbgl/text/glyph.hpp
-    src/mbgl/text/glyph_atlas.cpp
     src/mbgl/text/glyph_atlas.hpp
     src/mbgl/text/glyph_manager.cpp
     src/mbgl/text/glyph_manager.hpp
@@ -544,6 +558,7 @@ set(MBGL_CORE_FILES
     include/mbgl/util/indexed_tuple.hpp
     include/mbgl/util/interpolate.hpp
     include/mbgl/util/logging.hpp
+    include/mbgl/util/mapped_file.hpp
     include/mbgl/util/noncopyable.hpp
     include/mbgl/util/optional.hpp
     include/mbgl/util/platform.hpp
@@ -602,9 +617,12 @@ set(MBGL_CORE_FILES
     src/mbgl/util/math.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
+    src/mbgl/util/parallel_for.cpp
+    src/mbgl/util/parallel_for.hpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
+    src/mbgl/util/resource_registry.hpp
     src/mbgl/util/std.hpp
     src/mbgl/util/stopwatch.cpp
     src/mbgl/util/stopwatch.hpp
@@ -15,8 +15,10 @@ set(MBGL_TEST_FILES
     test/api/annotations.test.cpp
     test/api/api_misuse.test.cpp
     test/api/custom_layer.test.cpp
+    test/api/metatile.test.cpp
     test/api/query.test.cpp
     test/api/render_missing.test.cpp
+    test/api/render_pool.test.cpp
     test/api/repeated_render.test.cpp
 
     # gl
@@ -43,6 +45,7 @@ set(MBGL_TEST_FILES
     # renderer
     test/renderer/group_by_layout.test.cpp
     test/renderer/image_manager.test.cpp
+    test/renderer/symbol_atlas.test.cpp
 
     # sprite
     test/sprite/sprite_loader.test.cpp
@@ -72,6 +75,7 @@ set(MBGL_TEST_FILES
     test/storage/headers.test.cpp
     test/storage/http_file_source.test.cpp
     test/storage/local_file_source.test.cpp
+    test/storage/mbtiles_file_source.test.cpp
     test/storage/offline.test.cpp
     test/storage/offline_database.test.cpp
     test/storage/offline_download.test.cpp
@@ -114,6 +118,7 @@ set(MBGL_TEST_FILES
     test/tile/geojson_tile.test.cpp
     test/tile/geometry_tile_data.test.cpp
     test/tile/raster_tile.test.cpp
+    test/tile/tile_cache.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
     test/tile/vector_tile.test.cpp
@@ -123,13 +128,16 @@ set(MBGL_TEST_FILES
     test/util/geo.test.cpp
     test/util/http_timeout.test.cpp
     test/util/image.test.cpp
+    test/util/image_encoder.test.cpp
     test/util/mapbox.test.cpp
     test/util/memory.test.cpp
     test/util/merge_lines.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
+    test/util/parallel_for.test.cpp
     test/util/position.test.cpp
     test/util/projection.test.cpp
+    test/util/resource_registry.test.cpp
     test/util/run_loop.test.cpp
     test/util/text_conversions.test.cpp
     test/util/thread.test.cpp
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -11,8 +13,19 @@ class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
+    // Schedulers that support prioritization process mailboxes with a higher priority first.
+    // Messages within a single mailbox are always processed in order, regardless of priority.
+    enum class Priority : uint8_t {
+        High,
+        Normal,
+        Low,
+    };
+
     Mailbox(Scheduler&);
 
+    void setPriority(Priority);
+    Priority getPriority() const;
+
     void push(std::unique_ptr<Message>);
 
     void close();
@@ -23,6 +36,8 @@ public:
 private:
     Scheduler& scheduler;
 
+    std::atomic<Priority> priority { Priority::Normal };
+
     std::recursive_mutex receivingMutex;
     std::mutex pushingMutex;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 namespace mbgl {
@@ -19,7 +20,8 @@ class Mailbox;
         concurrency within a mailbox
 
       Subject to these constraints, processing can happen on whatever thread in the
-      pool is available.
+      pool is available. Mailboxes with a higher `Mailbox::Priority` are preferred over
+      those with a lower priority.
 
     * `RunLoop` is a `Scheduler` that is typically used to create a mailbox and
       `ActorRef` for an object that lives on the main thread and is not itself wrapped
@@ -33,6 +35,10 @@ class Scheduler {
 public:
     virtual ~Scheduler() = default;
     virtual void schedule(std::weak_ptr<Mailbox>) = 0;
+
+    // The number of threads that process messages concurrently. Callers that split work
+    // across mailboxes use this to avoid scheduling more helpers than can actually run.
+    virtual std::size_t threadCount() const { return 1; }
 };
 
 } // namespace mbgl
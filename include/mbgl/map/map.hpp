@@ -11,6 +11,7 @@
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/map/camera.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/map/render_profile.hpp>
 
 #include <cstdint>
 #include <string>
@@ -154,6 +155,14 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenBox&,        const RenderedQueryOptions& options = {});
     std::vector<Feature> querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options = {});
 
+    // Asynchronous feature queries. The map's tiles and layers are snapshotted when the query is
+    // issued, and the query runs on the worker threads so that it doesn't stall rendering. The
+    // callback is called on the calling thread, unless the map is destroyed first.
+    using FeatureQueryCallback = std::function<void (std::vector<Feature>)>;
+    void queryRenderedFeatures(const ScreenCoordinate&, const RenderedQueryOptions&, FeatureQueryCallback);
+    void queryRenderedFeatures(const ScreenBox&,        const RenderedQueryOptions&, FeatureQueryCallback);
+    void querySourceFeatures(const std::string& sourceID, const SourceQueryOptions&, FeatureQueryCallback);
+
     AnnotationIDs queryPointAnnotations(const ScreenBox&);
 
     // Tile prefetching
@@ -165,9 +174,38 @@ public:
     void setPrefetchZoomDelta(uint8_t delta);
     uint8_t getPrefetchZoomDelta() const;
 
+    // Parallel tile layout
+    //
+    // When enabled, the independent groups of style layers within a tile are laid out
+    // concurrently on the worker threads, rather than one after another. This shortens the time
+    // until a tile with many layers is complete when few tiles are loading at once, e.g. when
+    // rendering still images. It takes effect for tiles created after it is changed, and is
+    // disabled by default.
+    void setParallelTileLayout(bool);
+    bool getParallelTileLayout() const;
+
     // Memory
+    //
+    // Tiles that are no longer visible are kept in a cache shared by all sources of the map, so
+    // that they can be displayed again without reloading them. The cache size is a budget in
+    // bytes, measured against an estimate of each tile's render data. The default size is 64 MB.
+    void setTileCacheSize(uint64_t size);
+    uint64_t getTileCacheSize() const;
+
     void onLowMemory();
 
+    // Profiling
+    //
+    // When enabled, the CPU time and, if the GL implementation supports timer queries, the GPU
+    // time of every render pass and style layer is recorded for the given number of most recent
+    // frames. Pass 0 to disable profiling, which is the default.
+    void setRenderProfiling(uint32_t frames);
+    uint32_t getRenderProfiling() const;
+
+    // Returns the timings averaged over the recorded frames. GPU timings lag a few frames
+    // behind, since their results are collected without waiting for the GPU.
+    RenderProfile getRenderProfile() const;
+
     // Debug
     void setDebug(MapDebugOptions);
     void cycleDebugOptions();
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/style/filter.hpp>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mbgl {
@@ -24,10 +26,24 @@ public:
  */
 class SourceQueryOptions {
 public:
+    SourceQueryOptions(optional<std::vector<std::string>> sourceLayers_ = {},
+                       optional<style::Filter> filter_ = {})
+        : sourceLayers(std::move(sourceLayers_)),
+          filter(std::move(filter_)) {}
+
     // Required for VectorSource, ignored for GeoJSONSource
     optional<std::vector<std::string>> sourceLayers;
 
     optional<style::Filter> filter;
+
+    // Only return features whose geometry intersects these bounds
+    optional<LatLngBounds> bounds;
+
+    // Return at most this many features
+    optional<std::size_t> limit;
+
+    // Only include these properties in the returned features, instead of all of them
+    optional<std::vector<std::string>> properties;
 };
 
 } // namespace mbgl
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+// Timings of the frames recorded while render profiling is enabled, see Map::setRenderProfiling().
+struct RenderProfile {
+    struct Timing {
+        std::string name;
+
+        // The number of recorded frames in which the pass or layer was rendered.
+        uint32_t frames = 0;
+
+        // Average time per frame in which it was rendered. CPU time is the time spent issuing
+        // commands on the render thread; GPU time is the time the GPU spent executing them, and
+        // is only available if the context supports timer queries.
+        Duration cpuTime = Duration::zero();
+        optional<Duration> gpuTime;
+    };
+
+    // The number of frames that the timings were averaged over.
+    uint32_t frames = 0;
+
+    // Time for the whole frame.
+    Timing total;
+
+    // The render passes (upload, clear, clip, opaque, translucent, debug) in the order in which
+    // they're rendered.
+    std::vector<Timing> passes;
+
+    // The style layers, most expensive first. The time of a layer that is rendered in both the
+    // opaque and translucent pass is the sum of both.
+    std::vector<Timing> layers;
+
+    std::string toJSON() const;
+};
+
+} // namespace mbgl
@@ -47,6 +47,7 @@ public:
     void setResourceTransform(optional<ActorRef<ResourceTransform>>&&);
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, Resource::Priority) override;
 
     /*
      * Retrieve all regions in the offline database.
@@ -123,6 +124,17 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Use a write-ahead log for the cache database, and group ambient cache
+     * writes into transactions that are committed at least once a second.
+     *
+     * This greatly reduces the number of disk syncs under heavy tile traffic.
+     * The database can't be corrupted by a crash, but the last second of
+     * ambient cache writes may be lost. Offline region changes are always
+     * committed immediately.
+     */
+    void setCacheWriteAheadLog(bool);
+
     /*
      * Pause file request activity.
      *
@@ -24,6 +24,11 @@ public:
     // not be executed.
     virtual std::unique_ptr<AsyncRequest> request(const Resource&, Callback) = 0;
 
+    // Changes the priority of a request returned by this file source. A request that is waiting
+    // for a network connection moves up or down among the other waiting requests. File sources
+    // that don't queue requests ignore it.
+    virtual void setPriority(AsyncRequest&, Resource::Priority) {}
+
     // When a file source supports optional requests, it must return true.
     // Optional requests are requests that aren't as urgent, but could be useful, e.g.
     // to cover part of the map while loading. The FileSource should only do cheap actions to
@@ -23,6 +23,7 @@ public:
     void setResourceTransform(optional<ActorRef<ResourceTransform>>&&);
 
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+    void setPriority(AsyncRequest&, Resource::Priority) override;
 
 private:
     friend class OnlineFileRequest;
@@ -35,6 +35,14 @@ public:
         Required = true,
     };
 
+    // When the number of concurrent network requests is limited, pending requests are started
+    // in order of kind (tiles last), necessity, and then this priority.
+    enum Priority : uint8_t {
+        High = 0,
+        Normal,
+        Low,
+    };
+
     Resource(Kind kind_, std::string url_, optional<TileData> tileData_ = {}, Necessity necessity_ = Required)
         : kind(kind_),
           necessity(necessity_),
@@ -60,6 +68,7 @@ public:
     
     Kind kind;
     Necessity necessity;
+    Priority priority = Normal;
     std::string url;
 
     // Includes auxiliary data if this is a tile request.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/util/chrono.hpp>
+#include <mbgl/util/mapped_file.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/variant.hpp>
 
@@ -30,6 +31,10 @@ public:
     // The actual data of the response. Present only for non-error, non-notModified responses.
     std::shared_ptr<const std::string> data;
 
+    // File sources that serve tiles from memory-mapped files may set this instead of `data`, so
+    // that consumers which can read the data in place don't copy it.
+    optional<util::MappedData> mappedData;
+
     optional<Timestamp> modified;
     optional<Timestamp> expires;
     optional<std::string> etag;
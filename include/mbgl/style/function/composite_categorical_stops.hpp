@@ -9,21 +9,33 @@ template <class T>
 class CompositeCategoricalStops {
 public:
     using Stops = std::map<float, std::map<CategoricalValue, T>>;
-    Stops stops;
+    using InnerStops = CategoricalStops<T>;
 
     CompositeCategoricalStops() = default;
     CompositeCategoricalStops(Stops stops_)
         : stops(std::move(stops_)) {
+        for (const auto& stop : stops) {
+            innerStops.emplace_hint(innerStops.end(), stop.first, InnerStops(stop.second));
+        }
+    }
+
+    const Stops& getStops() const {
+        return stops;
     }
 
-    CategoricalStops<T> innerStops(const std::map<CategoricalValue, T>& stops_) const {
-        return CategoricalStops<T>(stops_);
+    // The inner stops of each zoom stop, built once when the stops are constructed.
+    const std::map<float, InnerStops>& getInnerStops() const {
+        return innerStops;
     }
 
     friend bool operator==(const CompositeCategoricalStops& lhs,
                            const CompositeCategoricalStops& rhs) {
         return lhs.stops == rhs.stops;
     }
+
+private:
+    Stops stops;
+    std::map<float, InnerStops> innerStops;
 };
 
 } // namespace style
@@ -11,24 +11,39 @@ template <class T>
 class CompositeExponentialStops {
 public:
     using Stops = std::map<float, std::map<float, T>>;
-
-    Stops stops;
-    float base = 1.0f;
+    using InnerStops = ExponentialStops<T>;
 
     CompositeExponentialStops() = default;
     CompositeExponentialStops(Stops stops_, float base_ = 1.0f)
         : stops(std::move(stops_)),
           base(base_) {
+        for (const auto& stop : stops) {
+            innerStops.emplace_hint(innerStops.end(), stop.first, InnerStops(stop.second, base));
+        }
+    }
+
+    const Stops& getStops() const {
+        return stops;
     }
 
-    ExponentialStops<T> innerStops(const std::map<float, T>& stops_) const {
-        return ExponentialStops<T>(stops_, base);
+    float getBase() const {
+        return base;
+    }
+
+    // The inner stops of each zoom stop, lowered once when the stops are constructed.
+    const std::map<float, InnerStops>& getInnerStops() const {
+        return innerStops;
     }
 
     friend bool operator==(const CompositeExponentialStops& lhs,
                            const CompositeExponentialStops& rhs) {
         return lhs.stops == rhs.stops && lhs.base == rhs.base;
     }
+
+private:
+    Stops stops;
+    float base = 1.0f;
+    std::map<float, InnerStops> innerStops;
 };
 
 } // namespace style
@@ -23,15 +23,16 @@ namespace style {
 template <class T>
 class CompositeFunction {
 public:
+    // Points to the lowered inner stops of one zoom stop, which are owned by the function.
     using InnerStops = std::conditional_t<
         util::Interpolatable<T>,
         variant<
-            ExponentialStops<T>,
-            IntervalStops<T>,
-            CategoricalStops<T>>,
+            const ExponentialStops<T>*,
+            const IntervalStops<T>*,
+            const CategoricalStops<T>*>,
         variant<
-            IntervalStops<T>,
-            CategoricalStops<T>>>;
+            const IntervalStops<T>*,
+            const CategoricalStops<T>*>>;
 
     using Stops = std::conditional_t<
         util::Interpolatable<T>,
@@ -58,28 +59,30 @@ public:
     // Return the relevant stop zoom values and inner stops that bracket a given zoom level. This
     // is the first step toward evaluating the function, and is used for in the course of both partial
     // evaluation of data-driven paint properties, and full evaluation of data-driven layout properties.
+    // The inner stops point into this function's stops, so they are only valid as long as it is.
     CoveringRanges coveringRanges(float zoom) const {
         return stops.match(
             [&] (const auto& s) {
-                assert(!s.stops.empty());
-                auto minIt = s.stops.lower_bound(zoom);
-                auto maxIt = s.stops.upper_bound(zoom);
+                const auto& innerStops = s.getInnerStops();
+                assert(!innerStops.empty());
+                auto minIt = innerStops.lower_bound(zoom);
+                auto maxIt = innerStops.upper_bound(zoom);
                 
                 // lower_bound yields first element >= zoom, but we want the *last*
                 // element <= zoom, so if we found a stop > zoom, back up by one.
-                if (minIt != s.stops.begin() && minIt != s.stops.end() && minIt->first > zoom) {
+                if (minIt != innerStops.begin() && minIt != innerStops.end() && minIt->first > zoom) {
                     minIt--;
                 }
                 
                 return CoveringRanges {
                     zoom,
                     Range<float> {
-                        minIt == s.stops.end() ? s.stops.rbegin()->first : minIt->first,
-                        maxIt == s.stops.end() ? s.stops.rbegin()->first : maxIt->first
+                        minIt == innerStops.end() ? innerStops.rbegin()->first : minIt->first,
+                        maxIt == innerStops.end() ? innerStops.rbegin()->first : maxIt->first
                     },
                     Range<InnerStops> {
-                        s.innerStops(minIt == s.stops.end() ? s.stops.rbegin()->second : minIt->second),
-                        s.innerStops(maxIt == s.stops.end() ? s.stops.rbegin()->second : maxIt->second)
+                        &(minIt == innerStops.end() ? innerStops.rbegin()->second : minIt->second),
+                        &(maxIt == innerStops.end() ? innerStops.rbegin()->second : maxIt->second)
                     }
                 };
             }
@@ -139,8 +142,8 @@ public:
 
 private:
     T evaluateFinal(const CoveringRanges& ranges, const Value& value, T finalDefaultValue) const {
-        auto eval = [&] (const auto& s) {
-            return s.evaluate(value).value_or(defaultValue.value_or(finalDefaultValue));
+        auto eval = [&] (const auto* s) {
+            return s->evaluate(value).value_or(defaultValue.value_or(finalDefaultValue));
         };
         return util::interpolate(
             ranges.coveringStopsRange.min.match(eval),
@@ -11,21 +11,33 @@ template <class T>
 class CompositeIntervalStops {
 public:
     using Stops = std::map<float, std::map<float, T>>;
-    Stops stops;
+    using InnerStops = IntervalStops<T>;
 
     CompositeIntervalStops() = default;
     CompositeIntervalStops(Stops stops_)
         : stops(std::move(stops_)) {
+        for (const auto& stop : stops) {
+            innerStops.emplace_hint(innerStops.end(), stop.first, InnerStops(stop.second));
+        }
+    }
+
+    const Stops& getStops() const {
+        return stops;
     }
 
-    IntervalStops<T> innerStops(const std::map<float, T>& stops_) const {
-        return IntervalStops<T>(stops_);
+    // The inner stops of each zoom stop, lowered once when the stops are constructed.
+    const std::map<float, InnerStops>& getInnerStops() const {
+        return innerStops;
     }
 
     friend bool operator==(const CompositeIntervalStops& lhs,
                            const CompositeIntervalStops& rhs) {
         return lhs.stops == rhs.stops;
     }
+
+private:
+    Stops stops;
+    std::map<float, InnerStops> innerStops;
 };
 
 } // namespace style
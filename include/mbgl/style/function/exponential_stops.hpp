@@ -3,7 +3,11 @@
 #include <mbgl/util/feature.hpp>
 #include <mbgl/util/interpolate.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <map>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -13,28 +17,34 @@ class ExponentialStops {
 public:
     using Stops = std::map<float, T>;
 
-    Stops stops;
-    float base = 1.0f;
-
     ExponentialStops() = default;
     ExponentialStops(Stops stops_, float base_ = 1.0f)
         : stops(std::move(stops_)),
           base(base_) {
+        compile();
+    }
+
+    const Stops& getStops() const {
+        return stops;
+    }
+
+    float getBase() const {
+        return base;
     }
 
     optional<T> evaluate(float z) const {
-        if (stops.empty()) {
+        if (inputs.empty()) {
             return {};
         }
 
-        auto it = stops.upper_bound(z);
-        if (it == stops.end()) {
-            return stops.rbegin()->second;
-        } else if (it == stops.begin()) {
-            return stops.begin()->second;
+        auto it = std::upper_bound(inputs.begin(), inputs.end(), z);
+        if (it == inputs.end()) {
+            return outputs.back();
+        } else if (it == inputs.begin()) {
+            return outputs.front();
         } else {
-            return util::interpolate(std::prev(it)->second, it->second,
-                util::interpolationFactor(base, { std::prev(it)->first, it->first }, z));
+            const std::size_t i = std::distance(inputs.begin(), it) - 1;
+            return util::interpolate(outputs[i], outputs[i + 1], interpolationFactor(i, z));
         }
     }
 
@@ -50,6 +60,40 @@ public:
                            const ExponentialStops& rhs) {
         return lhs.stops == rhs.stops && lhs.base == rhs.base;
     }
+
+private:
+    // Lowers the stops into flat arrays, with the parts of the interpolation factor that only
+    // depend on the stops computed up front. The results match util::interpolationFactor exactly.
+    void compile() {
+        inputs.reserve(stops.size());
+        outputs.reserve(stops.size());
+        for (const auto& stop : stops) {
+            if (!inputs.empty()) {
+                const float zoomDiff = stop.first - inputs.back();
+                zoomDiffs.push_back(zoomDiff);
+                denominators.push_back(std::pow(base, zoomDiff) - 1);
+            }
+            inputs.push_back(stop.first);
+            outputs.push_back(stop.second);
+        }
+    }
+
+    float interpolationFactor(std::size_t i, float z) const {
+        const float zoomProgress = z - inputs[i];
+        if (base == 1.0f) {
+            return zoomProgress / zoomDiffs[i];
+        } else {
+            return (std::pow(base, zoomProgress) - 1) / denominators[i];
+        }
+    }
+
+    Stops stops;
+    float base = 1.0f;
+
+    std::vector<float> inputs;
+    std::vector<T> outputs;
+    std::vector<float> zoomDiffs;
+    std::vector<float> denominators;
 };
 
 } // namespace style
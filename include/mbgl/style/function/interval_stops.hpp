@@ -2,7 +2,10 @@
 
 #include <mbgl/util/feature.hpp>
 
+#include <algorithm>
+#include <iterator>
 #include <map>
+#include <vector>
 
 namespace mbgl {
 namespace style {
@@ -11,25 +14,29 @@ template <class T>
 class IntervalStops {
 public:
     using Stops = std::map<float, T>;
-    Stops stops;
 
     IntervalStops() = default;
     IntervalStops(Stops stops_)
         : stops(std::move(stops_)) {
+        compile();
+    }
+
+    const Stops& getStops() const {
+        return stops;
     }
 
     optional<T> evaluate(float z) const {
-        if (stops.empty()) {
+        if (inputs.empty()) {
             return {};
         }
 
-        auto it = stops.upper_bound(z);
-        if (it == stops.end()) {
-            return stops.rbegin()->second;
-        } else if (it == stops.begin()) {
-            return stops.begin()->second;
+        auto it = std::upper_bound(inputs.begin(), inputs.end(), z);
+        if (it == inputs.end()) {
+            return outputs.back();
+        } else if (it == inputs.begin()) {
+            return outputs.front();
         } else {
-            return std::prev(it)->second;
+            return outputs[std::distance(inputs.begin(), it) - 1];
         }
     }
 
@@ -45,6 +52,22 @@ public:
                            const IntervalStops& rhs) {
         return lhs.stops == rhs.stops;
     }
+
+private:
+    // Lowers the stops into flat arrays, which are cheaper to search than the map.
+    void compile() {
+        inputs.reserve(stops.size());
+        outputs.reserve(stops.size());
+        for (const auto& stop : stops) {
+            inputs.push_back(stop.first);
+            outputs.push_back(stop.second);
+        }
+    }
+
+    Stops stops;
+
+    std::vector<float> inputs;
+    std::vector<T> outputs;
 };
 
 } // namespace style
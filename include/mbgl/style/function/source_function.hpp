@@ -29,8 +29,12 @@ public:
 
     SourceFunction(std::string property_, Stops stops_, optional<T> defaultValue_ = {})
         : property(std::move(property_)),
-          stops(std::move(stops_)),
-          defaultValue(std::move(defaultValue_)) {
+          defaultValue(std::move(defaultValue_)),
+          stops(std::move(stops_)) {
+    }
+
+    const Stops& getStops() const {
+        return stops;
     }
 
     template <class Feature>
@@ -51,9 +55,11 @@ public:
     }
 
     std::string property;
-    Stops stops;
     optional<T> defaultValue;
     bool useIntegerZoom = false;
+
+private:
+    Stops stops;
 };
 
 } // namespace style
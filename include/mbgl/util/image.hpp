@@ -146,6 +146,9 @@ using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
 // TODO: don't use std::string for binary data.
 PremultipliedImage decodeImage(const std::string&);
+// Decodes without premultiplying, for consumers that need unassociated colors, such as raster
+// tiles. Where the decoder produces unassociated colors, this avoids converting them twice.
+UnassociatedImage decodeUnassociatedImage(const std::string&);
 std::string encodePNG(const PremultipliedImage&);
 
 } // namespace mbgl
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// A read-only memory mapping of a whole file. The pages are loaded on demand and shared with the
+// operating system's file cache, so reading from the mapping doesn't copy the file into the heap.
+class MappedFile : private util::noncopyable {
+public:
+    // Throws std::runtime_error if the file can't be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    const char* data() const {
+        return address;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+private:
+    const char* address = nullptr;
+    std::size_t length = 0;
+};
+
+// A range of a memory-mapped file, e.g. a single tile of a tile archive, that keeps the mapping
+// alive for as long as it's held.
+class MappedData {
+public:
+    MappedData(std::shared_ptr<const MappedFile> file_, std::size_t offset_, std::size_t size_)
+        : file(std::move(file_)), offset(offset_), length(size_) {
+    }
+
+    // The whole file.
+    explicit MappedData(std::shared_ptr<const MappedFile> file_)
+        : MappedData(file_, 0, file_->size()) {
+    }
+
+    const char* data() const {
+        return file->data() + offset;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+    const std::shared_ptr<const MappedFile>& getFile() const {
+        return file;
+    }
+
+    // Copies the data, for consumers that can't read it in place.
+    std::string toString() const {
+        return { data(), length };
+    }
+
+private:
+    std::shared_ptr<const MappedFile> file;
+    std::size_t offset;
+    std::size_t length;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -8,5 +8,15 @@ namespace util {
 PremultipliedImage premultiply(UnassociatedImage&&);
 UnassociatedImage unpremultiply(PremultipliedImage&&);
 
+// Returns unassociated image data, such as decoder output, in the requested alpha mode. Decoders
+// use this to emit either mode without converting the data back and forth.
+template <ImageAlphaMode Mode>
+Image<Mode> convertImage(UnassociatedImage&&);
+
+template <>
+UnassociatedImage convertImage<ImageAlphaMode::Unassociated>(UnassociatedImage&&);
+template <>
+PremultipliedImage convertImage<ImageAlphaMode::Premultiplied>(UnassociatedImage&&);
+
 } // namespace util
 } // namespace mbgl
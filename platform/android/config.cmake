@@ -39,6 +39,8 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/asset_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mapped_file.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
         # Offline
@@ -60,6 +62,8 @@ macro(mbgl_platform_core)
 
         # Image handling
         PRIVATE platform/default/png_writer.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.hpp
         PRIVATE platform/android/src/bitmap.cpp
         PRIVATE platform/android/src/bitmap.hpp
         PRIVATE platform/android/src/bitmap_factory.cpp
@@ -308,6 +312,10 @@ macro(mbgl_platform_test)
         platform/default/mbgl/gl/headless_backend.hpp
         platform/default/mbgl/gl/offscreen_view.cpp
         platform/default/mbgl/gl/offscreen_view.hpp
+        platform/default/mbgl/util/metatile_renderer.cpp
+        platform/default/mbgl/util/metatile_renderer.hpp
+        platform/default/mbgl/util/render_pool.cpp
+        platform/default/mbgl/util/render_pool.hpp
 
         platform/linux/src/headless_backend_egl.cpp
         platform/linux/src/headless_display_egl.cpp
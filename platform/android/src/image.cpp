@@ -1,4 +1,5 @@
 #include <mbgl/util/image.hpp>
+#include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/string.hpp>
 
 #include <string>
@@ -19,4 +20,9 @@ PremultipliedImage decodeImage(const std::string& string) {
     return android::Bitmap::GetImage(*env, bitmap);
 }
 
+// Bitmaps are decoded premultiplied.
+UnassociatedImage decodeUnassociatedImage(const std::string& string) {
+    return util::unpremultiply(decodeImage(string));
+}
+
 } // namespace mbgl
@@ -135,15 +135,15 @@ public:
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeCategoricalStops<T> &value) const {
-        return CategoricalStops::New(env, toFunctionStopJavaArray(env, value.stops)).Get();
+        return CategoricalStops::New(env, toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::ExponentialStops<T> &value) const {
-        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.base)), toFunctionStopJavaArray(env, value.stops)).Get();
+        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.getBase())), toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeExponentialStops<T> &value) const {
-        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.base)), toFunctionStopJavaArray(env, value.stops)).Get();
+        return ExponentialStops::New(env, jni::Object<java::lang::Float>(*convert<jni::jobject*>(env, value.getBase())), toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::IdentityStops<T> &) const {
@@ -151,11 +151,11 @@ public:
     }
 
     jni::jobject* operator()(const mbgl::style::IntervalStops<T> &value) const {
-        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.stops)).Get();
+        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
     jni::jobject* operator()(const mbgl::style::CompositeIntervalStops<T> &value) const {
-        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.stops)).Get();
+        return IntervalStops::New(env, toFunctionStopJavaArray(env, value.getStops())).Get();
     }
 
 private:
@@ -187,7 +187,7 @@ struct Converter<jni::jobject*, mbgl::style::SourceFunction<T>> {
 
         // Convert stops
         StopsEvaluator<T> evaluator(env);
-        jni::jobject* stops = apply_visitor(evaluator, value.stops);
+        jni::jobject* stops = apply_visitor(evaluator, value.getStops());
 
         // Convert default value
         jni::jobject* defaultValue = nullptr;
@@ -547,13 +547,13 @@ private: // Private utilities for converting from mbgl to mgl values
     public:
         id operator()(const mbgl::style::ExponentialStops<MBGLType> &mbglStops) {
             return [MGLCameraStyleFunction functionWithInterpolationMode:MGLInterpolationModeExponential
-                                                          stops:toConvertedStops(mbglStops.stops)
-                                                        options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.base)}];
+                                                          stops:toConvertedStops(mbglStops.getStops())
+                                                        options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.getBase())}];
         }
 
         id operator()(const mbgl::style::IntervalStops<MBGLType> &mbglStops) {
             return [MGLCameraStyleFunction functionWithInterpolationMode:MGLInterpolationModeInterval
-                                                          stops:toConvertedStops(mbglStops.stops)
+                                                          stops:toConvertedStops(mbglStops.getStops())
                                                         options:nil];
         }
     };
@@ -563,9 +563,9 @@ private: // Private utilities for converting from mbgl to mgl values
     public:
         id operator()(const mbgl::style::ExponentialStops<MBGLType> &mbglStops) {
             MGLSourceStyleFunction *sourceFunction = [MGLSourceStyleFunction functionWithInterpolationMode:MGLInterpolationModeExponential
-                                                                                            stops:toConvertedStops(mbglStops.stops)
+                                                                                            stops:toConvertedStops(mbglStops.getStops())
                                                                                     attributeName:@(mbglFunction.property.c_str())
-                                                                                          options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.base)}];
+                                                                                          options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.getBase())}];
             if (mbglFunction.defaultValue) {
                 sourceFunction.defaultValue = [MGLStyleValue valueWithRawValue:toMGLRawStyleValue(*mbglFunction.defaultValue)];
             }
@@ -574,7 +574,7 @@ private: // Private utilities for converting from mbgl to mgl values
 
         id operator()(const mbgl::style::IntervalStops<MBGLType> &mbglStops) {
             MGLSourceStyleFunction *sourceFunction = [MGLSourceStyleFunction functionWithInterpolationMode:MGLInterpolationModeInterval
-                                                                                            stops:toConvertedStops(mbglStops.stops)
+                                                                                            stops:toConvertedStops(mbglStops.getStops())
                                                                                     attributeName:@(mbglFunction.property.c_str())
                                                                                           options:nil];
             if (mbglFunction.defaultValue) {
@@ -621,14 +621,14 @@ private: // Private utilities for converting from mbgl to mgl values
     class CompositeFunctionStopsVisitor {
     public:
         id operator()(const mbgl::style::CompositeExponentialStops<MBGLType> &mbglStops) {
-            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.stops.size()];
-            for (auto const& outerStop: mbglStops.stops) {
+            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.getStops().size()];
+            for (auto const& outerStop: mbglStops.getStops()) {
                 stops[@(outerStop.first)] = toConvertedStops(outerStop.second);
             }
             MGLCompositeStyleFunction *compositeFunction = [MGLCompositeStyleFunction functionWithInterpolationMode:MGLInterpolationModeExponential
                                                                                                      stops:stops
                                                                                              attributeName:@(mbglFunction.property.c_str())
-                                                                                                   options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.base)}];
+                                                                                                   options:@{MGLStyleFunctionOptionInterpolationBase: @(mbglStops.getBase())}];
             if (mbglFunction.defaultValue) {
                 compositeFunction.defaultValue = [MGLStyleValue valueWithRawValue:toMGLRawStyleValue(*mbglFunction.defaultValue)];
             }
@@ -636,8 +636,8 @@ private: // Private utilities for converting from mbgl to mgl values
         }
 
         id operator()(const mbgl::style::CompositeIntervalStops<MBGLType> &mbglStops) {
-            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.stops.size()];
-            for (auto const& outerStop: mbglStops.stops) {
+            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.getStops().size()];
+            for (auto const& outerStop: mbglStops.getStops()) {
                 stops[@(outerStop.first)] = toConvertedStops(outerStop.second);
             }
             MGLCompositeStyleFunction *compositeFunction = [MGLCompositeStyleFunction functionWithInterpolationMode:MGLInterpolationModeInterval
@@ -651,8 +651,8 @@ private: // Private utilities for converting from mbgl to mgl values
         }
 
         id operator()(const mbgl::style::CompositeCategoricalStops<MBGLType> &mbglStops) {
-            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.stops.size()];
-            for (auto const& outerStop: mbglStops.stops) {
+            NSMutableDictionary *stops = [NSMutableDictionary dictionaryWithCapacity:mbglStops.getStops().size()];
+            for (auto const& outerStop: mbglStops.getStops()) {
                     NSMutableDictionary *innerStops = [NSMutableDictionary dictionaryWithCapacity:outerStop.second.size()];
                 for (const auto &mbglStop : outerStop.second) {
                     auto categoricalValue = mbglStop.first;
@@ -696,7 +696,7 @@ private: // Private utilities for converting from mbgl to mgl values
 
         id operator()(const mbgl::style::SourceFunction<MBGLType> &mbglValue) const {
             SourceFunctionStopsVisitor visitor { mbglValue };
-            return apply_visitor(visitor, mbglValue.stops);
+            return apply_visitor(visitor, mbglValue.getStops());
         }
 
         MGLCompositeStyleFunction<ObjCType> * operator()(const mbgl::style::CompositeFunction<MBGLType> &mbglValue) const {
@@ -1,4 +1,5 @@
 #include <mbgl/util/image+MGLAdditions.hpp>
+#include <mbgl/util/premultiply.hpp>
 
 #import <ImageIO/ImageIO.h>
 
@@ -104,4 +105,9 @@ PremultipliedImage decodeImage(const std::string& source) {
     return MGLPremultipliedImageFromCGImage(*image);
 }
 
+// CoreGraphics draws into premultiplied bitmaps only.
+UnassociatedImage decodeUnassociatedImage(const std::string& source) {
+    return util::unpremultiply(decodeImage(source));
+}
+
 } // namespace mbgl
@@ -2,22 +2,32 @@
 #include <mbgl/storage/asset_file_source.hpp>
 #include <mbgl/storage/file_source_request.hpp>
 #include <mbgl/storage/local_file_source.hpp>
+#include <mbgl/storage/mbtiles_file_source.hpp>
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
 #include <mbgl/storage/resource_transform.hpp>
 
+#include <mbgl/util/logging.hpp>
 #include <mbgl/util/platform.hpp>
+#include <mbgl/util/string.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
+#include <mbgl/util/timer.hpp>
 #include <mbgl/util/work_request.hpp>
 
 #include <cassert>
+#include <unordered_set>
 
 namespace {
 
 const std::string assetProtocol = "asset://";
 
+// Limits on how many ambient cache writes may be batched, and for how long, before the batch is
+// committed. Buffered access times from cache hits are written on the same schedule.
+const std::size_t cacheWriteBatchSize = 128;
+const mbgl::Duration cacheWriteBatchInterval = mbgl::Seconds(1);
+
 bool isAssetURL(const std::string& url) {
     return std::equal(assetProtocol.begin(), assetProtocol.end(), url.begin());
 }
@@ -119,6 +129,12 @@ public:
         } else if (LocalFileSource::acceptsURL(resource.url)) {
             //Local file request
             tasks[req] = localFileSource->request(resource, callback);
+        } else if (MBTilesFileSource::acceptsURL(resource.url)) {
+            // MBTiles archive request. The connection pool is only started once it's needed.
+            if (!mbtilesFileSource) {
+                mbtilesFileSource = std::make_unique<MBTilesFileSource>();
+            }
+            tasks[req] = mbtilesFileSource->request(resource, callback);
         } else {
             // Try the offline database
             Resource revalidation = resource;
@@ -126,6 +142,7 @@ public:
             const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
             if (!hasPrior || resource.necessity == Resource::Optional) {
                 auto offlineResponse = offlineDatabase.get(resource);
+                scheduleFlush();
 
                 if (resource.necessity == Resource::Optional && !offlineResponse) {
                     // Ensure there's always a response that we can send, so the caller knows that
@@ -147,26 +164,65 @@ public:
             // Get from the online file source
             if (resource.necessity == Resource::Required) {
                 tasks[req] = onlineFileSource.request(revalidation, [=] (Response onlineResponse) mutable {
-                    this->offlineDatabase.put(revalidation, onlineResponse);
+                    this->putCache(revalidation, onlineResponse);
                     callback(onlineResponse);
                 });
+                onlineTasks.insert(req);
             }
         }
     }
 
     void cancel(AsyncRequest* req) {
         tasks.erase(req);
+        onlineTasks.erase(req);
+    }
+
+    void setPriority(AsyncRequest* req, Resource::Priority priority) {
+        // Only network requests wait in a queue.
+        if (onlineTasks.count(req)) {
+            onlineFileSource.setPriority(*tasks.at(req), priority);
+        }
     }
 
     void setOfflineMapboxTileCountLimit(uint64_t limit) {
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
+    void setCacheWriteAheadLog(bool enabled) {
+        offlineDatabase.setWriteAheadLog(enabled);
+        offlineDatabase.setMaximumBatchSize(enabled ? cacheWriteBatchSize : 1);
+    }
+
     void put(const Resource& resource, const Response& response) {
-        offlineDatabase.put(resource, response);
+        putCache(resource, response);
     }
 
 private:
+    void putCache(const Resource& resource, const Response& response) {
+        offlineDatabase.put(resource, response);
+        scheduleFlush();
+    }
+
+    // Starts the timer with the first pending write, so that no write waits longer than the
+    // interval to be committed.
+    void scheduleFlush() {
+        if (!flushScheduled && offlineDatabase.hasPendingWrites()) {
+            flushScheduled = true;
+            flushTimer.start(cacheWriteBatchInterval, Duration::zero(), [this] {
+                flush();
+            });
+        }
+    }
+
+    void flush() {
+        flushScheduled = false;
+        try {
+            offlineDatabase.flush();
+        } catch (...) {
+            Log::Error(Event::Database, "Unable to commit cache writes: %s", util::toString(std::current_exception()).c_str());
+        }
+    }
+
     OfflineDownload& getDownload(int64_t regionID) {
         auto it = downloads.find(regionID);
         if (it != downloads.end()) {
@@ -179,10 +235,14 @@ private:
     // shared so that destruction is done on the creating thread
     const std::shared_ptr<FileSource> assetFileSource;
     const std::unique_ptr<FileSource> localFileSource;
+    std::unique_ptr<FileSource> mbtilesFileSource;
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
+    std::unordered_set<AsyncRequest*> onlineTasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+    util::Timer flushTimer;
+    bool flushScheduled = false;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -242,6 +302,10 @@ std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resourc
     return std::move(req);
 }
 
+void DefaultFileSource::setPriority(AsyncRequest& req, Resource::Priority priority) {
+    impl->actor().invoke(&Impl::setPriority, &req, priority);
+}
+
 void DefaultFileSource::listOfflineRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
     impl->actor().invoke(&Impl::listRegions, callback);
 }
@@ -278,6 +342,10 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     impl->actor().invoke(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::setCacheWriteAheadLog(bool enabled) {
+    impl->actor().invoke(&Impl::setCacheWriteAheadLog, enabled);
+}
+
 void DefaultFileSource::pause() {
     impl->pause();
 }
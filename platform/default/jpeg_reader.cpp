@@ -89,7 +89,9 @@ struct jpeg_info_guard {
     jpeg_decompress_struct* i_;
 };
 
-PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
+// JPEG images are opaque, so they're the same in either alpha mode.
+template <ImageAlphaMode Mode>
+Image<Mode> decodeJPEG(const uint8_t* data, size_t size) {
     util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
     std::istream stream(&dataBuffer);
 
@@ -119,7 +121,7 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     size_t components = cinfo.output_components;
     size_t rowStride = components * width;
 
-    PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
+    Image<Mode> image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
     uint8_t* dst = image.data.get();
 
     JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
@@ -148,4 +150,7 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     return image;
 }
 
+template UnassociatedImage decodeJPEG(const uint8_t*, size_t);
+template PremultipliedImage decodeJPEG(const uint8_t*, size_t);
+
 } // namespace mbgl
@@ -6,6 +6,7 @@
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/util.hpp>
 #include <mbgl/util/io.hpp>
+#include <mbgl/util/mapped_file.hpp>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -24,7 +25,7 @@ class LocalFileSource::Impl {
 public:
     Impl(ActorRef<Impl>) {}
 
-    void request(const std::string& url, ActorRef<FileSourceRequest> req) {
+    void request(const std::string& url, Resource::Kind kind, ActorRef<FileSourceRequest> req) {
         // Cut off the protocol
         std::string path = mbgl::util::percentDecode(url.substr(protocolLength));
 
@@ -39,7 +40,13 @@ public:
             response.error = std::make_unique<Response::Error>(Response::Error::Reason::NotFound);
         } else {
             try {
-                response.data = std::make_shared<std::string>(util::read_file(path));
+                if (kind == Resource::Kind::Tile) {
+                    // Tiles are mapped rather than read, so that vector tiles can be parsed in
+                    // place. This avoids copying them when serving from large local tile sets.
+                    response.mappedData.emplace(std::make_shared<const util::MappedFile>(path));
+                } else {
+                    response.data = std::make_shared<std::string>(util::read_file(path));
+                }
             } catch (...) {
                 response.error = std::make_unique<Response::Error>(
                     Response::Error::Reason::Other,
@@ -61,7 +68,7 @@ LocalFileSource::~LocalFileSource() = default;
 std::unique_ptr<AsyncRequest> LocalFileSource::request(const Resource& resource, Callback callback) {
     auto req = std::make_unique<FileSourceRequest>(std::move(callback));
 
-    impl->actor().invoke(&Impl::request, resource.url, req->actor());
+    impl->actor().invoke(&Impl::request, resource.url, resource.kind, req->actor());
 
     return std::move(req);
 }
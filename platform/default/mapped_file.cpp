@@ -0,0 +1,52 @@
+#include <mbgl/util/mapped_file.hpp>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace mbgl {
+namespace util {
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error(std::string("Cannot open file ") + path + ": " + std::strerror(errno));
+    }
+
+    struct stat buf;
+    if (::fstat(fd, &buf) == -1) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error(std::string("Cannot stat file ") + path + ": " + std::strerror(error));
+    }
+
+    length = static_cast<std::size_t>(buf.st_size);
+
+    // Empty files can't be mapped.
+    if (length > 0) {
+        void* result = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+        if (result == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            throw std::runtime_error(std::string("Cannot map file ") + path + ": " + std::strerror(error));
+        }
+        address = static_cast<const char*>(result);
+    }
+
+    // The mapping stays valid after the file is closed.
+    ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+    if (address) {
+        ::munmap(const_cast<char*>(address), length);
+    }
+}
+
+} // namespace util
+} // namespace mbgl
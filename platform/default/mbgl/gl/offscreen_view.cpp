@@ -4,8 +4,11 @@
 #include <mbgl/gl/renderbuffer.hpp>
 #include <mbgl/util/optional.hpp>
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <cassert>
+#include <deque>
 
 namespace mbgl {
 
@@ -28,8 +31,50 @@ public:
         context.viewport = { 0, 0, size };
     }
 
-    PremultipliedImage readStillImage() {
-        return context.readFramebuffer<PremultipliedImage>(size);
+    void startStillImageRead() {
+        if (!context.supportsPixelBuffers()) {
+            // Without pixel buffer objects, reading has to wait for rendering to finish anyway.
+            assert(images.size() < pixelBuffers.size());
+            images.push_back(context.readFramebuffer<PremultipliedImage>(size, false));
+            return;
+        }
+
+        if (!pixelBuffers.front()) {
+            for (auto& pixelBuffer : pixelBuffers) {
+                pixelBuffer = context.createPixelBuffer(size.area() * PremultipliedImage::channels);
+            }
+        }
+
+        assert(pendingReads < pixelBuffers.size());
+        const auto& pixelBuffer = pixelBuffers[(firstRead + pendingReads) % pixelBuffers.size()];
+        context.readFramebuffer(size, gl::TextureFormat::RGBA, *pixelBuffer);
+        pendingReads++;
+    }
+
+    PremultipliedImage readStillImage(const bool flip) {
+        if (!images.empty()) {
+            PremultipliedImage image = std::move(images.front());
+            images.pop_front();
+            if (flip) {
+                const size_t stride = image.stride();
+                uint8_t* rgba = image.data.get();
+                for (int i = 0, j = size.height - 1; i < j; i++, j--) {
+                    std::swap_ranges(rgba + i * stride, rgba + (i + 1) * stride, rgba + j * stride);
+                }
+            }
+            return image;
+        }
+
+        if (!pendingReads) {
+            return context.readFramebuffer<PremultipliedImage>(size, flip);
+        }
+
+        PremultipliedImage image(size);
+        context.readPixelBuffer(*pixelBuffers[firstRead], size, gl::TextureFormat::RGBA,
+                                image.data.get(), flip);
+        firstRead = (firstRead + 1) % pixelBuffers.size();
+        pendingReads--;
+        return image;
     }
 
     const Size& getSize() const {
@@ -42,6 +87,15 @@ private:
     optional<gl::Framebuffer> framebuffer;
     optional<gl::Renderbuffer<gl::RenderbufferType::RGBA>> color;
     optional<gl::Renderbuffer<gl::RenderbufferType::DepthStencil>> depthStencil;
+
+    // Ring of pixel buffers for asynchronous reads: `pendingReads` reads are in flight, starting
+    // with the one in `pixelBuffers[firstRead]`.
+    std::array<optional<gl::UniqueBuffer>, 2> pixelBuffers;
+    std::size_t firstRead = 0;
+    std::size_t pendingReads = 0;
+
+    // Images read synchronously by startStillImageRead() when pixel buffers aren't supported.
+    std::deque<PremultipliedImage> images;
 };
 
 OffscreenView::OffscreenView(gl::Context& context, const Size size)
@@ -54,8 +108,12 @@ void OffscreenView::bind() {
     impl->bind();
 }
 
-PremultipliedImage OffscreenView::readStillImage() {
-    return impl->readStillImage();
+void OffscreenView::startStillImageRead() {
+    impl->startStillImageRead();
+}
+
+PremultipliedImage OffscreenView::readStillImage(const bool flip) {
+    return impl->readStillImage(flip);
 }
 
 const Size& OffscreenView::getSize() const {
@@ -16,7 +16,16 @@ public:
 
     void bind() override;
 
-    PremultipliedImage readStillImage();
+    // Starts reading the current contents of the view without waiting for rendering to finish.
+    // The image is returned by a later call to readStillImage(), so that more drawing can happen
+    // in the meantime. At most two reads may be pending at a time.
+    void startStillImageRead();
+
+    // Returns the image of the oldest read started with startStillImageRead(), or reads the
+    // current contents of the view if no read is pending. Rows are stored top-down, unless `flip`
+    // is false, in which case they're left in the bottom-up order of OpenGL. Throws if a pending
+    // read can't be collected.
+    PremultipliedImage readStillImage(bool flip = true);
 
     const Size& getSize() const;
 
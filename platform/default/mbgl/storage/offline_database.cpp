@@ -10,6 +10,13 @@
 
 namespace mbgl {
 
+namespace {
+
+// Buffered access times are written once there are this many.
+const std::size_t maximumBufferedAccessTimes = 1024;
+
+} // namespace
+
 OfflineDatabase::Statement::~Statement() {
     stmt.reset();
     stmt.clearBindings();
@@ -25,6 +32,7 @@ OfflineDatabase::~OfflineDatabase() {
     // Deleting these SQLite objects may result in exceptions, but we're in a destructor, so we
     // can't throw anything.
     try {
+        flush();
         statements.clear();
         db.reset();
     } catch (mapbox::sqlite::Exception& ex) {
@@ -119,6 +127,9 @@ void OfflineDatabase::migrateToVersion3() {
 // conflicts from quickly (and needlessly) switching journal and sync modes.
 //
 // See: https://github.com/mapbox/mapbox-gl-native/pull/6320
+//
+// WAL is now available as an opt-in through setWriteAheadLog(), which leaves the schema
+// version unchanged.
 
 void OfflineDatabase::migrateToVersion5() {
     db->exec("PRAGMA journal_mode = DELETE");
@@ -142,11 +153,70 @@ optional<Response> OfflineDatabase::get(const Resource& resource) {
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
+    optional<std::pair<Response, uint64_t>> result;
+
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
-        return getTile(*resource.tileData);
+        result = getTile(*resource.tileData);
     } else {
-        return getResource(resource);
+        result = getResource(resource);
+    }
+
+    if (resourceAccessTimes.size() + tileAccessTimes.size() >= maximumBufferedAccessTimes) {
+        writeAccessTimes();
+    }
+
+    return result;
+}
+
+void OfflineDatabase::writeAccessTimes() {
+    if (resourceAccessTimes.empty() && tileAccessTimes.empty()) {
+        return;
+    }
+
+    std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+    if (!batch) {
+        transaction = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    }
+
+    // A put may have updated an access time since it was buffered.
+    for (const auto& access : resourceAccessTimes) {
+        // clang-format off
+        Statement stmt = getStatement(
+            "UPDATE resources SET accessed = max(accessed, ?1) WHERE url = ?2");
+        // clang-format on
+
+        stmt->bind(1, access.second);
+        stmt->bind(2, access.first);
+        stmt->run();
+    }
+
+    for (const auto& access : tileAccessTimes) {
+        // clang-format off
+        Statement stmt = getStatement(
+            "UPDATE tiles "
+            "SET accessed       = max(accessed, ?1) "
+            "WHERE url_template = ?2 "
+            "  AND pixel_ratio  = ?3 "
+            "  AND x            = ?4 "
+            "  AND y            = ?5 "
+            "  AND z            = ?6 ");
+        // clang-format on
+
+        stmt->bind(1, access.second);
+        stmt->bind(2, std::get<0>(access.first));
+        stmt->bind(3, std::get<1>(access.first));
+        stmt->bind(4, std::get<2>(access.first));
+        stmt->bind(5, std::get<3>(access.first));
+        stmt->bind(6, std::get<4>(access.first));
+        stmt->run();
+    }
+
+    resourceAccessTimes.clear();
+    tileAccessTimes.clear();
+
+    if (transaction) {
+        transaction->commit();
     }
 }
 
@@ -160,7 +230,30 @@ optional<int64_t> OfflineDatabase::hasInternal(const Resource& resource) {
 }
 
 std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const Response& response) {
-    return putInternal(resource, response, true);
+    if (maximumBatchSize <= 1) {
+        return putInternal(resource, response, true);
+    }
+
+    if (!batch) {
+        batch = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    }
+
+    std::pair<bool, uint64_t> result;
+    try {
+        result = putInternal(resource, response, true);
+    } catch (...) {
+        // SQLite may already have rolled back the transaction, in which case it can no longer be
+        // committed. Either way, the batched puts are lost; they're only ambient cache entries.
+        batch.reset();
+        batchSize = 0;
+        throw;
+    }
+
+    if (++batchSize >= maximumBatchSize) {
+        flush();
+    }
+
+    return result;
 }
 
 std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_) {
@@ -200,19 +293,10 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resource& resource) {
-    // clang-format off
-    Statement accessedStmt = getStatement(
-        "UPDATE resources SET accessed = ?1 WHERE url = ?2");
-    // clang-format on
-
-    accessedStmt->bind(1, util::now());
-    accessedStmt->bind(2, resource.url);
-    accessedStmt->run();
-
     // clang-format off
     Statement stmt = getStatement(
-        //        0      1        2       3        4
-        "SELECT etag, expires, modified, data, compressed "
+        //        0      1        2       3        4          5
+        "SELECT etag, expires, modified, data, compressed, accessed "
         "FROM resources "
         "WHERE url = ?");
     // clang-format on
@@ -241,6 +325,11 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
         size = data->length();
     }
 
+    const Timestamp now = util::now();
+    if (now - stmt->get<Timestamp>(5) >= accessTimeGranularity) {
+        resourceAccessTimes[resource.url] = now;
+    }
+
     return std::make_pair(response, size);
 }
 
@@ -280,8 +369,11 @@ bool OfflineDatabase::putResource(const Resource& resource,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. A batch already holds the write lock.
+    std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+    if (!batch) {
+        transaction = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -313,7 +405,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -339,35 +433,18 @@ bool OfflineDatabase::putResource(const Resource& resource,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
 
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource::TileData& tile) {
-    // clang-format off
-    Statement accessedStmt = getStatement(
-        "UPDATE tiles "
-        "SET accessed       = ?1 "
-        "WHERE url_template = ?2 "
-        "  AND pixel_ratio  = ?3 "
-        "  AND x            = ?4 "
-        "  AND y            = ?5 "
-        "  AND z            = ?6 ");
-    // clang-format on
-
-    accessedStmt->bind(1, util::now());
-    accessedStmt->bind(2, tile.urlTemplate);
-    accessedStmt->bind(3, tile.pixelRatio);
-    accessedStmt->bind(4, tile.x);
-    accessedStmt->bind(5, tile.y);
-    accessedStmt->bind(6, tile.z);
-    accessedStmt->run();
-
     // clang-format off
     Statement stmt = getStatement(
-        //        0      1        2       3        4
-        "SELECT etag, expires, modified, data, compressed "
+        //        0      1        2       3        4          5
+        "SELECT etag, expires, modified, data, compressed, accessed "
         "FROM tiles "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
@@ -404,6 +481,11 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
         size = data->length();
     }
 
+    const Timestamp now = util::now();
+    if (now - stmt->get<Timestamp>(5) >= accessTimeGranularity) {
+        tileAccessTimes[std::make_tuple(tile.urlTemplate, tile.pixelRatio, tile.x, tile.y, tile.z)] = now;
+    }
+
     return std::make_pair(response, size);
 }
 
@@ -463,8 +545,11 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment. A batch already holds the write lock.
+    std::unique_ptr<mapbox::sqlite::Transaction> transaction;
+    if (!batch) {
+        transaction = std::make_unique<mapbox::sqlite::Transaction>(*db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -502,7 +587,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -531,7 +618,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -556,6 +645,9 @@ std::vector<OfflineRegion> OfflineDatabase::listRegions() {
 
 OfflineRegion OfflineDatabase::createRegion(const OfflineRegionDefinition& definition,
                                             const OfflineRegionMetadata& metadata) {
+    // Region changes are committed immediately, so commit batched ambient puts first.
+    flush();
+
     // clang-format off
     Statement stmt = getStatement(
         "INSERT INTO regions (definition, description) "
@@ -570,6 +662,8 @@ OfflineRegion OfflineDatabase::createRegion(const OfflineRegionDefinition& defin
 }
 
 OfflineRegionMetadata OfflineDatabase::updateMetadata(const int64_t regionID, const OfflineRegionMetadata& metadata) {
+    flush();
+
     // clang-format off
     Statement stmt = getStatement(
                                   "UPDATE regions SET description = ?1"
@@ -583,6 +677,8 @@ OfflineRegionMetadata OfflineDatabase::updateMetadata(const int64_t regionID, co
 }
 
 void OfflineDatabase::deleteRegion(OfflineRegion&& region) {
+    flush();
+
     // clang-format off
     Statement stmt = getStatement(
         "DELETE FROM regions WHERE id = ?");
@@ -602,6 +698,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getRegionResource(int64
     auto response = getInternal(resource);
 
     if (response) {
+        // Region changes are committed immediately, so commit batched ambient puts first.
+        flush();
         markUsed(regionID, resource);
     }
 
@@ -612,6 +710,8 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
     auto response = hasInternal(resource);
 
     if (response) {
+        // Region changes are committed immediately, so commit batched ambient puts first.
+        flush();
         markUsed(regionID, resource);
     }
 
@@ -619,6 +719,8 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
 }
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
+    flush();
+
     uint64_t size = putInternal(resource, response, false).second;
     bool previouslyUnused = markUsed(regionID, resource);
 
@@ -781,16 +883,22 @@ T OfflineDatabase::getPragma(const char * sql) {
 // delete an arbitrary number of old cache entries. The free pages approach saves
 // us from calling VACCUM or keeping a running total, which can be costly.
 bool OfflineDatabase::evict(uint64_t neededFreeSize) {
-    uint64_t pageSize = getPragma<int64_t>("PRAGMA page_size");
+    // Eviction is based on access times, so they need to be up to date.
+    writeAccessTimes();
+
+    // The page size can't change once the database has been created.
+    if (!pageSize) {
+        pageSize = getPragma<int64_t>("PRAGMA page_size");
+    }
     uint64_t pageCount = getPragma<int64_t>("PRAGMA page_count");
 
     auto usedSize = [&] {
-        return pageSize * (pageCount - getPragma<int64_t>("PRAGMA freelist_count"));
+        return *pageSize * (pageCount - getPragma<int64_t>("PRAGMA freelist_count"));
     };
 
     // The addition of pageSize is a fudge factor to account for non `data` column
     // size, and because pages can get fragmented on the database.
-    while (usedSize() + neededFreeSize + pageSize > maximumCacheSize) {
+    while (usedSize() + neededFreeSize + *pageSize > maximumCacheSize) {
         // clang-format off
         Statement accessedStmt = getStatement(
             "SELECT max(accessed) "
@@ -893,4 +1001,44 @@ uint64_t OfflineDatabase::getOfflineMapboxTileCount() {
     return *offlineMapboxTileCount;
 }
 
+void OfflineDatabase::setWriteAheadLog(bool enabled) {
+    // The journal mode can't be changed within a transaction.
+    flush();
+
+    if (enabled) {
+        db->exec("PRAGMA journal_mode = WAL");
+        db->exec("PRAGMA synchronous = NORMAL");
+    } else {
+        db->exec("PRAGMA journal_mode = DELETE");
+        db->exec("PRAGMA synchronous = FULL");
+    }
+}
+
+void OfflineDatabase::setMaximumBatchSize(std::size_t size) {
+    maximumBatchSize = size;
+    if (batchSize >= maximumBatchSize) {
+        flush();
+    }
+}
+
+void OfflineDatabase::setAccessTimeGranularity(Duration granularity) {
+    accessTimeGranularity = granularity;
+}
+
+void OfflineDatabase::flush() {
+    writeAccessTimes();
+
+    if (!batch) {
+        return;
+    }
+
+    auto transaction = std::move(batch);
+    batchSize = 0;
+    transaction->commit();
+}
+
+bool OfflineDatabase::hasPendingWrites() const {
+    return batch || !resourceAccessTimes.empty() || !tileAccessTimes.empty();
+}
+
 } // namespace mbgl
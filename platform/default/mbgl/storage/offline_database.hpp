@@ -5,16 +5,20 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/chrono.hpp>
 #include <mbgl/util/mapbox.hpp>
 
+#include <map>
 #include <unordered_map>
 #include <memory>
 #include <string>
+#include <tuple>
 
 namespace mapbox {
 namespace sqlite {
 class Database;
 class Statement;
+class Transaction;
 } // namespace sqlite
 } // namespace mapbox
 
@@ -57,6 +61,25 @@ public:
     bool offlineMapboxTileCountLimitExceeded();
     uint64_t getOfflineMapboxTileCount();
 
+    // Switches between a write-ahead log with NORMAL synchronization, and the default rollback
+    // journal with FULL synchronization. Either way, a crash never corrupts the database; in WAL
+    // mode, the most recent commits may be rolled back after a power loss.
+    void setWriteAheadLog(bool);
+
+    // Groups up to this many ambient cache puts into a single transaction, which is committed
+    // once it is full or when `flush()` is called. Puts in an uncommitted batch are lost if the
+    // process crashes. Region resources are never batched. The default of 1 commits every put.
+    void setMaximumBatchSize(std::size_t);
+
+    // Cache hits don't write to the database. The access times used for eviction are buffered in
+    // memory, and only updated if the stored time is older than this granularity. Buffered access
+    // times are written before eviction, by `flush()`, and once enough of them accumulate.
+    void setAccessTimeGranularity(Duration);
+
+    // Commits batched puts and buffered access times, if any.
+    void flush();
+    bool hasPendingWrites() const;
+
 private:
     void connect(int flags);
     int userVersion();
@@ -90,6 +113,8 @@ private:
     bool putResource(const Resource&, const Response&,
                      const std::string&, bool compressed);
 
+    void writeAccessTimes();
+
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
     std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
@@ -113,6 +138,15 @@ private:
     optional<uint64_t> offlineMapboxTileCount;
 
     bool evict(uint64_t neededFreeSize);
+    optional<uint64_t> pageSize;
+
+    Duration accessTimeGranularity = Seconds(60);
+    std::unordered_map<std::string, Timestamp> resourceAccessTimes;
+    std::map<std::tuple<std::string, uint8_t, int32_t, int32_t, int8_t>, Timestamp> tileAccessTimes;
+
+    std::unique_ptr<::mapbox::sqlite::Transaction> batch;
+    std::size_t batchSize = 0;
+    std::size_t maximumBatchSize = 1;
 };
 
 } // namespace mbgl
@@ -3,30 +3,43 @@
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/string.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 
 ThreadPool::ThreadPool(std::size_t count) {
+    count = std::max<std::size_t>(count, 1);
+
+    queues.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+
     threads.reserve(count);
     for (std::size_t i = 0; i < count; ++i) {
         threads.emplace_back([this, i]() {
+            workerIndex.set(&i);
             platform::setCurrentThreadName(std::string{ "Worker " } + util::toString(i + 1));
 
-            while (true) {
-                std::unique_lock<std::mutex> lock(mutex);
+            while (!terminate) {
+                std::weak_ptr<Mailbox> mailbox;
 
-                cv.wait(lock, [this] {
-                    return !queue.empty() || terminate;
-                });
-
-                if (terminate) {
-                    return;
+                if (pop(i, mailbox) || steal(i, mailbox)) {
+                    --pending;
+                    Mailbox::maybeReceive(mailbox);
+                    continue;
                 }
 
-                auto mailbox = queue.front();
-                queue.pop();
-                lock.unlock();
+                std::unique_lock<std::mutex> lock(mutex);
 
-                Mailbox::maybeReceive(mailbox);
+                // `sleeping` and `pending` are both sequentially consistent: either schedule()
+                // observes this worker as sleeping and notifies under the lock, or the predicate
+                // below observes the newly pending mailbox.
+                ++sleeping;
+                cv.wait(lock, [this] {
+                    return pending > 0 || terminate;
+                });
+                --sleeping;
             }
         });
     }
@@ -45,13 +58,69 @@ ThreadPool::~ThreadPool() {
     }
 }
 
+std::size_t ThreadPool::defaultThreadCount() {
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
 void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    std::size_t index = currentWorker();
+    if (index == queues.size()) {
+        index = nextQueue++ % queues.size();
+    }
+
+    auto priority = Mailbox::Priority::Normal;
+    if (auto locked = mailbox.lock()) {
+        priority = locked->getPriority();
+    }
+
     {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.mailboxes[static_cast<std::size_t>(priority)].push_back(std::move(mailbox));
+    }
+
+    ++pending;
+
+    if (sleeping > 0) {
         std::lock_guard<std::mutex> lock(mutex);
-        queue.push(mailbox);
+        cv.notify_one();
+    }
+}
+
+bool ThreadPool::pop(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    for (auto& mailboxes : queue.mailboxes) {
+        if (!mailboxes.empty()) {
+            mailbox = std::move(mailboxes.front());
+            mailboxes.pop_front();
+            return true;
+        }
     }
+    return false;
+}
+
+bool ThreadPool::steal(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+        Queue& queue = *queues[(index + offset) % queues.size()];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            continue;
+        }
+        for (auto& mailboxes : queue.mailboxes) {
+            if (!mailboxes.empty()) {
+                mailbox = std::move(mailboxes.back());
+                mailboxes.pop_back();
+                return true;
+            }
+        }
+    }
+    return false;
+}
 
-    cv.notify_one();
+std::size_t ThreadPool::currentWorker() {
+    const std::size_t* index = workerIndex.get();
+    return index ? *index : queues.size();
 }
 
 } // namespace mbgl
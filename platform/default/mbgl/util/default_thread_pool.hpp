@@ -1,27 +1,62 @@
 #pragma once
 
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/thread_local.hpp>
 
+#include <array>
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+// A work-stealing `Scheduler`. Each worker thread owns a queue of mailboxes; mailboxes scheduled
+// from a worker thread go to that worker's queue, and mailboxes scheduled from any other thread
+// are distributed round-robin. Idle workers steal from the back of other workers' queues before
+// going to sleep. A `Mailbox` is never present in more than one queue at a time, so the ordering
+// and non-concurrency guarantees described in scheduler.hpp are preserved.
+//
+// Each queue is split by `Mailbox::Priority`: a worker always takes the highest priority mailbox
+// from its own queue, and steals the highest priority mailbox from another queue once its own
+// queue is empty.
 class ThreadPool : public Scheduler {
 public:
     ThreadPool(std::size_t count);
     ~ThreadPool() override;
 
     void schedule(std::weak_ptr<Mailbox>) override;
+    std::size_t threadCount() const override { return threads.size(); }
+
+    // Returns the number of hardware threads, or 1 if it can't be determined.
+    static std::size_t defaultThreadCount();
 
 private:
+    struct Queue {
+        std::mutex mutex;
+        std::array<std::deque<std::weak_ptr<Mailbox>>, 3> mailboxes;
+    };
+
+    bool pop(std::size_t index, std::weak_ptr<Mailbox>&);
+    bool steal(std::size_t index, std::weak_ptr<Mailbox>&);
+    std::size_t currentWorker();
+
+    std::vector<std::unique_ptr<Queue>> queues;
+
+    // The index of the worker running on the current thread, or null on other threads.
+    util::ThreadLocal<const std::size_t> workerIndex;
     std::vector<std::thread> threads;
-    std::queue<std::weak_ptr<Mailbox>> queue;
+
+    std::atomic<std::size_t> nextQueue { 0 };
+    std::atomic<std::ptrdiff_t> pending { 0 };
+    std::atomic<std::size_t> sleeping { 0 };
+
     std::mutex mutex;
     std::condition_variable cv;
-    bool terminate { false };
+    std::atomic<bool> terminate { false };
 };
 
 } // namespace mbgl
@@ -0,0 +1,326 @@
+#include <mbgl/util/image_encoder.hpp>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#define NETWORK_BYTE_UINT32(value)                                                                 \
+    char(value >> 24), char(value >> 16), char(value >> 8), char(value >> 0)
+
+namespace mbgl {
+
+namespace {
+
+// Needed when using a zlib compiled with -DZ_PREFIX.
+#undef compress
+
+void addChunk(std::string& png, const char* type, const char* data = "", const uint32_t size = 0) {
+    assert(strlen(type) == 4);
+
+    // Checksum encompasses type + data
+    uLong checksum = crc32(0, reinterpret_cast<const Bytef*>(type), 4);
+    checksum = crc32(checksum, reinterpret_cast<const Bytef*>(data), size);
+
+    const char length[4] = { NETWORK_BYTE_UINT32(size) };
+    const char crc[4] = { NETWORK_BYTE_UINT32(uint32_t(checksum)) };
+
+    png.append(length, 4);
+    png.append(type, 4);
+    png.append(data, size);
+    png.append(crc, 4);
+}
+
+// Same rounding as util::unpremultiply(), so that both encoders produce the same pixels.
+inline void unpremultiply(const uint8_t* src, uint8_t* dst, const std::size_t bytes) {
+    for (std::size_t i = 0; i < bytes; i += 4) {
+        const uint8_t a = src[i + 3];
+        if (a) {
+            dst[i + 0] = (255 * src[i + 0] + (a / 2)) / a;
+            dst[i + 1] = (255 * src[i + 1] + (a / 2)) / a;
+            dst[i + 2] = (255 * src[i + 2] + (a / 2)) / a;
+        } else {
+            dst[i + 0] = src[i + 0];
+            dst[i + 1] = src[i + 1];
+            dst[i + 2] = src[i + 2];
+        }
+        dst[i + 3] = a;
+    }
+}
+
+// Sum of the filtered bytes interpreted as signed values; the usual heuristic for how well a
+// filtered row compresses.
+inline uint32_t cost(const uint8_t* row, const std::size_t size) {
+    uint32_t sum = 0;
+    for (std::size_t i = 0; i < size; i++) {
+        sum += std::abs(int8_t(row[i]));
+    }
+    return sum;
+}
+
+} // namespace
+
+class ImageEncoder::Impl {
+public:
+    Impl(int compressionLevel) {
+        std::memset(&stream, 0, sizeof(stream));
+        if (deflateInit(&stream, compressionLevel) != Z_OK) {
+            throw std::runtime_error("failed to initialize deflate");
+        }
+    }
+
+    ~Impl() {
+        deflateEnd(&stream);
+    }
+
+    // Prepares the stream for compressing `size` bytes into `output`, which is only reallocated
+    // if it is smaller than the worst case size of the compressed data.
+    void reset(const std::size_t size) {
+        if (deflateReset(&stream) != Z_OK) {
+            throw std::runtime_error("failed to reset deflate");
+        }
+        const std::size_t bound = deflateBound(&stream, uLong(size));
+        if (output.size() < bound) {
+            output.resize(bound);
+        }
+        stream.next_out = output.data();
+        stream.avail_out = uInt(output.size());
+    }
+
+    void deflate(const uint8_t* data, const std::size_t size, const int flush) {
+        stream.next_in = const_cast<Bytef*>(data);
+        stream.avail_in = uInt(size);
+
+        int code;
+        while (true) {
+            code = ::deflate(&stream, flush);
+            if (code == Z_STREAM_ERROR) {
+                throw std::runtime_error("failed to deflate image data");
+            }
+            if (flush == Z_FINISH ? code == Z_STREAM_END : stream.avail_in == 0) {
+                break;
+            }
+            if (stream.avail_out == 0) {
+                // Only happens if the data compresses worse than deflateBound() predicted.
+                const std::size_t used = output.size();
+                output.resize(used * 2);
+                stream.next_out = output.data() + used;
+                stream.avail_out = uInt(output.size() - used);
+            }
+        }
+    }
+
+    std::size_t compressedSize() const {
+        return output.size() - stream.avail_out;
+    }
+
+    // Filters `current` against `previous` into `row`, which is prefixed with the filter type.
+    void filter(PNGFilter mode, const std::size_t stride, const std::size_t bpp) {
+        const uint8_t* cur = current.data();
+        const uint8_t* prev = previous.data();
+
+        auto sub = [&](uint8_t* out) {
+            out[0] = 1;
+            for (std::size_t i = 0; i < bpp; i++) {
+                out[1 + i] = cur[i];
+            }
+            for (std::size_t i = bpp; i < stride; i++) {
+                out[1 + i] = cur[i] - cur[i - bpp];
+            }
+        };
+
+        auto up = [&](uint8_t* out) {
+            out[0] = 2;
+            for (std::size_t i = 0; i < stride; i++) {
+                out[1 + i] = cur[i] - prev[i];
+            }
+        };
+
+        switch (mode) {
+        case PNGFilter::None:
+            row[0] = 0;
+            std::memcpy(row.data() + 1, cur, stride);
+            break;
+        case PNGFilter::Sub:
+            sub(row.data());
+            break;
+        case PNGFilter::Up:
+            up(row.data());
+            break;
+        case PNGFilter::Adaptive: {
+            sub(row.data());
+            up(alternative.data());
+            uint32_t best = cost(row.data() + 1, stride);
+            const uint32_t upCost = cost(alternative.data() + 1, stride);
+            if (upCost < best) {
+                std::swap(row, alternative);
+                best = upCost;
+            }
+            if (cost(cur, stride) < best) {
+                row[0] = 0;
+                std::memcpy(row.data() + 1, cur, stride);
+            }
+            break;
+        }
+        }
+    }
+
+    // Reduces the colors of the unpremultiplied image in `pixels` to at most 256 palette entries
+    // and stores the index of each pixel in `indices`. Colors are merged by dropping low bits
+    // until few enough remain, and each palette entry is the average of the colors it replaces.
+    void quantize(const std::size_t count) {
+        const uint32_t* colors = reinterpret_cast<const uint32_t*>(pixels.data());
+
+        for (uint32_t shift = 0;; shift++) {
+            const uint32_t byteMask = (0xFFu << shift) & 0xFFu;
+            mask = byteMask * 0x01010101u;
+
+            buckets.clear();
+            bool fits = true;
+            for (std::size_t i = 0; i < count; i++) {
+                buckets.emplace(colors[i] & mask, uint8_t(buckets.size()));
+                if (buckets.size() > 256) {
+                    fits = false;
+                    break;
+                }
+            }
+            if (fits) {
+                break;
+            }
+        }
+
+        const std::size_t entries = buckets.size();
+        sums.assign(entries, {{ 0, 0, 0, 0, 0 }});
+        indices.resize(count);
+        for (std::size_t i = 0; i < count; i++) {
+            const uint8_t index = buckets[colors[i] & mask];
+            indices[i] = index;
+            const uint8_t* rgba = pixels.data() + i * 4;
+            auto& sum = sums[index];
+            sum[0] += rgba[0];
+            sum[1] += rgba[1];
+            sum[2] += rgba[2];
+            sum[3] += rgba[3];
+            sum[4]++;
+        }
+
+        palette.resize(entries * 3);
+        alpha.resize(entries);
+        for (std::size_t i = 0; i < entries; i++) {
+            const auto& sum = sums[i];
+            const uint64_t n = sum[4];
+            palette[i * 3 + 0] = uint8_t((sum[0] + n / 2) / n);
+            palette[i * 3 + 1] = uint8_t((sum[1] + n / 2) / n);
+            palette[i * 3 + 2] = uint8_t((sum[2] + n / 2) / n);
+            alpha[i] = uint8_t((sum[3] + n / 2) / n);
+        }
+    }
+
+    z_stream stream;
+
+    // Scratch buffers that are reused between images.
+    std::vector<uint8_t> output;
+    std::vector<uint8_t> current;
+    std::vector<uint8_t> previous;
+    std::vector<uint8_t> row;
+    std::vector<uint8_t> alternative;
+
+    // Palette quantization state. `pixels` also holds the unpremultiplied image for WebP encoding.
+    std::vector<uint8_t> pixels;
+    std::vector<uint8_t> indices;
+    std::unordered_map<uint32_t, uint8_t> buckets;
+    std::vector<std::array<uint64_t, 5>> sums;
+    std::vector<uint8_t> palette;
+    std::vector<uint8_t> alpha;
+    uint32_t mask = 0;
+};
+
+ImageEncoder::ImageEncoder()
+    : ImageEncoder(Options()) {
+}
+
+ImageEncoder::ImageEncoder(Options options_)
+    : options(std::move(options_)),
+      impl(std::make_unique<Impl>(options.compressionLevel)) {
+}
+
+ImageEncoder::~ImageEncoder() = default;
+
+const uint8_t* ImageEncoder::unpremultiplied(const PremultipliedImage& image) {
+    impl->pixels.resize(image.bytes());
+    unpremultiply(image.data.get(), impl->pixels.data(), image.bytes());
+    return impl->pixels.data();
+}
+
+std::string ImageEncoder::encodePNG(const PremultipliedImage& image) {
+    Impl& state = *impl;
+    const Size size = image.size;
+    const std::size_t bpp = options.palette ? 1 : 4;
+    const std::size_t stride = size.width * bpp;
+
+    if (options.palette) {
+        unpremultiplied(image);
+        state.quantize(size.area());
+    }
+
+    // PNG magic bytes
+    const char preamble[8] = { char(0x89), 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    const char ihdr[13] = {
+        NETWORK_BYTE_UINT32(size.width),    // width
+        NETWORK_BYTE_UINT32(size.height),   // height
+        8,                                  // bit depth == 8 bits
+        char(options.palette ? 3 : 6),      // color type == indexed or RGBA
+        0,                                  // compression method == deflate
+        0,                                  // filter method == default
+        0,                                  // interlace method == none
+    };
+
+    state.row.resize(stride + 1);
+    state.alternative.resize(stride + 1);
+    state.current.resize(stride);
+    state.previous.assign(stride, 0);
+    state.reset(state.row.size() * size.height);
+
+    for (uint32_t y = 0; y < size.height; y++) {
+        if (options.palette) {
+            // Filtering rarely helps indexed images.
+            state.row[0] = 0;
+            std::memcpy(state.row.data() + 1, state.indices.data() + y * stride, stride);
+        } else {
+            unpremultiply(image.data.get() + y * stride, state.current.data(), stride);
+            state.filter(options.filter, stride, bpp);
+            std::swap(state.current, state.previous);
+        }
+        state.deflate(state.row.data(), state.row.size(), Z_NO_FLUSH);
+    }
+    state.deflate(nullptr, 0, Z_FINISH);
+
+    const std::size_t idatSize = state.compressedSize();
+
+    std::string png;
+    png.reserve(8 + 25 + 12 + state.palette.size() + 12 + state.alpha.size() + 12 + idatSize + 12);
+    png.append(preamble, 8);
+    addChunk(png, "IHDR", ihdr, 13);
+
+    if (options.palette) {
+        addChunk(png, "PLTE", reinterpret_cast<const char*>(state.palette.data()),
+                 uint32_t(state.palette.size()));
+        if (std::any_of(state.alpha.begin(), state.alpha.end(), [](uint8_t a) { return a != 255; })) {
+            addChunk(png, "tRNS", reinterpret_cast<const char*>(state.alpha.data()),
+                     uint32_t(state.alpha.size()));
+        }
+    }
+
+    addChunk(png, "IDAT", reinterpret_cast<const char*>(state.output.data()), uint32_t(idatSize));
+    addChunk(png, "IEND");
+    return png;
+}
+
+} // namespace mbgl
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <memory>
+#include <string>
+
+namespace mbgl {
+
+// Encodes rendered images for serving, keeping its compression state and scratch buffers between
+// calls so that encoding many images doesn't allocate for each one. Unpremultiplying, PNG
+// filtering and deflating are done row by row in a single pass over the image.
+//
+// An encoder must not be used from more than one thread at a time; use one encoder per thread.
+class ImageEncoder : private util::noncopyable {
+public:
+    enum class PNGFilter : uint8_t {
+        None,
+        Sub,
+        Up,
+        // Picks the filter that is likely to compress best for each row.
+        Adaptive,
+    };
+
+    struct Options {
+        // zlib compression level, from 0 (store only) to 9 (smallest output), or -1 for zlib's
+        // default level.
+        int compressionLevel = -1;
+        PNGFilter filter = PNGFilter::Adaptive;
+        // Writes an indexed PNG with at most 256 colors. Images with more colors are quantized,
+        // which is lossy.
+        bool palette = false;
+        // WebP quality from 0 to 100, or -1 for lossless output.
+        float webpQuality = 80;
+    };
+
+    ImageEncoder();
+    ImageEncoder(Options);
+    ~ImageEncoder();
+
+    std::string encodePNG(const PremultipliedImage&);
+
+    // Only available on platforms that link libwebp.
+    std::string encodeWebP(const PremultipliedImage&);
+
+    const Options options;
+
+private:
+    // Unpremultiplies the image into a scratch buffer of the encoder, which stays valid until the
+    // next call.
+    const uint8_t* unpremultiplied(const PremultipliedImage&);
+
+    class Impl;
+    const std::unique_ptr<Impl> impl;
+};
+
+} // namespace mbgl
@@ -0,0 +1,99 @@
+#include <mbgl/util/metatile_renderer.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/util/constants.hpp>
+#include <mbgl/util/projection.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace mbgl {
+
+MetatileRenderer::MetatileRenderer(Map& map_,
+                                   gl::Context& context_,
+                                   const float pixelRatio_,
+                                   const uint32_t size_,
+                                   const uint32_t tileSize_,
+                                   const uint32_t buffer_)
+    : map(map_),
+      context(context_),
+      pixelRatio(pixelRatio_),
+      size(size_),
+      tileSize(tileSize_),
+      buffer(buffer_),
+      tilePixels(static_cast<uint32_t>(std::lround(tileSize * pixelRatio))),
+      bufferPixels(static_cast<uint32_t>(std::lround(buffer * pixelRatio))) {
+    assert(size > 0);
+    assert(tileSize > 0);
+
+    // Tiles are cut from the rendered image at whole pixels, which only line up with the map if
+    // the tile size and buffer are whole numbers of pixels at the pixel ratio.
+    if (tilePixels != tileSize * pixelRatio || bufferPixels != buffer * pixelRatio) {
+        throw std::invalid_argument("tile size and buffer must be whole numbers of pixels at the pixel ratio");
+    }
+}
+
+MetatileRenderer::~MetatileRenderer() = default;
+
+void MetatileRenderer::render(const uint8_t z, const uint32_t x, const uint32_t y, Callback callback) {
+    // Tiles of `tileSize` pixels at zoom level `z` correspond to this map scale.
+    const double scale = std::pow(2.0, z) * tileSize / util::tileSize;
+    // The map clamps its zoom level to its own range, which would render the wrong area.
+    if (std::log2(scale) < map.getMinZoom() || std::log2(scale) > map.getMaxZoom()) {
+        throw std::domain_error("zoom level out of range");
+    }
+
+    const uint32_t worldTiles = 1u << z;
+    if (x >= worldTiles || y >= worldTiles) {
+        throw std::domain_error("tile coordinates out of range");
+    }
+
+    const uint32_t x0 = x / size * size;
+    const uint32_t y0 = y / size * size;
+    const uint32_t columns = std::min(size, worldTiles - x0);
+    const uint32_t rows = std::min(size, worldTiles - y0);
+
+    const Size mapSize { columns * tileSize + 2 * buffer, rows * tileSize + 2 * buffer };
+    const Size viewSize { columns * tilePixels + 2 * bufferPixels, rows * tilePixels + 2 * bufferPixels };
+    if (!view || view->getSize() != viewSize) {
+        view = std::make_unique<OffscreenView>(context, viewSize);
+    }
+
+    const LatLng center = Projection::unproject(
+        { (x0 + columns / 2.0) * tileSize, (y0 + rows / 2.0) * tileSize }, scale);
+
+    // The buffer may extend beyond the edges of the world, which must not move the camera.
+    map.setConstrainMode(ConstrainMode::None);
+    map.setSize(mapSize);
+    map.setLatLngZoom(center, std::log2(scale));
+    map.setBearing(0);
+    map.setPitch(0);
+
+    map.renderStill(*view, [this, x0, y0, columns, rows, callback](std::exception_ptr error) {
+        if (error) {
+            callback(error, {});
+            return;
+        }
+
+        const PremultipliedImage image = view->readStillImage();
+        const uint32_t offset = bufferPixels;
+
+        std::vector<Tile> tiles;
+        tiles.reserve(columns * rows);
+        for (uint32_t row = 0; row < rows; row++) {
+            for (uint32_t column = 0; column < columns; column++) {
+                PremultipliedImage tile({ tilePixels, tilePixels });
+                PremultipliedImage::copy(image, tile,
+                                         { offset + column * tilePixels, offset + row * tilePixels },
+                                         { 0, 0 }, tile.size);
+                tiles.push_back({ x0 + column, y0 + row, std::move(tile) });
+            }
+        }
+
+        callback(nullptr, std::move(tiles));
+    });
+}
+
+} // namespace mbgl
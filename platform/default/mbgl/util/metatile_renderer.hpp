@@ -0,0 +1,70 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+
+class Map;
+class OffscreenView;
+
+namespace gl {
+class Context;
+} // namespace gl
+
+// Renders a block of `size` × `size` neighbouring raster tiles (a "metatile") with a single
+// renderStill() call and slices the result into the individual tiles. Tile loading, symbol
+// placement and GL setup are done once per metatile instead of once per tile, and labels that
+// cross the seams between tiles of the same metatile are drawn consistently on both sides.
+//
+// `buffer` extends the rendered area by that many pixels on each side, so that labels placed
+// near the edges of the metatile match those of the neighbouring metatiles as well.
+//
+// The renderer takes over the camera, size and constrain mode of the map, which must have been
+// created with the same pixel ratio. Only one render may be in progress at a time. The tile size
+// and buffer must be whole numbers of pixels at that pixel ratio.
+class MetatileRenderer : private util::noncopyable {
+public:
+    struct Tile {
+        uint32_t x;
+        uint32_t y;
+        PremultipliedImage image;
+    };
+
+    using Callback = std::function<void (std::exception_ptr, std::vector<Tile>)>;
+
+    MetatileRenderer(Map&,
+                     gl::Context&,
+                     float pixelRatio,
+                     uint32_t size = 4,
+                     uint32_t tileSize = 256,
+                     uint32_t buffer = 0);
+    ~MetatileRenderer();
+
+    // Renders the metatile that contains the tile z/x/y and calls back with the images of all
+    // its tiles, in row-major order. Metatiles at the right and bottom edges of the world are
+    // narrowed to the tiles that exist at that zoom level. Throws if the tile doesn't exist, or is
+    // outside of the map's zoom range.
+    void render(uint8_t z, uint32_t x, uint32_t y, Callback);
+
+private:
+    Map& map;
+    gl::Context& context;
+    const float pixelRatio;
+    const uint32_t size;
+    const uint32_t tileSize;
+    const uint32_t buffer;
+
+    // The tile size and buffer in pixels of the rendered image.
+    const uint32_t tilePixels;
+    const uint32_t bufferPixels;
+
+    std::unique_ptr<OffscreenView> view;
+};
+
+} // namespace mbgl
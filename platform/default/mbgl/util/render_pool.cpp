@@ -0,0 +1,152 @@
+#include <mbgl/util/render_pool.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/headless_display.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/style/style.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+
+#include <cassert>
+
+namespace mbgl {
+
+class RenderPool::Worker {
+public:
+    Worker(ActorRef<Worker> self_,
+           RenderPool& pool_,
+           std::shared_ptr<HeadlessDisplay> display,
+           FileSource& fileSource,
+           Scheduler& scheduler,
+           const float pixelRatio_)
+        : self(std::move(self_)),
+          pool(pool_),
+          pixelRatio(pixelRatio_),
+          backend(std::move(display)),
+          map(backend, { 512, 512 }, pixelRatio, fileSource, scheduler, MapMode::Still) {
+    }
+
+    void render(Request request_) {
+        assert(!request);
+        request = std::move(request_);
+        const Job& job = request->job;
+
+        if (job.style != style) {
+            map.getStyle().loadJSON(job.style);
+            style = job.style;
+        }
+
+        const Size viewSize { static_cast<uint32_t>(job.size.width * pixelRatio),
+                              static_cast<uint32_t>(job.size.height * pixelRatio) };
+        if (!view || view->getSize() != viewSize) {
+            view = std::make_unique<OffscreenView>(backend.getContext(), viewSize);
+        }
+
+        map.setSize(job.size);
+        map.setDebug(job.debugOptions);
+        map.jumpTo(job.camera);
+
+        map.renderStill(*view, [this](std::exception_ptr error) {
+            PremultipliedImage image;
+            if (!error) {
+                image = view->readStillImage();
+            }
+
+            request->loop->invoke([canceled = pool.canceled, callback = std::move(request->callback)]
+                                  (std::exception_ptr error_, PremultipliedImage image_) {
+                if (!*canceled) {
+                    callback(error_, std::move(image_));
+                }
+            }, error, std::move(image));
+            request = {};
+
+            // Start the next job in a separate message, rather than from within the render.
+            Request next;
+            if (pool.next(self, next)) {
+                self.invoke(&Worker::render, std::move(next));
+            }
+        });
+    }
+
+private:
+    ActorRef<Worker> self;
+    RenderPool& pool;
+    const float pixelRatio;
+
+    HeadlessBackend backend;
+    BackendScope scope { backend };
+    Map map;
+    std::unique_ptr<OffscreenView> view;
+
+    std::string style;
+    optional<Request> request;
+};
+
+RenderPool::RenderPool(const std::size_t size,
+                       FileSource& fileSource,
+                       Scheduler& scheduler,
+                       const float pixelRatio)
+    : RenderPool(size, fileSource, scheduler, pixelRatio, std::make_shared<HeadlessDisplay>()) {
+}
+
+RenderPool::RenderPool(const std::size_t size,
+                       FileSource& fileSource,
+                       Scheduler& scheduler,
+                       const float pixelRatio,
+                       std::shared_ptr<HeadlessDisplay> display) {
+    assert(size > 0);
+    workers.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        workers.push_back(std::make_unique<util::Thread<Worker>>(
+            "RenderPool " + util::toString(i), *this, display, fileSource, scheduler, pixelRatio));
+        idle.push_back(workers.back()->actor());
+    }
+}
+
+RenderPool::~RenderPool() {
+    *canceled = true;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    queue.clear();
+    lock.unlock();
+
+    // Destroying the workers waits for their threads to finish. A worker that completes a job in
+    // the meantime finds the queue empty and goes idle.
+    workers.clear();
+}
+
+std::size_t RenderPool::getSize() const {
+    return workers.size();
+}
+
+void RenderPool::render(Job job, Callback callback) {
+    assert(util::RunLoop::Get());
+    Request request { std::move(job), std::move(callback), util::RunLoop::Get() };
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idle.empty()) {
+        queue.push_back(std::move(request));
+        return;
+    }
+
+    auto worker = idle.back();
+    idle.pop_back();
+    worker.invoke(&Worker::render, std::move(request));
+}
+
+bool RenderPool::next(ActorRef<Worker> worker, Request& request) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (queue.empty()) {
+        idle.push_back(worker);
+        return false;
+    }
+
+    request = std::move(queue.front());
+    queue.pop_front();
+    return true;
+}
+
+} // namespace mbgl
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/size.hpp>
+
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class FileSource;
+class HeadlessDisplay;
+class Scheduler;
+
+namespace util {
+template <class> class Thread;
+class RunLoop;
+} // namespace util
+
+// Renders still images on several threads at once. Each thread owns a headless backend with its
+// own GL context and a Map in still mode, while the file source, the worker thread pool and the
+// headless display are shared by all of them. Jobs are queued and dispatched to whichever thread
+// is idle, so that a process can keep all cores busy with a software GL implementation such as
+// llvmpipe, where a single context renders serially.
+//
+// A thread keeps the style of its previous job loaded, so jobs that use the same style avoid
+// reparsing it, and tiles, glyphs and sprites already loaded by that thread are reused.
+class RenderPool : private util::noncopyable {
+public:
+    struct Job {
+        // The style JSON.
+        std::string style;
+        CameraOptions camera;
+        Size size { 512, 512 };
+        MapDebugOptions debugOptions = MapDebugOptions::NoDebug;
+    };
+
+    using Callback = std::function<void (std::exception_ptr, PremultipliedImage)>;
+
+    // Creates `size` render threads, whose maps render at `pixelRatio`. The file source and
+    // scheduler must outlive the pool.
+    RenderPool(std::size_t size, FileSource&, Scheduler&, float pixelRatio = 1);
+    RenderPool(std::size_t size, FileSource&, Scheduler&, float pixelRatio,
+               std::shared_ptr<HeadlessDisplay>);
+
+    // Waits for the jobs in progress to finish. Callbacks that haven't been called yet, including
+    // those of queued jobs, are not called. A callback that is running on another thread at the
+    // time may still complete.
+    ~RenderPool();
+
+    std::size_t getSize() const;
+
+    // Queues a job. May be called from any thread that has a RunLoop; the callback is invoked
+    // on that thread.
+    void render(Job, Callback);
+
+private:
+    class Worker;
+
+    struct Request {
+        Job job;
+        Callback callback;
+        util::RunLoop* loop = nullptr;
+    };
+
+    // Hands the next queued request to a worker that finished its job, or marks it as idle.
+    bool next(ActorRef<Worker>, Request&);
+
+    std::mutex mutex;
+    std::deque<Request> queue;
+    std::vector<ActorRef<Worker>> idle;
+
+    // Set when the pool is destroyed. Shared with the callbacks posted to the RunLoops of the
+    // jobs, which may run after the pool is gone.
+    std::shared_ptr<std::atomic<bool>> canceled = std::make_shared<std::atomic<bool>>(false);
+
+    // Destroyed first, so that workers can call next() until they're gone.
+    std::vector<std::unique_ptr<util::Thread<Worker>>> workers;
+};
+
+} // namespace mbgl
@@ -6,7 +6,7 @@ std::shared_ptr<ThreadPool> sharedThreadPool() {
     static std::weak_ptr<ThreadPool> weak;
     auto pool = weak.lock();
     if (!pool) {
-        weak = pool = std::make_shared<ThreadPool>(4);
+        weak = pool = std::make_shared<ThreadPool>(ThreadPool::defaultThreadCount());
     }
     return pool;
 }
@@ -0,0 +1,223 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/storage/file_source_request.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/string.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/url.hpp>
+
+#include "sqlite3.hpp"
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <unordered_map>
+
+namespace {
+
+const char* protocol = "mbtiles://";
+const std::size_t protocolLength = 10;
+
+struct TileAddress {
+    std::string path;
+    int64_t z;
+    int64_t x;
+    int64_t y;
+};
+
+// Splits "<path>/z/x/y" into the archive path and the tile coordinates.
+mbgl::optional<TileAddress> parseTileAddress(const std::string& path) {
+    TileAddress address;
+    std::size_t end = path.size();
+    for (int64_t* coordinate : { &address.y, &address.x, &address.z }) {
+        if (end == 0) {
+            return {};
+        }
+        const std::size_t slash = path.rfind('/', end - 1);
+        if (slash == std::string::npos || slash + 1 == end) {
+            return {};
+        }
+        const std::string segment = path.substr(slash + 1, end - slash - 1);
+        char* parsed = nullptr;
+        *coordinate = std::strtoll(segment.c_str(), &parsed, 10);
+        if (*parsed != '\0' || *coordinate < 0) {
+            return {};
+        }
+        end = slash;
+    }
+    address.path = path.substr(0, end);
+    return address;
+}
+
+bool isGzipped(const std::string& data) {
+    return data.size() >= 2 && uint8_t(data[0]) == 0x1f && uint8_t(data[1]) == 0x8b;
+}
+
+template <class Writer>
+void writeNumbers(Writer& writer, const std::string& list) {
+    writer.StartArray();
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        const std::size_t comma = std::min(list.find(',', start), list.size());
+        writer.Double(std::atof(list.substr(start, comma - start).c_str()));
+        start = comma + 1;
+    }
+    writer.EndArray();
+}
+
+} // namespace
+
+namespace mbgl {
+
+class MBTilesFileSource::Worker {
+public:
+    Worker(ActorRef<Worker>) {}
+
+    void request(const std::string& url, Resource::Kind kind, ActorRef<FileSourceRequest> req) {
+        Response response;
+
+        try {
+            if (kind == Resource::Kind::Tile) {
+                requestTile(url, response);
+            } else {
+                requestTileJSON(url, response);
+            }
+        } catch (const mapbox::sqlite::Exception& ex) {
+            response.error = std::make_unique<Response::Error>(
+                ex.code == mapbox::sqlite::Exception::CANTOPEN ? Response::Error::Reason::NotFound
+                                                                : Response::Error::Reason::Other,
+                ex.what());
+        } catch (...) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other,
+                util::toString(std::current_exception()));
+        }
+
+        req.invoke(&FileSourceRequest::setResponse, response);
+    }
+
+private:
+    struct Archive {
+        Archive(const std::string& path)
+            : db(path, mapbox::sqlite::ReadOnly),
+              tile(db.prepare("SELECT tile_data FROM tiles "
+                              "WHERE zoom_level = ?1 AND tile_column = ?2 AND tile_row = ?3")),
+              metadata(db.prepare("SELECT name, value FROM metadata")) {
+        }
+
+        mapbox::sqlite::Database db;
+        mapbox::sqlite::Statement tile;
+        mapbox::sqlite::Statement metadata;
+    };
+
+    Archive& getArchive(const std::string& path) {
+        auto it = archives.find(path);
+        if (it == archives.end()) {
+            it = archives.emplace(path, std::make_unique<Archive>(path)).first;
+        }
+        return *it->second;
+    }
+
+    void requestTile(const std::string& url, Response& response) {
+        auto address = parseTileAddress(util::percentDecode(url.substr(protocolLength)));
+        if (!address) {
+            response.error = std::make_unique<Response::Error>(
+                Response::Error::Reason::Other, "Invalid MBTiles tile URL: " + url);
+            return;
+        }
+
+        auto& stmt = getArchive(address->path).tile;
+        stmt.reset();
+        stmt.bind(1, address->z);
+        stmt.bind(2, address->x);
+        stmt.bind(3, address->y);
+
+        if (!stmt.run()) {
+            response.noContent = true;
+            return;
+        }
+
+        auto data = stmt.get<std::string>(0);
+        stmt.reset();
+
+        if (isGzipped(data)) {
+            data = util::decompress(data);
+        }
+        response.data = std::make_shared<std::string>(std::move(data));
+    }
+
+    void requestTileJSON(std::string url, Response& response) {
+        while (url.size() > protocolLength && url.back() == '/') {
+            url.pop_back();
+        }
+
+        auto& stmt = getArchive(util::percentDecode(url.substr(protocolLength))).metadata;
+        stmt.reset();
+
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+
+        writer.StartObject();
+        writer.Key("tilejson");
+        writer.String("2.2.0");
+        writer.Key("tiles");
+        writer.StartArray();
+        writer.String(url + "/{z}/{x}/{y}");
+        writer.EndArray();
+        writer.Key("scheme");
+        writer.String("tms");
+
+        while (stmt.run()) {
+            const auto name = stmt.get<std::string>(0);
+            const auto value = stmt.get<std::string>(1);
+            if (name == "minzoom" || name == "maxzoom") {
+                writer.Key(name);
+                writer.Double(std::atof(value.c_str()));
+            } else if (name == "bounds" || name == "center") {
+                writer.Key(name);
+                writeNumbers(writer, value);
+            } else if (name == "name" || name == "description" || name == "attribution" ||
+                       name == "version" || name == "format") {
+                writer.Key(name);
+                writer.String(value);
+            }
+        }
+        stmt.reset();
+
+        writer.EndObject();
+        response.data = std::make_shared<std::string>(buffer.GetString(), buffer.GetSize());
+    }
+
+    // Keyed by path, so that every worker has its own connection to each archive.
+    std::unordered_map<std::string, std::unique_ptr<Archive>> archives;
+};
+
+MBTilesFileSource::MBTilesFileSource(const std::size_t connections) {
+    assert(connections > 0);
+    workers.reserve(connections);
+    for (std::size_t i = 0; i < connections; ++i) {
+        workers.push_back(std::make_unique<util::Thread<Worker>>(
+            "MBTilesFileSource " + util::toString(i)));
+    }
+}
+
+MBTilesFileSource::~MBTilesFileSource() = default;
+
+std::unique_ptr<AsyncRequest> MBTilesFileSource::request(const Resource& resource, Callback callback) {
+    auto req = std::make_unique<FileSourceRequest>(std::move(callback));
+
+    auto& worker = *workers[nextWorker++ % workers.size()];
+    worker.actor().invoke(&Worker::request, resource.url, resource.kind, req->actor());
+
+    return std::move(req);
+}
+
+bool MBTilesFileSource::acceptsURL(const std::string& url) {
+    return url.compare(0, protocolLength, protocol) == 0;
+}
+
+} // namespace mbgl
@@ -19,7 +19,8 @@
 
 #include <algorithm>
 #include <cassert>
-#include <list>
+#include <set>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -91,11 +92,11 @@ public:
         } else {
             auto it = pendingRequestsMap.find(request);
             if (it != pendingRequestsMap.end()) {
-                pendingRequestsList.erase(it->second);
+                pendingRequestsQueue.erase(it->second);
                 pendingRequestsMap.erase(it);
             }
         }
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     void activateOrQueueRequest(OnlineFileRequest* request) {
@@ -111,9 +112,28 @@ public:
     }
 
     void queueRequest(OnlineFileRequest* request) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), request);
+        auto it = pendingRequestsQueue.emplace(request, nextSequence++).first;
         pendingRequestsMap.emplace(request, std::move(it));
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
+    }
+
+    void setPriority(OnlineFileRequest* request, Resource::Priority priority) {
+        assert(allRequests.find(request) != allRequests.end());
+        if (request->resource.priority == priority) {
+            return;
+        }
+
+        request->resource.priority = priority;
+
+        // A pending request is queued again with its new rank. It keeps its sequence number, so
+        // that it still goes out before the requests of the same rank that were queued later.
+        auto it = pendingRequestsMap.find(request);
+        if (it != pendingRequestsMap.end()) {
+            const uint64_t sequence = it->second->sequence;
+            pendingRequestsQueue.erase(it->second);
+            it->second = pendingRequestsQueue.emplace(request, sequence).first;
+        }
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     void activateRequest(OnlineFileRequest* request) {
@@ -124,21 +144,21 @@ public:
             request->request.reset();
             request->completed(response);
         });
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     void activatePendingRequest() {
-        if (pendingRequestsList.empty()) {
+        if (pendingRequestsQueue.empty()) {
             return;
         }
 
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+        OnlineFileRequest* request = pendingRequestsQueue.begin()->request;
+        pendingRequestsQueue.erase(pendingRequestsQueue.begin());
 
         pendingRequestsMap.erase(request);
 
         activateRequest(request);
-        assert(pendingRequestsMap.size() == pendingRequestsList.size());
+        assert(pendingRequestsMap.size() == pendingRequestsQueue.size());
     }
 
     bool isPending(OnlineFileRequest* request) {
@@ -154,6 +174,32 @@ public:
     }
 
 private:
+    // Pending requests are ordered so that everything that blocks the first render (styles,
+    // sources, glyphs, sprites) goes out before tiles, required requests before optional ones,
+    // and higher priority requests before lower priority ones. Requests that compare equal are
+    // started in the order they were queued.
+    class PendingRequest {
+    public:
+        PendingRequest(OnlineFileRequest* request_, uint64_t sequence_)
+            : request(request_),
+              sequence(sequence_),
+              rank(request->resource.kind == Resource::Kind::Tile,
+                   request->resource.necessity == Resource::Optional,
+                   request->resource.priority,
+                   sequence) {
+        }
+
+        bool operator<(const PendingRequest& other) const {
+            return rank < other.rank;
+        }
+
+        OnlineFileRequest* const request;
+        const uint64_t sequence;
+
+    private:
+        const std::tuple<bool, bool, uint8_t, uint64_t> rank;
+    };
+
     void networkIsReachableAgain() {
         for (auto& request : allRequests) {
             request->networkIsReachableAgain();
@@ -174,8 +220,9 @@ private:
      * `pendingRequests`. Requests in the active state are in `activeRequests`.
      */
     std::unordered_set<OnlineFileRequest*> allRequests;
-    std::list<OnlineFileRequest*> pendingRequestsList;
-    std::unordered_map<OnlineFileRequest*, std::list<OnlineFileRequest*>::iterator> pendingRequestsMap;
+    std::set<PendingRequest> pendingRequestsQueue;
+    std::unordered_map<OnlineFileRequest*, std::set<PendingRequest>::iterator> pendingRequestsMap;
+    uint64_t nextSequence = 0;
     std::unordered_set<OnlineFileRequest*> activeRequests;
 
     HTTPFileSource httpFileSource;
@@ -221,6 +268,10 @@ std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource
     return std::make_unique<OnlineFileRequest>(std::move(res), std::move(callback), *impl);
 }
 
+void OnlineFileSource::setPriority(AsyncRequest& request, Resource::Priority priority) {
+    impl->setPriority(static_cast<OnlineFileRequest*>(&request), priority);
+}
+
 void OnlineFileSource::setResourceTransform(optional<ActorRef<ResourceTransform>>&& transform) {
     impl->setResourceTransform(std::move(transform));
 }
@@ -62,7 +62,8 @@ struct png_struct_guard {
     png_infopp i_;
 };
 
-PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
+template <ImageAlphaMode Mode>
+Image<Mode> decodePNG(const uint8_t* data, size_t size) {
     util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
     std::istream stream(&dataBuffer);
 
@@ -136,7 +137,10 @@ PremultipliedImage decodePNG(const uint8_t* data, size_t size) {
 
     png_read_end(png_ptr, nullptr);
 
-    return util::premultiply(std::move(image));
+    return util::convertImage<Mode>(std::move(image));
 }
 
+template UnassociatedImage decodePNG(const uint8_t*, size_t);
+template PremultipliedImage decodePNG(const uint8_t*, size_t);
+
 } // namespace mbgl
@@ -57,6 +57,7 @@ void ThreadLocal<T>::set(T* ptr) {
 template class ThreadLocal<RunLoop>;
 template class ThreadLocal<BackendScope>;
 template class ThreadLocal<int>; // For unit tests
+template class ThreadLocal<const std::size_t>; // For ThreadPool
 
 } // namespace util
 } // namespace mbgl
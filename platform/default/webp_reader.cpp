@@ -9,7 +9,8 @@ extern "C"
 
 namespace mbgl {
 
-PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
+template <ImageAlphaMode Mode>
+Image<Mode> decodeWebP(const uint8_t* data, size_t size) {
     int width = 0, height = 0;
     if (WebPGetInfo(data, size, &width, &height) == 0) {
         throw std::runtime_error("failed to retrieve WebP basic header information");
@@ -25,7 +26,10 @@ PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
 
     UnassociatedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) },
                             std::move(webp));
-    return util::premultiply(std::move(image));
+    return util::convertImage<Mode>(std::move(image));
 }
 
+template UnassociatedImage decodeWebP(const uint8_t*, size_t);
+template PremultipliedImage decodeWebP(const uint8_t*, size_t);
+
 } // namespace mbgl
@@ -0,0 +1,33 @@
+#include <mbgl/util/image_encoder.hpp>
+
+extern "C"
+{
+#include <webp/encode.h>
+}
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace mbgl {
+
+std::string ImageEncoder::encodeWebP(const PremultipliedImage& pre) {
+    const uint8_t* src = unpremultiplied(pre);
+    const int width = pre.size.width;
+    const int height = pre.size.height;
+    const int stride = pre.stride();
+
+    uint8_t* output = nullptr;
+    const size_t size = options.webpQuality < 0
+        ? WebPEncodeLosslessRGBA(src, width, height, stride, &output)
+        : WebPEncodeRGBA(src, width, height, stride, options.webpQuality, &output);
+
+    if (size == 0) {
+        throw std::runtime_error("failed to encode WebP image");
+    }
+
+    std::string webp(reinterpret_cast<const char*>(output), size);
+    free(output);
+    return webp;
+}
+
+} // namespace mbgl
@@ -52,6 +52,8 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/asset_file_source.cpp
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mapped_file.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/http_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
@@ -76,8 +78,11 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/image.cpp
         PRIVATE platform/default/jpeg_reader.cpp
         PRIVATE platform/default/png_writer.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.hpp
         PRIVATE platform/default/png_reader.cpp
         PRIVATE platform/default/webp_reader.cpp
+        PRIVATE platform/default/webp_writer.cpp
 
         # Headless view
         PRIVATE platform/default/mbgl/gl/headless_backend.cpp
@@ -85,6 +90,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/mbgl/gl/headless_display.hpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.hpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.cpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.hpp
+        PRIVATE platform/default/mbgl/util/render_pool.cpp
+        PRIVATE platform/default/mbgl/util/render_pool.hpp
 
         # Thread pool
         PRIVATE platform/default/mbgl/util/default_thread_pool.cpp
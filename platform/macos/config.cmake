@@ -15,6 +15,8 @@ macro(mbgl_platform_core)
         PRIVATE platform/default/asset_file_source.cpp
         PRIVATE platform/default/default_file_source.cpp
         PRIVATE platform/default/local_file_source.cpp
+        PRIVATE platform/default/mapped_file.cpp
+        PRIVATE platform/default/mbtiles_file_source.cpp
         PRIVATE platform/default/online_file_source.cpp
 
         # Default styles
@@ -44,6 +46,8 @@ macro(mbgl_platform_core)
         PRIVATE platform/darwin/mbgl/util/image+MGLAdditions.hpp
         PRIVATE platform/darwin/src/image.mm
         PRIVATE platform/default/png_writer.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.hpp
 
         # Headless view
         PRIVATE platform/default/mbgl/gl/headless_backend.cpp
@@ -53,6 +57,10 @@ macro(mbgl_platform_core)
         PRIVATE platform/darwin/src/headless_display_cgl.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.hpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.cpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.hpp
+        PRIVATE platform/default/mbgl/util/render_pool.cpp
+        PRIVATE platform/default/mbgl/util/render_pool.hpp
 
         # Thread pool
         PRIVATE platform/default/mbgl/util/shared_thread_pool.cpp
@@ -19,18 +19,6 @@
 
 namespace node_mbgl {
 
-struct NodeMap::RenderOptions {
-    double zoom = 0;
-    double bearing = 0;
-    double pitch = 0;
-    double latitude = 0;
-    double longitude = 0;
-    unsigned int width = 512;
-    unsigned int height = 512;
-    std::vector<std::string> classes;
-    mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
-};
-
 Nan::Persistent<v8::Function> NodeMap::constructor;
 
 static std::shared_ptr<mbgl::HeadlessDisplay> sharedDisplay() {
@@ -58,6 +46,7 @@ void NodeMap::Init(v8::Local<v8::Object> target) {
     Nan::SetPrototypeMethod(tpl, "load", Load);
     Nan::SetPrototypeMethod(tpl, "loaded", Loaded);
     Nan::SetPrototypeMethod(tpl, "render", Render);
+    Nan::SetPrototypeMethod(tpl, "renderBatch", RenderBatch);
     Nan::SetPrototypeMethod(tpl, "release", Release);
     Nan::SetPrototypeMethod(tpl, "cancel", Cancel);
 
@@ -346,6 +335,12 @@ void NodeMap::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
         return Nan::ThrowTypeError("Style is not loaded");
     }
 
+    // The next render of a batch is started before its callback is called, so the map stays busy
+    // until the batch's done callback.
+    if (nodeMap->batchCallback) {
+        return Nan::ThrowError("Map is currently rendering a batch");
+    }
+
     if (nodeMap->callback) {
         return Nan::ThrowError("Map is currently rendering an image");
     }
@@ -353,7 +348,7 @@ void NodeMap::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
     auto options = ParseOptions(Nan::To<v8::Object>(info[0]).ToLocalChecked());
 
     assert(!nodeMap->callback);
-    assert(!nodeMap->image.data);
+    assert(!nodeMap->imageRead);
     nodeMap->callback = std::make_unique<Nan::Callback>(info[1].As<v8::Function>());
 
     try {
@@ -365,11 +360,107 @@ void NodeMap::Render(const Nan::FunctionCallbackInfo<v8::Value>& info) {
     info.GetReturnValue().SetUndefined();
 }
 
+/**
+ * Render a batch of images from the currently-loaded style, one after another
+ * on the same map. Each render is started as soon as the previous one has
+ * finished, before its image is handed to `callback`.
+ *
+ * @name renderBatch
+ * @param {Array<Object>} options an array of render options, as accepted by
+ * `render`
+ * @param {Function} callback called with `(err, pixels, index)` once for
+ * every entry of `options`, in order
+ * @param {Function} done called once all images have been delivered, or with
+ * an error if the batch was aborted
+ * @returns {undefined} calls callback and done
+ * @throws {Error} if stylesheet is not loaded or if map is already rendering
+ *
+ * The next render starts before `callback` is called, so `render` and
+ * `renderBatch` throw if they're called from `callback` before the last image.
+ * Start new renders from `done` instead.
+ */
+void NodeMap::RenderBatch(const Nan::FunctionCallbackInfo<v8::Value>& info) {
+    auto nodeMap = Nan::ObjectWrap::Unwrap<NodeMap>(info.Holder());
+    if (!nodeMap->map) return Nan::ThrowError(releasedMessage());
+
+    if (info.Length() <= 0 || !info[0]->IsArray() || info[0].As<v8::Array>()->Length() == 0) {
+        return Nan::ThrowTypeError("First argument must be a non-empty array of options objects");
+    }
+
+    if (info.Length() <= 1 || !info[1]->IsFunction()) {
+        return Nan::ThrowTypeError("Second argument must be a callback function");
+    }
+
+    if (info.Length() <= 2 || !info[2]->IsFunction()) {
+        return Nan::ThrowTypeError("Third argument must be a callback function");
+    }
+
+    if (!nodeMap->loaded) {
+        return Nan::ThrowTypeError("Style is not loaded");
+    }
+
+    // The next render of a batch is started before its callback is called, so the map stays busy
+    // until the batch's done callback.
+    if (nodeMap->batchCallback) {
+        return Nan::ThrowError("Map is currently rendering a batch");
+    }
+
+    if (nodeMap->callback) {
+        return Nan::ThrowError("Map is currently rendering an image");
+    }
+
+    auto array = info[0].As<v8::Array>();
+    std::deque<RenderOptions> batch;
+    for (uint32_t i = 0; i < array->Length(); i++) {
+        auto options = Nan::Get(array, i).ToLocalChecked();
+        if (!options->IsObject()) {
+            return Nan::ThrowTypeError("First argument must be a non-empty array of options objects");
+        }
+        batch.push_back(ParseOptions(Nan::To<v8::Object>(options).ToLocalChecked()));
+    }
+
+    assert(!nodeMap->batchCallback);
+    nodeMap->batch = std::move(batch);
+    nodeMap->batchIndex = 0;
+    nodeMap->batchCallback = std::make_unique<Nan::Callback>(info[2].As<v8::Function>());
+
+    try {
+        nodeMap->startBatchRender(info[1].As<v8::Function>());
+    } catch (mbgl::util::Exception &ex) {
+        nodeMap->batch.clear();
+        nodeMap->batchCallback.reset();
+        return Nan::ThrowError(ex.what());
+    }
+
+    info.GetReturnValue().SetUndefined();
+}
+
+void NodeMap::startBatchRender(v8::Local<v8::Function> callback_) {
+    assert(!callback);
+    assert(!batch.empty());
+
+    auto options = std::move(batch.front());
+    batch.pop_front();
+
+    callback = std::make_unique<Nan::Callback>(callback_);
+
+    try {
+        startRender(std::move(options));
+    } catch (...) {
+        callback.reset();
+        throw;
+    }
+}
+
+mbgl::Size NodeMap::framebufferSize(const RenderOptions& options) const {
+    return { static_cast<uint32_t>(options.width * pixelRatio),
+             static_cast<uint32_t>(options.height * pixelRatio) };
+}
+
 void NodeMap::startRender(NodeMap::RenderOptions options) {
     map->setSize({ options.width, options.height });
 
-    const mbgl::Size fbSize{ static_cast<uint32_t>(options.width * pixelRatio),
-                             static_cast<uint32_t>(options.height * pixelRatio) };
+    const mbgl::Size fbSize = framebufferSize(options);
     if (!view || view->getSize() != fbSize) {
         view.reset();
         mbgl::BackendScope scope { backend };
@@ -402,8 +493,10 @@ void NodeMap::startRender(NodeMap::RenderOptions options) {
             error = std::move(eptr);
             uv_async_send(async);
         } else {
-            assert(!image.data);
-            image = view->readStillImage();
+            // Only schedule the read here, so that it can complete while the async is pending.
+            assert(!imageRead);
+            view->startStillImageRead();
+            imageRead = true;
             uv_async_send(async);
         }
     });
@@ -427,33 +520,130 @@ void NodeMap::renderFinished() {
     // of scope.
     Unref();
 
-    // Move the callback and image out of the way so that the callback can start a new render call.
+    // Move the callback and error out of the way so that the callback can start a new render call.
     auto cb = std::move(callback);
-    auto img = std::move(image);
+    auto err = std::move(error);
     assert(cb);
 
     // These have to be empty to be prepared for the next render call.
+    error = nullptr;
     assert(!callback);
-    assert(!image.data);
+    assert(!error);
+
+    // The image of the previous render of a batch has been in its pixel buffer while this render
+    // ran, so collecting it shouldn't have to wait for the GPU anymore. It's the oldest read of the
+    // view, so it has to be collected before this render's image.
+    const mbgl::optional<uint32_t> previousIndex = std::move(pendingImageIndex);
+    pendingImageIndex = {};
+    mbgl::PremultipliedImage previousImage;
+    std::exception_ptr previousErr;
+    if (previousIndex) {
+        previousImage = readImage(previousErr);
+    }
+
+    // When rendering a batch, start the next render before calling back into JavaScript, so that
+    // the map is already loading resources for it while the callback handles this image. The
+    // image of this render stays in its pixel buffer until the next render has finished, unless
+    // the next render needs a view of a different size.
+    mbgl::PremultipliedImage img;
+    std::unique_ptr<Nan::Callback> done;
+    const bool batched = bool(batchCallback);
+    const uint32_t index = batchIndex;
+    if (batched) {
+        batchIndex++;
+        if (batch.empty()) {
+            done = std::move(batchCallback);
+        } else {
+            const bool deferRead = imageRead && view->getSize() == framebufferSize(batch.front());
+            if (imageRead && !deferRead) {
+                img = readImage(err);
+            }
+            try {
+                startBatchRender(cb->GetFunction());
+                if (deferRead) {
+                    pendingImageIndex = index;
+                    imageRead = false;
+                }
+            } catch (...) {
+                batch.clear();
+                done = std::move(batchCallback);
+                batchError = std::current_exception();
+            }
+        }
+    }
 
-    if (error) {
+    if (imageRead) {
+        img = readImage(err);
+    }
+
+    if (previousIndex) {
+        callImageCallback(*cb, previousErr, std::move(previousImage), *previousIndex, batched);
+    }
+
+    if (!pendingImageIndex) {
+        callImageCallback(*cb, err, std::move(img), index, batched);
+    }
+
+    if (done) {
+        if (batchError) {
+            std::string errorMessage;
+
+            try {
+                std::rethrow_exception(batchError);
+            } catch (const std::exception& ex) {
+                errorMessage = ex.what();
+            }
+
+            batchError = nullptr;
+
+            v8::Local<v8::Value> argv[] = {
+                Nan::Error(errorMessage.c_str())
+            };
+            done->Call(1, argv);
+        } else {
+            v8::Local<v8::Value> argv[] = {
+                Nan::Null()
+            };
+            done->Call(1, argv);
+        }
+    }
+}
+
+mbgl::PremultipliedImage NodeMap::readImage(std::exception_ptr& err) {
+    // Mapping the pixel buffer waits for the read to finish.
+    mbgl::BackendScope backendScope { backend };
+    imageRead = false;
+    try {
+        return view->readStillImage();
+    } catch (...) {
+        if (!err) {
+            err = std::current_exception();
+        }
+        return {};
+    }
+}
+
+void NodeMap::callImageCallback(Nan::Callback& cb,
+                                std::exception_ptr err,
+                                mbgl::PremultipliedImage img,
+                                uint32_t index,
+                                bool batched) {
+    if (err) {
         std::string errorMessage;
 
         try {
-            std::rethrow_exception(error);
+            std::rethrow_exception(err);
         } catch (const std::exception& ex) {
             errorMessage = ex.what();
         }
 
         v8::Local<v8::Value> argv[] = {
-            Nan::Error(errorMessage.c_str())
+            Nan::Error(errorMessage.c_str()),
+            Nan::Undefined(),
+            Nan::New<v8::Uint32>(index)
         };
 
-        // This must be empty to be prepared for the next render call.
-        error = nullptr;
-        assert(!error);
-
-        cb->Call(1, argv);
+        cb.Call(batched ? 3 : 1, argv);
     } else if (img.data) {
         v8::Local<v8::Object> pixels = Nan::NewBuffer(
             reinterpret_cast<char *>(img.data.get()), img.bytes(),
@@ -467,14 +657,17 @@ void NodeMap::renderFinished() {
 
         v8::Local<v8::Value> argv[] = {
             Nan::Null(),
-            pixels
+            pixels,
+            Nan::New<v8::Uint32>(index)
         };
-        cb->Call(2, argv);
+        cb.Call(batched ? 3 : 2, argv);
     } else {
         v8::Local<v8::Value> argv[] = {
-            Nan::Error("Didn't get an image")
+            Nan::Error("Didn't get an image"),
+            Nan::Undefined(),
+            Nan::New<v8::Uint32>(index)
         };
-        cb->Call(1, argv);
+        cb.Call(batched ? 3 : 1, argv);
     }
 }
 
@@ -539,6 +732,14 @@ void NodeMap::cancel() {
     map->getStyle().loadJSON(style);
 
     error = std::make_exception_ptr(std::runtime_error("Canceled"));
+
+    // Canceling also aborts the remaining renders of a batch, and fails the batch even if the
+    // canceled render was its last one.
+    if (batchCallback) {
+        batch.clear();
+        batchError = error;
+    }
+
     renderFinished();
 }
 
@@ -6,7 +6,9 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/optional.hpp>
 
+#include <deque>
 #include <exception>
 
 #pragma GCC diagnostic push
@@ -26,7 +28,18 @@ public:
 class NodeMap : public Nan::ObjectWrap,
                 public mbgl::FileSource {
 public:
-    struct RenderOptions;
+    struct RenderOptions {
+        double zoom = 0;
+        double bearing = 0;
+        double pitch = 0;
+        double latitude = 0;
+        double longitude = 0;
+        unsigned int width = 512;
+        unsigned int height = 512;
+        std::vector<std::string> classes;
+        mbgl::MapDebugOptions debugOptions = mbgl::MapDebugOptions::NoDebug;
+    };
+
     class RenderWorker;
 
     NodeMap(v8::Local<v8::Object>);
@@ -40,6 +53,7 @@ public:
     static void Load(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void Loaded(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void Render(const Nan::FunctionCallbackInfo<v8::Value>&);
+    static void RenderBatch(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void Release(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void Cancel(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void AddSource(const Nan::FunctionCallbackInfo<v8::Value>&);
@@ -57,9 +71,17 @@ public:
     static void DumpDebugLogs(const Nan::FunctionCallbackInfo<v8::Value>&);
     static void QueryRenderedFeatures(const Nan::FunctionCallbackInfo<v8::Value>&);
 
+    mbgl::Size framebufferSize(const RenderOptions&) const;
     void startRender(RenderOptions options);
+    void startBatchRender(v8::Local<v8::Function> callback);
     void renderFinished();
 
+    // Collects the oldest pending read of the view. If that fails, `err` is set unless it already
+    // holds an error.
+    mbgl::PremultipliedImage readImage(std::exception_ptr& err);
+    static void callImageCallback(Nan::Callback&, std::exception_ptr, mbgl::PremultipliedImage,
+                                  uint32_t index, bool batched);
+
     void release();
     void cancel();
 
@@ -74,9 +96,23 @@ public:
     std::unique_ptr<mbgl::Map> map;
 
     std::exception_ptr error;
-    mbgl::PremultipliedImage image;
+    // Whether the view has a pending read of the rendered image, which renderFinished() collects.
+    bool imageRead = false;
     std::unique_ptr<Nan::Callback> callback;
 
+    // The renders of a renderBatch() call that haven't been started yet, the index of the next
+    // image to be delivered, and the callback to call once the batch is done or aborted with
+    // `batchError`. `callback` holds the per-image callback while a render of the batch is in
+    // progress.
+    std::deque<RenderOptions> batch;
+    uint32_t batchIndex = 0;
+    std::unique_ptr<Nan::Callback> batchCallback;
+    std::exception_ptr batchError;
+
+    // The index of the previous image of a batch, whose read is still pending in the view so that
+    // it overlaps with the current render. renderFinished() delivers it before the current image.
+    mbgl::optional<uint32_t> pendingImageIndex;
+
     // Async for delivering the notifications of render completion.
     uv_async_t *async;
 
@@ -0,0 +1,84 @@
+'use strict';
+
+var mockfs = require('./mockfs');
+var mbgl = require('../index');
+var test = require('tape');
+
+var params = {
+    numRenderings: 256,
+    width: 256,
+    height: 256,
+    ratio: 2
+};
+
+// Renders a square of neighbouring tiles, the way a tile server would.
+var specs = [];
+var side = Math.ceil(Math.sqrt(params.numRenderings));
+for (var i = 0; i < params.numRenderings; ++i) {
+    specs.push({
+        zoom: 14,
+        center: [-122.4194 + (i % side) * 0.02, 37.7749 + Math.floor(i / side) * 0.02],
+        width: params.width,
+        height: params.height
+    });
+}
+
+function createMap() {
+    var map = new mbgl.Map({
+        request: function(req, callback) {
+            setImmediate(function() {
+                callback(null, { data: mockfs.dataForRequest(req) });
+            });
+        },
+        ratio: params.ratio
+    });
+    map.load(mockfs.style_vector);
+    return map;
+}
+
+test('Benchmark', function(t) {
+    t.test('sequential render', function(t) {
+        var map = createMap();
+        var start = process.hrtime();
+        var index = 0;
+
+        function render() {
+            map.render(specs[index], function(err, pixels) {
+                t.error(err);
+
+                if (++index < specs.length) {
+                    return render();
+                }
+
+                var elapsed = process.hrtime(start);
+                var ms = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+                t.comment(specs.length + ' images in ' + ms.toFixed(0) + 'ms (' +
+                    (specs.length / ms * 1e3).toFixed(1) + ' images/s)');
+
+                map.release();
+                t.end();
+            });
+        }
+
+        render();
+    });
+
+    t.test('renderBatch', function(t) {
+        var map = createMap();
+        var start = process.hrtime();
+
+        map.renderBatch(specs, function(err, pixels, index) {
+            t.error(err);
+        }, function(err) {
+            t.error(err);
+
+            var elapsed = process.hrtime(start);
+            var ms = elapsed[0] * 1e3 + elapsed[1] / 1e6;
+            t.comment(specs.length + ' images in ' + ms.toFixed(0) + 'ms (' +
+                (specs.length / ms * 1e3).toFixed(1) + ' images/s)');
+
+            map.release();
+            t.end();
+        });
+    });
+});
@@ -106,6 +106,7 @@ test('Map', function(t) {
             'load',
             'loaded',
             'render',
+            'renderBatch',
             'release',
             'cancel',
             'addSource',
@@ -575,6 +576,153 @@ test('Map', function(t) {
         })
     });
 
+    t.test('.renderBatch', function(t) {
+        var options = {
+            request: function(req, callback) {
+                fs.readFile(path.join(__dirname, '..', req.url), function(err, data) {
+                    callback(err, { data: data });
+                });
+            },
+            ratio: 1
+        };
+
+        t.test('requires a non-empty array as the first parameter', function(t) {
+            var map = new mbgl.Map(options);
+
+            t.throws(function() {
+                map.renderBatch();
+            }, /First argument must be a non-empty array of options objects/);
+
+            t.throws(function() {
+                map.renderBatch({}, function() {}, function() {});
+            }, /First argument must be a non-empty array of options objects/);
+
+            t.throws(function() {
+                map.renderBatch([], function() {}, function() {});
+            }, /First argument must be a non-empty array of options objects/);
+
+            t.throws(function() {
+                map.renderBatch(['invalid'], function() {}, function() {});
+            }, /First argument must be a non-empty array of options objects/);
+
+            map.release();
+            t.end();
+        });
+
+        t.test('requires callbacks as the second and third parameters', function(t) {
+            var map = new mbgl.Map(options);
+
+            t.throws(function() {
+                map.renderBatch([{}]);
+            }, /Second argument must be a callback function/);
+
+            t.throws(function() {
+                map.renderBatch([{}], function() {});
+            }, /Third argument must be a callback function/);
+
+            map.release();
+            t.end();
+        });
+
+        t.test('requires a style to be set', function(t) {
+            var map = new mbgl.Map(options);
+
+            t.throws(function() {
+                map.renderBatch([{}], function() {}, function() {});
+            }, /Style is not loaded/);
+
+            map.release();
+            t.end();
+        });
+
+        t.test('returns images in order', function(t) {
+            var map = new mbgl.Map(options);
+            map.load(style);
+
+            var sizes = [128, 256, 256, 64];
+            var received = 0;
+
+            map.renderBatch(sizes.map(function(size) {
+                return { width: size, height: size };
+            }), function(err, pixels, index) {
+                t.error(err);
+                t.equal(index, received++);
+                t.ok(pixels instanceof Buffer);
+                t.equal(pixels.length, sizes[index] * sizes[index] * 4);
+            }, function(err) {
+                t.error(err);
+                t.equal(received, sizes.length);
+                map.release();
+                t.end();
+            });
+        });
+
+        t.test('throws if called while rendering', function(t) {
+            var map = new mbgl.Map(options);
+            map.load(style);
+
+            map.renderBatch([{}, {}], function(err, pixels, index) {
+                if (index === 0) {
+                    t.throws(function() {
+                        map.render({}, function() {});
+                    }, /Map is currently rendering a batch/);
+                }
+            }, function(err) {
+                t.error(err);
+                map.release();
+                t.end();
+            });
+
+            t.throws(function() {
+                map.render({}, function() {});
+            }, /Map is currently rendering a batch/);
+
+            t.throws(function() {
+                map.renderBatch([{}], function() {}, function() {});
+            }, /Map is currently rendering a batch/);
+        });
+
+        t.test('aborts the batch when canceled', function(t) {
+            var map = new mbgl.Map(options);
+            map.load(style);
+
+            var received = 0;
+
+            map.renderBatch([{}, {}, {}], function(err, pixels, index) {
+                received++;
+                t.equal(index, 0);
+                t.ok(err);
+                t.equal(err.message, 'Canceled');
+            }, function(err) {
+                t.ok(err);
+                t.equal(err.message, 'Canceled');
+                t.equal(received, 1);
+                map.release();
+                t.end();
+            });
+
+            map.cancel();
+        });
+
+        t.test('fails the batch when its last render is canceled', function(t) {
+            var map = new mbgl.Map(options);
+            map.load(style);
+
+            map.renderBatch([{}], function(err, pixels, index) {
+                t.equal(index, 0);
+                t.ok(err);
+                t.equal(err.message, 'Canceled');
+            }, function(err) {
+                t.ok(err);
+                t.equal(err.message, 'Canceled');
+                map.release();
+                t.end();
+            });
+
+            map.cancel();
+        });
+    });
+
     t.test('request callback', function (t) {
         t.test('returning an error', function(t) {
             var map = new mbgl.Map({
@@ -32,6 +32,7 @@ macro(mbgl_platform_core)
             PRIVATE platform/default/jpeg_reader.cpp
             PRIVATE platform/default/png_reader.cpp
             PRIVATE platform/default/webp_reader.cpp
+            PRIVATE platform/default/webp_writer.cpp
         )
 
         target_add_mason_package(mbgl-core PRIVATE libjpeg-turbo)
@@ -58,6 +59,12 @@ macro(mbgl_platform_test)
         PRIVATE platform/default/mbgl/gl/headless_display.hpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.cpp
         PRIVATE platform/default/mbgl/gl/offscreen_view.hpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.cpp
+        PRIVATE platform/default/mbgl/util/metatile_renderer.hpp
+        PRIVATE platform/default/mbgl/util/render_pool.cpp
+        PRIVATE platform/default/mbgl/util/render_pool.hpp
+        PRIVATE platform/default/mbgl/util/image_encoder.cpp
+        PRIVATE platform/default/mbgl/util/image_encoder.hpp
         PRIVATE platform/qt/test/headless_backend_qt.cpp
         PRIVATE platform/qt/test/main.cpp
         PRIVATE platform/qt/test/qmapboxgl.cpp
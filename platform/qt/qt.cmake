@@ -17,6 +17,8 @@ set(MBGL_QT_FILES
     PRIVATE platform/default/asset_file_source.cpp
     PRIVATE platform/default/default_file_source.cpp
     PRIVATE platform/default/local_file_source.cpp
+    PRIVATE platform/default/mapped_file.cpp
+    PRIVATE platform/default/mbtiles_file_source.cpp
     PRIVATE platform/default/online_file_source.cpp
 
     # Offline
@@ -20,11 +20,14 @@ std::string encodePNG(const PremultipliedImage& pre) {
 }
 
 #if !defined(QT_IMAGE_DECODERS)
-PremultipliedImage decodeJPEG(const uint8_t*, size_t);
-PremultipliedImage decodeWebP(const uint8_t*, size_t);
+template <ImageAlphaMode Mode> Image<Mode> decodeJPEG(const uint8_t*, size_t);
+template <ImageAlphaMode Mode> Image<Mode> decodeWebP(const uint8_t*, size_t);
 #endif
 
-PremultipliedImage decodeImage(const std::string& string) {
+namespace {
+
+template <ImageAlphaMode Mode>
+Image<Mode> decode(const std::string& string) {
     const uint8_t* data = reinterpret_cast<const uint8_t*>(string.data());
     const size_t size = string.size();
 
@@ -33,14 +36,14 @@ PremultipliedImage decodeImage(const std::string& string) {
         uint32_t riff_magic = (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
         uint32_t webp_magic = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
         if (riff_magic == 0x52494646 && webp_magic == 0x57454250) {
-            return decodeWebP(data, size);
+            return decodeWebP<Mode>(data, size);
         }
     }
 
     if (size >= 2) {
         uint16_t magic = ((data[0] << 8) | data[1]) & 0xffff;
         if (magic == 0xFFD8) {
-            return decodeJPEG(data, size);
+            return decodeJPEG<Mode>(data, size);
         }
     }
 #endif
@@ -48,7 +51,8 @@ PremultipliedImage decodeImage(const std::string& string) {
     QImage image =
         QImage::fromData(data, size)
         .rgbSwapped()
-        .convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        .convertToFormat(Mode == ImageAlphaMode::Premultiplied ? QImage::Format_ARGB32_Premultiplied
+                                                               : QImage::Format_ARGB32);
 
     if (image.isNull()) {
         throw std::runtime_error("Unsupported image type");
@@ -60,4 +64,15 @@ PremultipliedImage decodeImage(const std::string& string) {
     return { { static_cast<uint32_t>(image.width()), static_cast<uint32_t>(image.height()) },
              std::move(img) };
 }
+
+} // namespace
+
+PremultipliedImage decodeImage(const std::string& string) {
+    return decode<ImageAlphaMode::Premultiplied>(string);
+}
+
+UnassociatedImage decodeUnassociatedImage(const std::string& string) {
+    return decode<ImageAlphaMode::Unassociated>(string);
+}
+
 }
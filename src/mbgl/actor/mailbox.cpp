@@ -10,6 +10,14 @@ Mailbox::Mailbox(Scheduler& scheduler_)
     : scheduler(scheduler_) {
 }
 
+void Mailbox::setPriority(Priority priority_) {
+    priority = priority_;
+}
+
+Mailbox::Priority Mailbox::getPriority() const {
+    return priority;
+}
+
 void Mailbox::close() {
     // Block until neither receive() nor push() are in progress. Two mutexes are used because receive()
     // must not block send(). Of the two, the receiving mutex must be acquired first, because that is
@@ -57,16 +57,13 @@ std::vector<std::reference_wrapper<RenderTile>> RenderAnnotationSource::getRende
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
-RenderAnnotationSource::queryRenderedFeatures(const ScreenLineString& geometry,
-                                              const TransformState& transformState,
-                                              const RenderStyle& style,
-                                              const RenderedQueryOptions& options) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
+void RenderAnnotationSource::queryRenderedFeatures(RenderedFeatureQuery& query,
+                                                   const ScreenLineString& geometry,
+                                                   const TransformState& transformState) const {
+    tilePyramid.queryRenderedFeatures(query, geometry, transformState);
 }
 
-std::vector<Feature> RenderAnnotationSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderAnnotationSource::querySourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderAnnotationSource::onLowMemory() {
@@ -1,5 +1,4 @@
 #include <mbgl/geometry/feature_index.hpp>
-#include <mbgl/renderer/render_style.hpp>
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/text/collision_tile.hpp>
@@ -9,7 +8,6 @@
 #include <mbgl/map/query.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
-#include <mbgl/tile/geometry_tile.hpp>
 
 #include <mapbox/geometry/envelope.hpp>
 
@@ -27,11 +25,23 @@ void FeatureIndex::insert(const GeometryCollection& geometries,
                           const std::string& sourceLayerName,
                           const std::string& bucketName) {
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
-                    mapbox::geometry::envelope(ring));
+        insert(mapbox::geometry::envelope(ring), index, sourceLayerName, bucketName);
     }
 }
 
+void FeatureIndex::insert(const BBox& bbox,
+                          std::size_t index,
+                          const std::string& sourceLayerName,
+                          const std::string& bucketName) {
+    grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ }, bbox);
+}
+
+std::size_t FeatureIndex::byteSize() const {
+    // Each indexed ring is stored once as an element, and referenced from at least one grid cell.
+    return sortIndex * (sizeof(std::pair<IndexedSubfeature, BBox>) +
+                        sizeof(std::size_t));
+}
+
 static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
@@ -53,56 +63,24 @@ static bool topDownSymbols(const IndexedSubfeature& a, const IndexedSubfeature&
     return a.sortIndex < b.sortIndex;
 }
 
-static int16_t getAdditionalQueryRadius(const RenderedQueryOptions& queryOptions,
-                                        const RenderStyle& style,
-                                        const GeometryTile& tile,
-                                        const float pixelsToTileUnits) {
-
-    // Determine the additional radius needed factoring in property functions
-    float additionalRadius = 0;
-    auto getQueryRadius = [&](const RenderLayer& layer) {
-        auto bucket = tile.getBucket(*layer.baseImpl);
-        if (bucket) {
-            additionalRadius = std::max(additionalRadius, bucket->getQueryRadius(layer) * pixelsToTileUnits);
-        }
-    };
-
-    if (queryOptions.layerIDs) {
-        for (const auto& layerID : *queryOptions.layerIDs) {
-            const RenderLayer* layer = style.getRenderLayer(layerID);
-            if (layer) {
-                getQueryRadius(*layer);
-            }
-        }
-    } else {
-        for (const RenderLayer* layer : style.getRenderLayers()) {
-            getQueryRadius(*layer);
-        }
-    }
-
-    return std::min<int16_t>(util::EXTENT, additionalRadius);
-}
-
 void FeatureIndex::query(
         std::unordered_map<std::string, std::vector<Feature>>& result,
         const GeometryCoordinates& queryGeometry,
         const float bearing,
         const double tileSize,
         const double scale,
+        const int16_t additionalQueryRadius,
         const RenderedQueryOptions& queryOptions,
         const GeometryTileData& geometryTileData,
         const CanonicalTileID& tileID,
-        const RenderStyle& style,
-        const CollisionTile* collisionTile,
-        const GeometryTile& tile) const {
+        const std::unordered_map<std::string, const RenderLayer*>& layers,
+        const CollisionTile* collisionTile) const {
 
-    // Determine query radius
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
-    const int16_t additionalRadius = getAdditionalQueryRadius(queryOptions, style, tile, pixelsToTileUnits);
 
     // Query the grid index
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
-    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
+    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalQueryRadius, box.max + additionalQueryRadius });
 
 
     std::sort(features.begin(), features.end(), topDown);
@@ -113,7 +91,7 @@ void FeatureIndex::query(
         if (indexedFeature.sortIndex == previousSortIndex) continue;
         previousSortIndex = indexedFeature.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, indexedFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -124,7 +102,7 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, symbolFeature, queryGeometry, queryOptions, geometryTileData, tileID, layers, bearing, pixelsToTileUnits);
     }
 }
 
@@ -135,7 +113,7 @@ void FeatureIndex::addFeature(
     const RenderedQueryOptions& options,
     const GeometryTileData& geometryTileData,
     const CanonicalTileID& tileID,
-    const RenderStyle& style,
+    const std::unordered_map<std::string, const RenderLayer*>& layers,
     const float bearing,
     const float pixelsToTileUnits) const {
 
@@ -155,10 +133,14 @@ void FeatureIndex::addFeature(
             continue;
         }
 
-        auto renderLayer = style.getRenderLayer(layerID);
-        if (!renderLayer ||
-            (!renderLayer->is<RenderSymbolLayer>() &&
-             !renderLayer->queryIntersectsFeature(queryGeometry, *geometryTileFeature, tileID.z, bearing, pixelsToTileUnits))) {
+        auto it = layers.find(layerID);
+        if (it == layers.end()) {
+            continue;
+        }
+
+        const RenderLayer* renderLayer = it->second;
+        if (!renderLayer->is<RenderSymbolLayer>() &&
+            !renderLayer->queryIntersectsFeature(queryGeometry, *geometryTileFeature, tileID.z, bearing, pixelsToTileUnits)) {
             continue;
         }
 
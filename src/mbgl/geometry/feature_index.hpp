@@ -11,9 +11,8 @@
 
 namespace mbgl {
 
-class GeometryTile;
 class RenderedQueryOptions;
-class RenderStyle;
+class RenderLayer;
 
 class CollisionTile;
 class CanonicalTileID;
@@ -29,22 +28,27 @@ public:
 
 class FeatureIndex {
 public:
+    using BBox = GridIndex<IndexedSubfeature>::BBox;
+
     FeatureIndex();
 
     void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
+    void insert(const BBox&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
 
+    // Only reads the index, the tile data and the given layers, so that queries can be run on
+    // any thread. `additionalQueryRadius` widens the query to account for property functions.
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
             const float bearing,
             const double tileSize,
             const double scale,
+            const int16_t additionalQueryRadius,
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
-            const RenderStyle&,
-            const CollisionTile*,
-            const GeometryTile& tile) const;
+            const std::unordered_map<std::string, const RenderLayer*>& layers,
+            const CollisionTile*) const;
 
     static optional<GeometryCoordinates> translateQueryGeometry(
             const GeometryCoordinates& queryGeometry,
@@ -55,6 +59,9 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Returns an estimate of the memory held by the index.
+    std::size_t byteSize() const;
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -63,7 +70,7 @@ private:
             const RenderedQueryOptions& options,
             const GeometryTileData&,
             const CanonicalTileID&,
-            const RenderStyle&,
+            const std::unordered_map<std::string, const RenderLayer*>& layers,
             const float bearing,
             const float pixelsToTileUnits) const;
 
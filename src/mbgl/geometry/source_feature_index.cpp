@@ -0,0 +1,47 @@
+#include <mbgl/geometry/source_feature_index.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+std::vector<std::size_t> SourceFeatureIndex::query(const GeometryTileLayer& layer, const BBox& bbox) const {
+    std::vector<std::size_t> result = getGrid(layer)->query(bbox);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::shared_ptr<const GridIndex<std::size_t>> SourceFeatureIndex::getGrid(const GeometryTileLayer& layer) const {
+    const std::string name = layer.getName();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = grids.find(name);
+        if (it != grids.end()) {
+            return it->second;
+        }
+    }
+
+    // Build the grid without holding the lock, so that queries of other layers aren't blocked
+    // while the geometries are decoded.
+    auto grid = std::make_shared<GridIndex<std::size_t>>(util::EXTENT, 16, 0);
+    const std::size_t featureCount = layer.featureCount();
+    for (std::size_t i = 0; i < featureCount; i++) {
+        const GeometryCollection geometries = layer.getFeature(i)->getGeometries();
+        const BBox bbox = mapbox::geometry::envelope(geometries);
+        if (bbox.min.x > bbox.max.x) {
+            // The feature has no points.
+            continue;
+        }
+
+        std::size_t index = i;
+        grid->insert(std::move(index), bbox);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // Another thread may have indexed the layer in the meantime; use the first grid.
+    return grids.emplace(name, std::move(grid)).first->second;
+}
+
+} // namespace mbgl
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/grid_index.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+// Indexes the features of a tile's source layers by their bounding boxes, so that source feature
+// queries with bounds only decode the features that may intersect them. Unlike FeatureIndex, it
+// covers every feature of the source layers, not just the ones that are rendered.
+//
+// Each source layer is indexed the first time it's queried, which is safe to do from several
+// threads at once. The index must only be used with the tile data it was created for.
+class SourceFeatureIndex {
+public:
+    using BBox = GridIndex<std::size_t>::BBox;
+
+    // Returns the positions of the features of the layer whose bounding boxes intersect the
+    // box, in ascending order.
+    std::vector<std::size_t> query(const GeometryTileLayer&, const BBox&) const;
+
+private:
+    std::shared_ptr<const GridIndex<std::size_t>> getGrid(const GeometryTileLayer&) const;
+
+    mutable std::mutex mutex;
+    mutable std::unordered_map<std::string, std::shared_ptr<const GridIndex<std::size_t>>> grids;
+};
+
+} // namespace mbgl
@@ -7,8 +7,22 @@
 namespace mbgl {
 namespace gl {
 
+#ifndef NDEBUG
+static AttributeLocation maxVertexAttributes() {
+    static const AttributeLocation max = [] {
+        GLint value;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &value));
+        return AttributeLocation(value);
+    }();
+    return max;
+}
+#endif
+
 AttributeLocation bindAttributeLocation(ProgramID id, AttributeLocation location, const char* name) {
-    assert(location < 8);
+    // Programs use one location per active attribute. The symbol SDF program has nine of them when
+    // all of its paint properties are data-driven, one more than OpenGL ES 2 guarantees, so this
+    // checks against the limit of the actual implementation.
+    assert(location < maxVertexAttributes());
     MBGL_CHECK_ERROR(glBindAttribLocation(id, location, name));
     return location;
 }
@@ -4,10 +4,15 @@
 #include <mbgl/gl/debugging_extension.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
 #include <mbgl/gl/program_binary_extension.hpp>
+#include <mbgl/gl/pixel_buffer_extension.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
 #include <cstring>
 
 namespace mbgl {
@@ -38,6 +43,23 @@ static_assert(underlying_type(TextureFormat::Alpha) == GL_ALPHA, "OpenGL type mi
 
 static_assert(std::is_same<BinaryProgramFormat, GLenum>::value, "OpenGL type mismatch");
 
+namespace {
+
+// Returns the major version of the OpenGL or OpenGL ES context, or 0 if it can't be determined.
+int majorVersion() {
+    const auto* version = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)));
+    if (!version) {
+        return 0;
+    }
+    const char* prefix = "OpenGL ES ";
+    if (std::strncmp(version, prefix, std::strlen(prefix)) == 0) {
+        version += std::strlen(prefix);
+    }
+    return std::atoi(version);
+}
+
+} // namespace
+
 Context::Context() = default;
 
 Context::~Context() {
@@ -67,6 +89,12 @@ void Context::initializeExtensions(const std::function<gl::ProcAddress(const cha
 #if MBGL_HAS_BINARY_PROGRAMS
         programBinary = std::make_unique<extension::ProgramBinary>(fn);
 #endif
+        // OpenGL 3.0 and OpenGL ES 3.0 include pixel buffer objects and glMapBufferRange.
+        const bool pixelBufferCore = majorVersion() >= 3;
+        pixelBuffer = std::make_unique<extension::PixelBuffer>(fn, [&](const char* name) {
+            return pixelBufferCore ? getProcAddress(name) : nullptr;
+        });
+        timerQuery = std::make_unique<extension::TimerQuery>(fn);
 
         if (!supportsVertexArrays()) {
             Log::Warning(Event::OpenGL, "Not using Vertex Array Objects");
@@ -183,6 +211,17 @@ UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
     return result;
 }
 
+void Context::updateVertexBuffer(BufferID id, const void* data, std::size_t size) {
+    vertexBuffer = id;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+}
+
+void Context::updateIndexBuffer(BufferID id, const void* data, std::size_t size) {
+    vertexArrayObject = 0;
+    elementBuffer = id;
+    MBGL_CHECK_ERROR(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data));
+}
+
 UniqueTexture Context::createTexture() {
     if (pooledTextures.empty()) {
         pooledTextures.resize(TextureMax);
@@ -194,6 +233,15 @@ UniqueTexture Context::createTexture() {
     return UniqueTexture{ std::move(id), { this } };
 }
 
+uint32_t Context::maximumTextureSize() {
+    if (!maxTextureSize) {
+        GLint size = 0;
+        MBGL_CHECK_ERROR(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size));
+        maxTextureSize = static_cast<uint32_t>(size);
+    }
+    return *maxTextureSize;
+}
+
 bool Context::supportsVertexArrays() const {
     return vertexArray &&
            vertexArray->genVertexArrays &&
@@ -201,6 +249,23 @@ bool Context::supportsVertexArrays() const {
            vertexArray->deleteVertexArrays;
 }
 
+bool Context::supportsPixelBuffers() const {
+    return pixelBuffer &&
+           pixelBuffer->bindBuffer &&
+           (pixelBuffer->mapBufferRange || pixelBuffer->mapBuffer) &&
+           pixelBuffer->unmapBuffer;
+}
+
+bool Context::supportsTimerQueries() const {
+    return timerQuery &&
+           timerQuery->genQueries &&
+           timerQuery->deleteQueries &&
+           timerQuery->beginQuery &&
+           timerQuery->endQuery &&
+           timerQuery->getQueryObjectuiv &&
+           timerQuery->getQueryObjectui64v;
+}
+
 #if MBGL_HAS_BINARY_PROGRAMS
 bool Context::supportsProgramBinaries() const {
     return programBinary && programBinary->programBinary && programBinary->getProgramBinary;
@@ -266,18 +331,74 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
                                   GL_UNSIGNED_BYTE, data.get()));
 
     if (flip) {
-        auto tmp = std::make_unique<uint8_t[]>(stride);
         uint8_t* rgba = data.get();
         for (int i = 0, j = size.height - 1; i < j; i++, j--) {
-            std::memcpy(tmp.get(), rgba + i * stride, stride);
-            std::memcpy(rgba + i * stride, rgba + j * stride, stride);
-            std::memcpy(rgba + j * stride, tmp.get(), stride);
+            std::swap_ranges(rgba + i * stride, rgba + (i + 1) * stride, rgba + j * stride);
         }
     }
 
     return data;
 }
 
+UniqueBuffer Context::createPixelBuffer(std::size_t size) {
+    BufferID id = 0;
+    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+    UniqueBuffer result { std::move(id), { this } };
+    pixelPackBuffer = result;
+    MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ));
+    pixelPackBuffer = 0;
+    return result;
+}
+
+void Context::readFramebuffer(const Size size, const TextureFormat format, BufferID buffer) {
+    assert(supportsPixelBuffers());
+
+    pixelStorePack = { 1 };
+    pixelPackBuffer = buffer;
+
+    // With a pixel pack buffer bound, the last argument is an offset into the buffer, and the
+    // call returns without waiting for the pixels to be available.
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                  GL_UNSIGNED_BYTE, nullptr));
+
+    // Unbind the buffer so that synchronous reads write into client memory again.
+    pixelPackBuffer = 0;
+}
+
+void Context::readPixelBuffer(BufferID buffer,
+                              const Size size,
+                              const TextureFormat format,
+                              uint8_t* data,
+                              const bool flip) {
+    assert(supportsPixelBuffers());
+    const size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
+
+    pixelPackBuffer = buffer;
+
+    // Mapping the buffer waits for the read started by readFramebuffer() to complete.
+    const auto* pixels = reinterpret_cast<const uint8_t*>(
+        pixelBuffer->mapBufferRange
+            ? MBGL_CHECK_ERROR(pixelBuffer->mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, stride * size.height, GL_MAP_READ_BIT))
+            : MBGL_CHECK_ERROR(pixelBuffer->mapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)));
+
+    if (!pixels) {
+        // The framebuffer may have changed since the read was started, so it can't be read again.
+        pixelPackBuffer = 0;
+        throw std::runtime_error("Couldn't map pixel buffer");
+    }
+
+    if (flip) {
+        for (uint32_t i = 0, j = size.height - 1; i < size.height; i++, j--) {
+            std::memcpy(data + i * stride, pixels + j * stride, stride);
+        }
+    } else {
+        std::memcpy(data, pixels, stride * size.height);
+    }
+    MBGL_CHECK_ERROR(pixelBuffer->unmapBuffer(GL_PIXEL_PACK_BUFFER));
+
+    pixelPackBuffer = 0;
+}
+
 #if not MBGL_USE_GLES2
 void Context::drawPixels(const Size size, const void* data, TextureFormat format) {
     pixelStoreUnpack = { 1 };
@@ -417,6 +538,15 @@ void Context::updateTexture(
                                   data));
 }
 
+void Context::updateTexture(
+    TextureID id, mbgl::Point<uint32_t> offset, const Size size, const void* data, TextureFormat format, TextureUnit unit) {
+    activeTexture = unit;
+    texture[unit] = id;
+    pixelStoreUnpack = { 1 };
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, size.width, size.height,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, data));
+}
+
 void Context::bindTexture(Texture& obj,
                           TextureUnit unit,
                           TextureFilter filter,
@@ -502,6 +632,7 @@ void Context::setDirtyState() {
     }
     vertexBuffer.setDirty();
     elementBuffer.setDirty();
+    pixelPackBuffer.setDirty();
     vertexArrayObject.setDirty();
 }
 
@@ -623,6 +754,8 @@ void Context::performCleanup() {
                 vertexBuffer.setDirty();
             } else if (elementBuffer == id) {
                 elementBuffer.setDirty();
+            } else if (pixelPackBuffer == id) {
+                pixelPackBuffer.setDirty();
             }
         }
         MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
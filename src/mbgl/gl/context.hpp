@@ -15,8 +15,10 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/geometry.hpp>
 
 
+#include <cassert>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -36,6 +38,8 @@ namespace extension {
 class VertexArray;
 class Debugging;
 class ProgramBinary;
+class PixelBuffer;
+class TimerQuery;
 } // namespace extension
 
 class Context : private util::noncopyable {
@@ -54,6 +58,9 @@ public:
     void linkProgram(ProgramID);
     UniqueTexture createTexture();
 
+    // The largest width or height of a texture that the GPU supports.
+    uint32_t maximumTextureSize();
+
     bool supportsVertexArrays() const;
     UniqueVertexArray createVertexArray();
 
@@ -79,6 +86,19 @@ public:
         };
     }
 
+    // Replaces the contents of a buffer with the same number of vertices or indices, which keeps
+    // the vertex array objects that refer to it valid.
+    template <class Vertex, class DrawMode>
+    void updateVertexBuffer(VertexBuffer<Vertex, DrawMode>& buffer, VertexVector<Vertex, DrawMode>&& v) {
+        assert(v.vertexSize() == buffer.vertexCount);
+        updateVertexBuffer(buffer.buffer.get(), v.data(), v.byteSize());
+    }
+
+    template <class DrawMode>
+    void updateIndexBuffer(IndexBuffer<DrawMode>& buffer, IndexVector<DrawMode>&& v) {
+        updateIndexBuffer(buffer.buffer.get(), v.data(), v.byteSize());
+    }
+
     template <RenderbufferType type>
     Renderbuffer<type> createRenderbuffer(const Size size) {
         static_assert(type == RenderbufferType::RGBA ||
@@ -106,6 +126,18 @@ public:
         return { size, readFramebuffer(size, format, flip) };
     }
 
+    // Pixel buffer objects allow reading the framebuffer without stalling until rendering has
+    // finished: readFramebuffer() schedules a copy into the buffer and returns immediately, and
+    // readPixelBuffer() copies the pixels out once they're needed, ideally a frame later.
+    bool supportsPixelBuffers() const;
+    UniqueBuffer createPixelBuffer(std::size_t size);
+    void readFramebuffer(Size, TextureFormat, BufferID pixelBuffer);
+
+    // Copies the pixels of a previous readFramebuffer() call into `data`. When `flip` is set, the
+    // rows are reversed while copying so that the image is stored top-down. Throws if the buffer
+    // can't be mapped.
+    void readPixelBuffer(BufferID pixelBuffer, Size, TextureFormat, uint8_t* data, bool flip);
+
 #if not MBGL_USE_GLES2
     template <typename Image>
     void drawPixels(const Image& image) {
@@ -128,6 +160,14 @@ public:
         obj.size = image.size;
     }
 
+    // Replaces the region of an existing texture at `offset` with the contents of the image,
+    // leaving the rest of the texture untouched.
+    template <typename Image>
+    void updateTexture(Texture& obj, const Image& image, const mbgl::Point<uint32_t>& offset, TextureUnit unit = 0) {
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateTexture(obj.texture.get(), offset, image.size, image.data.get(), format, unit);
+    }
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -188,12 +228,19 @@ public:
         return vertexArray.get();
     }
 
+    bool supportsTimerQueries() const;
+    extension::TimerQuery* getTimerQueryExtension() const {
+        return timerQuery.get();
+    }
+
 private:
     std::unique_ptr<extension::Debugging> debugging;
     std::unique_ptr<extension::VertexArray> vertexArray;
 #if MBGL_HAS_BINARY_PROGRAMS
     std::unique_ptr<extension::ProgramBinary> programBinary;
 #endif
+    std::unique_ptr<extension::PixelBuffer> pixelBuffer;
+    std::unique_ptr<extension::TimerQuery> timerQuery;
 
 public:
     State<value::ActiveTexture> activeTexture;
@@ -205,6 +252,7 @@ public:
     State<value::Program> program;
     State<value::BindVertexBuffer> vertexBuffer;
     State<value::BindElementBuffer> elementBuffer;
+    State<value::BindPixelPackBuffer> pixelPackBuffer;
 
     State<value::PixelStorePack> pixelStorePack;
     State<value::PixelStoreUnpack> pixelStoreUnpack;
@@ -241,8 +289,11 @@ private:
 
     UniqueBuffer createVertexBuffer(const void* data, std::size_t size);
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
+    void updateVertexBuffer(BufferID, const void* data, std::size_t size);
+    void updateIndexBuffer(BufferID, const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
+    void updateTexture(TextureID, mbgl::Point<uint32_t> offset, Size size, const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
@@ -259,6 +310,7 @@ private:
     friend detail::RenderbufferDeleter;
 
     std::vector<TextureID> pooledTextures;
+    optional<uint32_t> maxTextureSize;
 
     std::vector<ProgramID> abandonedPrograms;
     std::vector<ShaderID> abandonedShaders;
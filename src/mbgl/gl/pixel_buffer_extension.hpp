@@ -0,0 +1,57 @@
+#pragma once
+
+#include <mbgl/gl/extension.hpp>
+#include <mbgl/gl/gl.hpp>
+
+#define GL_PIXEL_PACK_BUFFER                       0x88EB
+#define GL_PIXEL_PACK_BUFFER_BINDING               0x88ED
+#define GL_STREAM_READ                             0x88E1
+#define GL_READ_ONLY                               0x88B8
+#define GL_MAP_READ_BIT                            0x0001
+
+namespace mbgl {
+namespace gl {
+namespace extension {
+
+// Pixel buffer objects are core in OpenGL 2.1 and OpenGL ES 3.0, and available through extensions
+// on older versions. Reading from one requires mapping it into client memory: glMapBufferRange is
+// core in OpenGL 3.0 and OpenGL ES 3.0, and otherwise needs one of the map buffer range
+// extensions. On desktop OpenGL, glMapBuffer is used as a fallback.
+class PixelBuffer {
+public:
+    // `loadCore` returns the given function if the context's version includes pixel buffer objects
+    // and glMapBufferRange, and nullptr otherwise.
+    template <typename Fn, typename CoreFn>
+    PixelBuffer(const Fn& loadExtension, const CoreFn& loadCore)
+        : bindBuffer(
+              loadCore("glBindBuffer") ? loadCore("glBindBuffer") :
+              loadExtension({ { "GL_ARB_pixel_buffer_object", "glBindBuffer" },
+                              { "GL_EXT_pixel_buffer_object", "glBindBuffer" },
+                              { "GL_NV_pixel_buffer_object", "glBindBuffer" } })),
+          mapBufferRange(
+              loadCore("glMapBufferRange") ? loadCore("glMapBufferRange") :
+              loadExtension({ { "GL_ARB_map_buffer_range", "glMapBufferRange" },
+                              { "GL_EXT_map_buffer_range", "glMapBufferRangeEXT" } })),
+          mapBuffer(
+              loadExtension({ { "GL_ARB_pixel_buffer_object", "glMapBuffer" },
+                              { "GL_EXT_pixel_buffer_object", "glMapBuffer" } })),
+          unmapBuffer(
+              loadCore("glUnmapBuffer") ? loadCore("glUnmapBuffer") :
+              loadExtension({ { "GL_ARB_pixel_buffer_object", "glUnmapBuffer" },
+                              { "GL_EXT_pixel_buffer_object", "glUnmapBuffer" },
+                              { "GL_OES_mapbuffer", "glUnmapBufferOES" } })) {
+    }
+
+    // Only loaded if pixel buffer objects are supported, so that it can be used to detect them.
+    const ExtensionFunction<void(GLenum target, GLuint buffer)> bindBuffer;
+
+    const ExtensionFunction<void*(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)> mapBufferRange;
+
+    const ExtensionFunction<void*(GLenum target, GLenum access)> mapBuffer;
+
+    const ExtensionFunction<GLboolean(GLenum target)> unmapBuffer;
+};
+
+} // namespace extension
+} // namespace gl
+} // namespace mbgl
@@ -2,6 +2,7 @@
 #include <mbgl/gl/gl.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/gl/vertex_array_extension.hpp>
+#include <mbgl/gl/pixel_buffer_extension.hpp>
 
 namespace mbgl {
 namespace gl {
@@ -339,6 +340,18 @@ BindElementBuffer::Type BindElementBuffer::Get() {
     return binding;
 }
 
+const constexpr BindPixelPackBuffer::Type BindPixelPackBuffer::Default;
+
+void BindPixelPackBuffer::Set(const Type& value) {
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, value));
+}
+
+BindPixelPackBuffer::Type BindPixelPackBuffer::Get() {
+    GLint binding;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &binding));
+    return binding;
+}
+
 const constexpr BindVertexArray::Type BindVertexArray::Default;
 
 void BindVertexArray::Set(const Type& value, const Context& context) {
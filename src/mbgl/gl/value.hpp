@@ -232,6 +232,13 @@ struct BindElementBuffer {
     static Type Get();
 };
 
+struct BindPixelPackBuffer {
+    using Type = gl::BufferID;
+    static const constexpr Type Default = 0;
+    static void Set(const Type&);
+    static Type Get();
+};
+
 struct BindVertexArray {
     using Type = gl::VertexArrayID;
     static const constexpr Type Default = 0;
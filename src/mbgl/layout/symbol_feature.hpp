@@ -8,20 +8,32 @@
 
 namespace mbgl {
 
+// Copies what symbol layout needs from a feature, so that it doesn't keep the source layer, and
+// the features that it decoded, alive until the symbols are placed.
 class SymbolFeature : public GeometryTileFeature {
 public:
-    SymbolFeature(std::unique_ptr<GeometryTileFeature> feature_) :
-        feature(std::move(feature_)),
+    SymbolFeature(std::unique_ptr<GeometryTileFeature> feature) :
+        type(feature->getType()),
+        id(feature->getID()),
+        properties(feature->getProperties()),
         geometry(feature->getGeometries()) // we need a mutable copy of the geometry for mergeLines()
     {}
     
-    FeatureType getType() const override { return feature->getType(); }
-    optional<Value> getValue(const std::string& key) const override { return feature->getValue(key); };
-    std::unordered_map<std::string,Value> getProperties() const override { return feature->getProperties(); };
-    optional<FeatureIdentifier> getID() const override { return feature->getID(); };
+    FeatureType getType() const override { return type; }
+    optional<Value> getValue(const std::string& key) const override {
+        auto it = properties.find(key);
+        if (it == properties.end()) {
+            return {};
+        }
+        return it->second;
+    }
+    std::unordered_map<std::string,Value> getProperties() const override { return properties; };
+    optional<FeatureIdentifier> getID() const override { return id; };
     GeometryCollection getGeometries() const override { return geometry; };
 
-    std::unique_ptr<GeometryTileFeature> feature;
+    FeatureType type;
+    optional<FeatureIdentifier> id;
+    PropertyMap properties;
     GeometryCollection geometry;
     optional<std::u16string> text;
     optional<std::string> icon;
@@ -2,7 +2,7 @@
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/image_atlas.hpp>
@@ -26,6 +26,8 @@
 
 #include <mapbox/polylabel.hpp>
 
+#include <numeric>
+
 namespace mbgl {
 
 using namespace style;
@@ -40,10 +42,10 @@ static bool has(const style::SymbolLayoutProperties::PossiblyEvaluated& layout)
 
 SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            const std::vector<const RenderLayer*>& layers,
-                           std::unique_ptr<GeometryTileLayer> sourceLayer_,
+                           std::unique_ptr<GeometryTileLayer> sourceLayer,
                            ImageDependencies& imageDependencies,
                            GlyphDependencies& glyphDependencies)
-    : sourceLayer(std::move(sourceLayer_)),
+    : sourceLayerName(sourceLayer->getName()),
       bucketName(layers.at(0)->getID()),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
@@ -95,10 +97,11 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
     }
 
     // Determine glyph dependencies
+    const CompiledFilter filter(leader.filter);
     const size_t featureCount = sourceLayer->featureCount();
     for (size_t i = 0; i < featureCount; ++i) {
         auto feature = sourceLayer->getFeature(i);
-        if (!leader.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+        if (!filter(*feature))
             continue;
         
         SymbolFeature ft(std::move(feature));
@@ -268,9 +271,11 @@ void SymbolLayout::prepare(const GlyphMap& glyphMap, const GlyphPositions& glyph
         // if feature has icon, get sprite atlas position
         if (feature.icon) {
             auto image = imageMap.find(*feature.icon);
-            if (image != imageMap.end()) {
+            auto position = imagePositions.find(*feature.icon);
+            // Images that didn't fit into the symbol atlas have no position.
+            if (image != imageMap.end() && position != imagePositions.end()) {
                 shapedIcon = PositionedIcon::shapeIcon(
-                    imagePositions.at(*feature.icon),
+                    position->second,
                     layout.evaluate<IconOffset>(zoom, feature),
                     layout.evaluate<IconRotate>(zoom, feature) * util::DEG2RAD);
                 if (image->second->sdf) {
@@ -328,7 +333,7 @@ void SymbolLayout::addFeature(const std::size_t index,
                                                   ? SymbolPlacementType::Point
                                                   : layout.get<SymbolPlacement>();
     const float textRepeatDistance = symbolSpacing / 2;
-    IndexedSubfeature indexedFeature = { feature.index, sourceLayer->getName(), bucketName,
+    IndexedSubfeature indexedFeature = { feature.index, sourceLayerName, bucketName,
                                          symbolInstances.size() };
 
     auto addSymbolInstance = [&] (const GeometryCoordinates& line, Anchor& anchor) {
@@ -428,33 +433,157 @@ bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repe
     return false;
 }
 
-std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile) {
+// Each segment covers a fixed range of quads, so that their indices fit in 16 bits. The segments
+// are the same for every placement; only the order of the triangles within them can change.
+static constexpr std::size_t maxSegmentQuads = std::numeric_limits<uint16_t>::max() / 4;
+
+// The y stretch of a collision tile at util::PITCH_MAX, computed the same way as CollisionTile does.
+static float maxCollisionYStretch() {
+    static const float maxYStretch = std::pow(1.0f / std::cos(float(util::PITCH_MAX)), 1.3f);
+    return maxYStretch;
+}
+
+// The distance from the anchor of a collision box to its farthest corner in the collision tree,
+// at any angle and any pitch up to util::PITCH_MAX.
+static float collisionRadius(const CollisionBox& box) {
+    return std::hypot(util::max(std::abs(box.x1), std::abs(box.x2)),
+                      util::max(std::abs(box.y1), std::abs(box.y2)) * maxCollisionYStretch());
+}
+
+std::unique_ptr<SymbolBucket> SymbolLayout::createBucket() const {
     auto bucket = std::make_unique<SymbolBucket>(layout, layerPaintProperties, textSize, iconSize, zoom, sdfIcons, iconsNeedLinear);
 
-    // Calculate which labels can be shown and when they can be shown and
-    // create the bufers used for rendering.
+    // The vertices of every quad are added, whether it's shown or not. The placement buffers have
+    // a vertex for each of them, which hides the ones that aren't shown.
+    std::vector<std::size_t> firstGlyphs;
+    std::vector<std::size_t> firstIcons;
+    firstGlyphs.reserve(symbolInstances.size() + 1);
+    firstIcons.reserve(symbolInstances.size() + 1);
 
-    const SymbolPlacementType textPlacement = layout.get<TextRotationAlignment>() != AlignmentType::Map
-                                                  ? SymbolPlacementType::Point
-                                                  : layout.get<SymbolPlacement>();
-    const SymbolPlacementType iconPlacement = layout.get<IconRotationAlignment>() != AlignmentType::Map
-                                                  ? SymbolPlacementType::Point
-                                                  : layout.get<SymbolPlacement>();
+    for (const SymbolInstance& symbolInstance : symbolInstances) {
+        const auto& feature = features.at(symbolInstance.featureIndex);
+
+        firstGlyphs.push_back(bucket->text.vertices.vertexSize() / 4);
+        firstIcons.push_back(bucket->icon.vertices.vertexSize() / 4);
+
+        if (symbolInstance.hasText) {
+            for (const auto& symbol : symbolInstance.glyphQuads) {
+                addSymbol(bucket->text, *bucket->textSizeBinder, symbol, feature);
+            }
+        }
+
+        if (symbolInstance.hasIcon && symbolInstance.iconQuad) {
+            addSymbol(bucket->icon, *bucket->iconSizeBinder, *symbolInstance.iconQuad, feature);
+        }
+
+        for (auto& pair : bucket->paintPropertyBinders) {
+            pair.second.first.populateVertexVectors(feature, bucket->icon.vertices.vertexSize());
+            pair.second.second.populateVertexVectors(feature, bucket->text.vertices.vertexSize());
+        }
+    }
+
+    firstGlyphs.push_back(bucket->text.vertices.vertexSize() / 4);
+    firstIcons.push_back(bucket->icon.vertices.vertexSize() / 4);
+
+    // Until a placement sorts them, the symbols are drawn in the order of their instances.
+    std::vector<std::size_t> instanceOrder(symbolInstances.size());
+    std::iota(instanceOrder.begin(), instanceOrder.end(), 0);
+
+    addTriangles(bucket->text.triangles, firstGlyphs, instanceOrder);
+    addTriangles(bucket->icon.triangles, firstIcons, instanceOrder);
+    addSegments(bucket->text.segments, firstGlyphs.back());
+    addSegments(bucket->icon.segments, firstIcons.back());
+
+    return bucket;
+}
 
-    const bool mayOverlap = layout.get<TextAllowOverlap>() || layout.get<IconAllowOverlap>() ||
+void SymbolLayout::findInteractingSymbols(const std::vector<std::unique_ptr<SymbolLayout>>& symbolLayouts) {
+    // Two collision boxes can only overlap in the collision tree if the distance between their
+    // anchors is at most the sum of their radii. Rotating the map moves both boxes around their
+    // anchors, which doesn't change that distance.
+    using Instance = std::pair<std::size_t, std::size_t>;
+    using RadiusBox = std::tuple<Box, Point<float>, float, Instance>;
+
+    std::vector<RadiusBox> boxes;
+    for (std::size_t l = 0; l < symbolLayouts.size(); ++l) {
+        SymbolLayout& symbolLayout = *symbolLayouts[l];
+        const bool avoidEdges = symbolLayout.layout.get<SymbolAvoidEdges>();
+
+        symbolLayout.interacting.assign(symbolLayout.symbolInstances.size(), false);
+        symbolLayout.placedSymbols.clear();
+
+        for (std::size_t i = 0; i < symbolLayout.symbolInstances.size(); ++i) {
+            const SymbolInstance& symbolInstance = symbolLayout.symbolInstances[i];
+
+            auto addBoxes = [&](const CollisionFeature& feature) {
+                for (const CollisionBox& box : feature.boxes) {
+                    const float radius = collisionRadius(box);
+                    const Point<float>& anchor = box.anchor;
+
+                    boxes.emplace_back(Box { CollisionPoint { anchor.x - radius, anchor.y - radius },
+                                             CollisionPoint { anchor.x + radius, anchor.y + radius } },
+                                       anchor, radius, Instance { l, i });
+
+                    // The tile edges block boxes that come within a distance of their anchor
+                    // that grows as the scale goes down to CollisionTile::minScale.
+                    const float reach = radius * 2;
+                    if (avoidEdges &&
+                        (anchor.x - reach <= 0 || anchor.x + reach >= util::EXTENT ||
+                         anchor.y - reach <= 0 || anchor.y + reach >= util::EXTENT)) {
+                        symbolLayout.interacting[i] = true;
+                    }
+                }
+            };
+
+            if (symbolInstance.hasText) {
+                addBoxes(symbolInstance.textCollisionFeature);
+            }
+            if (symbolInstance.hasIcon) {
+                addBoxes(symbolInstance.iconCollisionFeature);
+            }
+        }
+    }
+
+    const bgi::rtree<RadiusBox, bgi::linear<16, 4>> tree(boxes.begin(), boxes.end());
+
+    for (const RadiusBox& box : boxes) {
+        const Instance& instance = std::get<3>(box);
+        for (auto it = tree.qbegin(bgi::intersects(std::get<0>(box))); it != tree.qend(); ++it) {
+            const Instance& other = std::get<3>(*it);
+            // The text and icon of an instance are both placed before either is inserted.
+            if (other == instance) {
+                continue;
+            }
+            if (util::dist<float>(std::get<1>(box), std::get<1>(*it)) <= std::get<2>(box) + std::get<2>(*it)) {
+                symbolLayouts[instance.first]->interacting[instance.second] = true;
+                symbolLayouts[other.first]->interacting[other.second] = true;
+            }
+        }
+    }
+}
+
+bool SymbolLayout::mayOverlap() const {
+    return layout.get<TextAllowOverlap>() || layout.get<IconAllowOverlap>() ||
         layout.get<TextIgnorePlacement>() || layout.get<IconIgnorePlacement>();
+}
 
-    const bool keepUpright = layout.get<TextKeepUpright>();
+void SymbolLayout::placeSymbols(CollisionTile& collisionTile) {
+    // Calculate which labels can be shown and when they can be shown.
+
+    placementOrder.resize(symbolInstances.size());
+    std::iota(placementOrder.begin(), placementOrder.end(), 0);
 
     // Sort symbols by their y position on the canvas so that they lower symbols
     // are drawn on top of higher symbols.
     // Don't sort symbols that won't overlap because it isn't necessary and
     // because it causes more labels to pop in and out when rotating.
-    if (mayOverlap) {
+    if (mayOverlap()) {
         const float sin = std::sin(collisionTile.config.angle);
         const float cos = std::cos(collisionTile.config.angle);
 
-        std::sort(symbolInstances.begin(), symbolInstances.end(), [sin, cos](SymbolInstance &a, SymbolInstance &b) {
+        std::sort(placementOrder.begin(), placementOrder.end(), [&](std::size_t i, std::size_t j) {
+            const SymbolInstance& a = symbolInstances[i];
+            const SymbolInstance& b = symbolInstances[j];
             const int32_t aRotated = sin * a.point.x + cos * a.point.y;
             const int32_t bRotated = sin * b.point.x + cos * b.point.y;
             return aRotated != bRotated ?
@@ -463,153 +592,231 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         });
     }
 
-    for (SymbolInstance &symbolInstance : symbolInstances) {
+    // The scales of symbols that don't interact with any other symbol or with the tile edges are
+    // the same at every angle and pitch, so the ones of the previous placement are kept.
+    const bool reusePlacement = placedSymbols.size() == symbolInstances.size() &&
+        interacting.size() == symbolInstances.size() &&
+        collisionTile.yStretch <= maxCollisionYStretch();
+
+    placedSymbols.resize(symbolInstances.size());
+
+    for (const std::size_t i : placementOrder) {
+        SymbolInstance& symbolInstance = symbolInstances[i];
 
         const bool hasText = symbolInstance.hasText;
         const bool hasIcon = symbolInstance.hasIcon;
 
-        const bool iconWithoutText = layout.get<TextOptional>() || !hasText;
-        const bool textWithoutIcon = layout.get<IconOptional>() || !hasIcon;
+        float glyphScale;
+        float iconScale;
 
-        // Calculate the scales at which the text and icon can be placed without collision.
+        if (reusePlacement && !interacting[i]) {
+            glyphScale = placedSymbols[i].textScale;
+            iconScale = placedSymbols[i].iconScale;
+        } else {
+            const bool iconWithoutText = layout.get<TextOptional>() || !hasText;
+            const bool textWithoutIcon = layout.get<IconOptional>() || !hasIcon;
 
-        float glyphScale = hasText ?
-            collisionTile.placeFeature(symbolInstance.textCollisionFeature,
-                    layout.get<TextAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
-            collisionTile.minScale;
-        float iconScale = hasIcon ?
-            collisionTile.placeFeature(symbolInstance.iconCollisionFeature,
-                    layout.get<IconAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
-            collisionTile.minScale;
+            // Calculate the scales at which the text and icon can be placed without collision.
 
+            glyphScale = hasText ?
+                collisionTile.placeFeature(symbolInstance.textCollisionFeature,
+                        layout.get<TextAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
+                collisionTile.minScale;
+            iconScale = hasIcon ?
+                collisionTile.placeFeature(symbolInstance.iconCollisionFeature,
+                        layout.get<IconAllowOverlap>(), layout.get<SymbolAvoidEdges>()) :
+                collisionTile.minScale;
 
-        // Combine the scales for icons and text.
 
-        if (!iconWithoutText && !textWithoutIcon) {
-            iconScale = glyphScale = util::max(iconScale, glyphScale);
-        } else if (!textWithoutIcon && glyphScale) {
-            glyphScale = util::max(iconScale, glyphScale);
-        } else if (!iconWithoutText && iconScale) {
-            iconScale = util::max(iconScale, glyphScale);
-        }
+            // Combine the scales for icons and text.
 
-        const auto& feature = features.at(symbolInstance.featureIndex);
+            if (!iconWithoutText && !textWithoutIcon) {
+                iconScale = glyphScale = util::max(iconScale, glyphScale);
+            } else if (!textWithoutIcon && glyphScale) {
+                glyphScale = util::max(iconScale, glyphScale);
+            } else if (!iconWithoutText && iconScale) {
+                iconScale = util::max(iconScale, glyphScale);
+            }
+        }
 
-        // Insert final placement into collision tree and add glyphs/icons to buffers
+        // Insert final placement into collision tree
 
         if (hasText) {
-            const float placementZoom = util::max(util::log2(glyphScale) + zoom, 0.0f);
             collisionTile.insertFeature(symbolInstance.textCollisionFeature, glyphScale, layout.get<TextIgnorePlacement>());
-            if (glyphScale < collisionTile.maxScale) {
-                for (const auto& symbol : symbolInstance.glyphQuads) {
-                    addSymbol(
-                        bucket->text, *bucket->textSizeBinder, symbol, feature, placementZoom,
-                        keepUpright, textPlacement, collisionTile.config.angle, symbolInstance.writingModes);
-                }
-            }
         }
 
         if (hasIcon) {
-            const float placementZoom = util::max(util::log2(iconScale) + zoom, 0.0f);
             collisionTile.insertFeature(symbolInstance.iconCollisionFeature, iconScale, layout.get<IconIgnorePlacement>());
-            if (iconScale < collisionTile.maxScale && symbolInstance.iconQuad) {
-                addSymbol(
-                    bucket->icon, *bucket->iconSizeBinder, *symbolInstance.iconQuad, feature, placementZoom,
-                    keepUpright, iconPlacement, collisionTile.config.angle, symbolInstance.writingModes);
+        }
+
+        placedSymbols[i] = { glyphScale, iconScale };
+    }
+}
+
+SymbolPlacementBuffers SymbolLayout::getPlacement(const CollisionTile& collisionTile, const bool debug) const {
+    assert(placedSymbols.size() == symbolInstances.size());
+
+    SymbolPlacementBuffers placement;
+
+    const SymbolPlacementType textPlacement = layout.get<TextRotationAlignment>() != AlignmentType::Map
+                                                  ? SymbolPlacementType::Point
+                                                  : layout.get<SymbolPlacement>();
+    const SymbolPlacementType iconPlacement = layout.get<IconRotationAlignment>() != AlignmentType::Map
+                                                  ? SymbolPlacementType::Point
+                                                  : layout.get<SymbolPlacement>();
+
+    const bool keepUpright = layout.get<TextKeepUpright>();
+
+    auto addQuad = [](gl::VertexVector<SymbolPlacementVertex>& vertices, const SymbolPlacementVertex& vertex) {
+        vertices.emplace_back(vertex);
+        vertices.emplace_back(vertex);
+        vertices.emplace_back(vertex);
+        vertices.emplace_back(vertex);
+    };
+
+    // The position of the first quad of each symbol instance, in the order of createBucket().
+    std::vector<std::size_t> firstGlyphs;
+    std::vector<std::size_t> firstIcons;
+    firstGlyphs.reserve(symbolInstances.size() + 1);
+    firstIcons.reserve(symbolInstances.size() + 1);
+
+    for (std::size_t i = 0; i < symbolInstances.size(); ++i) {
+        const SymbolInstance& symbolInstance = symbolInstances[i];
+        const PlacedSymbol& placedSymbol = placedSymbols[i];
+
+        firstGlyphs.push_back(placement.text.vertices.vertexSize() / 4);
+        firstIcons.push_back(placement.icon.vertices.vertexSize() / 4);
+
+        if (symbolInstance.hasText) {
+            const float placementZoom = util::max(util::log2(placedSymbol.textScale) + zoom, 0.0f);
+            const bool collisionFree = placedSymbol.textScale < collisionTile.maxScale;
+            for (const auto& symbol : symbolInstance.glyphQuads) {
+                addQuad(placement.text.vertices, placeSymbol(
+                    symbol, collisionFree, placementZoom,
+                    keepUpright, textPlacement, collisionTile.config.angle, symbolInstance.writingModes));
             }
         }
-        
-        for (auto& pair : bucket->paintPropertyBinders) {
-            pair.second.first.populateVertexVectors(feature, bucket->icon.vertices.vertexSize());
-            pair.second.second.populateVertexVectors(feature, bucket->text.vertices.vertexSize());
+
+        if (symbolInstance.hasIcon && symbolInstance.iconQuad) {
+            const float placementZoom = util::max(util::log2(placedSymbol.iconScale) + zoom, 0.0f);
+            const bool collisionFree = placedSymbol.iconScale < collisionTile.maxScale;
+            addQuad(placement.icon.vertices, placeSymbol(
+                *symbolInstance.iconQuad, collisionFree, placementZoom,
+                keepUpright, iconPlacement, collisionTile.config.angle, symbolInstance.writingModes));
         }
     }
 
-    if (collisionTile.config.debug) {
-        addToDebugBuffers(collisionTile, *bucket);
+    firstGlyphs.push_back(placement.text.vertices.vertexSize() / 4);
+    firstIcons.push_back(placement.icon.vertices.vertexSize() / 4);
+
+    // Symbols that may overlap are drawn in placement order, which depends on the angle. The
+    // triangles of the other layers stay in the order of createBucket().
+    if (mayOverlap()) {
+        addTriangles(placement.text.triangles, firstGlyphs, placementOrder);
+        addTriangles(placement.icon.triangles, firstIcons, placementOrder);
     }
 
-    return bucket;
+    if (debug) {
+        addToDebugBuffers(collisionTile, placement);
+    }
+
+    return placement;
 }
 
 template <typename Buffer>
 void SymbolLayout::addSymbol(Buffer& buffer,
                              SymbolSizeBinder& sizeBinder,
                              const SymbolQuad& symbol,
-                             const SymbolFeature& feature,
-                             const float placementZoom,
-                             const bool keepUpright,
-                             const style::SymbolPlacementType placement,
-                             const float placementAngle,
-                             const WritingModeType writingModes) {
-    constexpr const uint16_t vertexLength = 4;
-
+                             const SymbolFeature& feature) const {
     const auto &tl = symbol.tl;
     const auto &tr = symbol.tr;
     const auto &bl = symbol.bl;
     const auto &br = symbol.br;
     const auto &tex = symbol.tex;
-
-    float minZoom = util::max(zoom + util::log2(symbol.minScale), placementZoom);
-    float maxZoom = util::min(zoom + util::log2(symbol.maxScale), util::MAX_ZOOM_F);
     const auto &anchorPoint = symbol.anchorPoint;
 
+    const float minZoom = util::max(zoom + util::log2(symbol.minScale), 0.0f);
+    const float maxZoom = util::min(zoom + util::log2(symbol.maxScale), util::MAX_ZOOM_F);
+
+    // Encode angle of glyph
+    uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
+
+    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tl, tex.x, tex.y,
+                        minZoom, maxZoom, glyphAngle));
+    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y,
+                        minZoom, maxZoom, glyphAngle));
+    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h,
+                        minZoom, maxZoom, glyphAngle));
+    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h,
+                        minZoom, maxZoom, glyphAngle));
+
+    sizeBinder.populateVertexVector(feature);
+}
+
+SymbolPlacementVertex SymbolLayout::placeSymbol(const SymbolQuad& symbol,
+                                                const bool collisionFree,
+                                                const float placementZoom,
+                                                const bool keepUpright,
+                                                const style::SymbolPlacementType placement,
+                                                const float placementAngle,
+                                                const WritingModeType writingModes) const {
+    if (!collisionFree) {
+        return SymbolPlacementAttributes::hiddenVertex();
+    }
+
     // drop incorrectly oriented glyphs
     const float a = std::fmod(symbol.anchorAngle + placementAngle + M_PI, M_PI * 2);
     if (writingModes & WritingModeType::Vertical) {
         if (placement == style::SymbolPlacementType::Line && symbol.writingMode == WritingModeType::Vertical) {
             if (keepUpright && placement == style::SymbolPlacementType::Line && (a <= (M_PI * 5 / 4) || a > (M_PI * 7 / 4)))
-                return;
+                return SymbolPlacementAttributes::hiddenVertex();
         } else if (keepUpright && placement == style::SymbolPlacementType::Line && (a <= (M_PI * 3 / 4) || a > (M_PI * 5 / 4)))
-            return;
+            return SymbolPlacementAttributes::hiddenVertex();
     } else if (keepUpright && placement == style::SymbolPlacementType::Line &&
         (a <= M_PI / 2 || a > M_PI * 3 / 2)) {
-        return;
-    }
-
-    if (maxZoom <= minZoom)
-        return;
-
-    // Lower min zoom so that while fading out the label
-    // it can be shown outside of collision-free zoom levels
-    if (minZoom == placementZoom) {
-        minZoom = 0;
+        return SymbolPlacementAttributes::hiddenVertex();
     }
 
-    if (buffer.segments.empty() || buffer.segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
-        buffer.segments.emplace_back(buffer.vertices.vertexSize(), buffer.triangles.indexSize());
+    const float minZoom = util::max(zoom + util::log2(symbol.minScale), placementZoom);
+    const float maxZoom = util::min(zoom + util::log2(symbol.maxScale), util::MAX_ZOOM_F);
+    if (maxZoom <= minZoom) {
+        return SymbolPlacementAttributes::hiddenVertex();
     }
 
-    // We're generating triangle fans, so we always start with the first
-    // coordinate in this polygon.
-    auto& segment = buffer.segments.back();
-    assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-    uint16_t index = segment.vertexLength;
+    return SymbolPlacementAttributes::vertex(placementZoom);
+}
 
-    // Encode angle of glyph
-    uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
+void SymbolLayout::addTriangles(gl::IndexVector<gl::Triangles>& triangles,
+                                const std::vector<std::size_t>& firstQuads,
+                                const std::vector<std::size_t>& order) {
+    const std::size_t quadCount = firstQuads.back();
+    std::vector<std::vector<uint16_t>> segmentQuads((quadCount + maxSegmentQuads - 1) / maxSegmentQuads);
 
-    // coordinates (2 triangles)
-    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tl, tex.x, tex.y,
-                        minZoom, maxZoom, placementZoom, glyphAngle));
-    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y,
-                        minZoom, maxZoom, placementZoom, glyphAngle));
-    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h,
-                        minZoom, maxZoom, placementZoom, glyphAngle));
-    buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h,
-                        minZoom, maxZoom, placementZoom, glyphAngle));
-    
-    sizeBinder.populateVertexVector(feature);
+    for (const std::size_t i : order) {
+        for (std::size_t quad = firstQuads[i]; quad < firstQuads[i + 1]; ++quad) {
+            segmentQuads[quad / maxSegmentQuads].push_back(quad % maxSegmentQuads);
+        }
+    }
 
-    // add the two triangles, referencing the four coordinates we just inserted.
-    buffer.triangles.emplace_back(index + 0, index + 1, index + 2);
-    buffer.triangles.emplace_back(index + 1, index + 2, index + 3);
+    for (const auto& quads : segmentQuads) {
+        // add the two triangles of each quad
+        for (const uint16_t quad : quads) {
+            const uint16_t index = quad * 4;
+            triangles.emplace_back(index + 0, index + 1, index + 2);
+            triangles.emplace_back(index + 1, index + 2, index + 3);
+        }
+    }
+}
 
-    segment.vertexLength += vertexLength;
-    segment.indexLength += 6;
+template <class Attributes>
+void SymbolLayout::addSegments(gl::SegmentVector<Attributes>& segments, const std::size_t quadCount) {
+    for (std::size_t firstQuad = 0; firstQuad < quadCount; firstQuad += maxSegmentQuads) {
+        const std::size_t segmentQuadCount = util::min(maxSegmentQuads, quadCount - firstQuad);
+        segments.emplace_back(firstQuad * 4, firstQuad * 6, segmentQuadCount * 4, segmentQuadCount * 6);
+    }
 }
 
-void SymbolLayout::addToDebugBuffers(CollisionTile& collisionTile, SymbolBucket& bucket) {
+void SymbolLayout::addToDebugBuffers(const CollisionTile& collisionTile, SymbolPlacementBuffers& placement) const {
 
     if (!hasSymbolInstances()) {
         return;
@@ -617,7 +824,7 @@ void SymbolLayout::addToDebugBuffers(CollisionTile& collisionTile, SymbolBucket&
 
     const float yStretch = collisionTile.yStretch;
 
-    auto& collisionBox = bucket.collisionBox;
+    auto& collisionBox = placement.collisionBox;
 
     for (const SymbolInstance &symbolInstance : symbolInstances) {
         auto populateCollisionBox = [&](const auto& feature) {
@@ -7,6 +7,8 @@
 #include <mbgl/text/bidi.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/programs/symbol_program.hpp>
+#include <mbgl/gl/index_buffer.hpp>
+#include <mbgl/gl/segment.hpp>
 
 #include <memory>
 #include <map>
@@ -18,6 +20,7 @@ namespace mbgl {
 class BucketParameters;
 class CollisionTile;
 class SymbolBucket;
+class SymbolPlacementBuffers;
 class Anchor;
 class RenderLayer;
 
@@ -36,7 +39,23 @@ public:
     void prepare(const GlyphMap&, const GlyphPositions&,
                  const ImageMap&, const ImagePositions&);
 
-    std::unique_ptr<SymbolBucket> place(CollisionTile&);
+    // Creates a bucket with the layout vertices, feature data, triangles and segments of every
+    // glyph and icon. They don't depend on the placement, so they are created once per layout.
+    std::unique_ptr<SymbolBucket> createBucket() const;
+
+    // Marks the symbol instances of the layouts of a tile that may collide with a symbol of any of
+    // them, or with the tile edges, at some angle and pitch. The others keep the scales of their
+    // previous placement when they are placed again.
+    static void findInteractingSymbols(const std::vector<std::unique_ptr<SymbolLayout>>&);
+
+    // Places all of the symbols in the collision tile, and keeps the scales from which they can be
+    // shown. Only symbols that interact with others go through collision detection again.
+    void placeSymbols(CollisionTile&);
+
+    // Returns the placement buffers of the bucket for the last placement in the collision tile:
+    // one placement vertex for every glyph and icon vertex, and the triangles in drawing order if
+    // that depends on the placement.
+    SymbolPlacementBuffers getPlacement(const CollisionTile&, bool debug) const;
 
     bool hasSymbolInstances() const;
 
@@ -53,23 +72,38 @@ private:
     bool anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor&);
     std::map<std::u16string, std::vector<Anchor>> compareText;
 
-    void addToDebugBuffers(CollisionTile&, SymbolBucket&);
+    void addToDebugBuffers(const CollisionTile&, SymbolPlacementBuffers&) const;
 
-    // Adds placed items to the buffer.
+    // Whether the symbols of the layout may be drawn over each other, in which case they are
+    // drawn in placement order.
+    bool mayOverlap() const;
+
+    // Adds the layout vertices of a quad to the buffer.
     template <typename Buffer>
-    void addSymbol(Buffer&,
-                   SymbolSizeBinder& sizeBinder,
-                   const SymbolQuad&,
-                   const SymbolFeature& feature,
-                   float scale,
-                   const bool keepUpright,
-                   const style::SymbolPlacementType,
-                   const float placementAngle,
-                   WritingModeType writingModes);
-
-    // Stores the layer so that we can hold on to GeometryTileFeature instances in SymbolFeature,
-    // which may reference data from this object.
-    const std::unique_ptr<GeometryTileLayer> sourceLayer;
+    void addSymbol(Buffer&, SymbolSizeBinder&, const SymbolQuad&, const SymbolFeature&) const;
+
+    // Returns the placement vertex of a quad. Quads of symbols that couldn't be placed without
+    // collisions are hidden.
+    SymbolPlacementVertex placeSymbol(const SymbolQuad&,
+                                      const bool collisionFree,
+                                      float placementZoom,
+                                      const bool keepUpright,
+                                      const style::SymbolPlacementType,
+                                      const float placementAngle,
+                                      WritingModeType writingModes) const;
+
+    // Adds the triangles of every quad, with the quads of each symbol instance in the given order
+    // within each segment.
+    static void addTriangles(gl::IndexVector<gl::Triangles>&,
+                             const std::vector<std::size_t>& firstQuads,
+                             const std::vector<std::size_t>& order);
+
+    // Adds the segments for the given number of quads.
+    template <class Attributes>
+    static void addSegments(gl::SegmentVector<Attributes>&, std::size_t quadCount);
+
+    // The source layer itself is released once its features have been copied into SymbolFeatures.
+    const std::string sourceLayerName;
     const std::string bucketName;
     const float overscaling;
     const float zoom;
@@ -90,6 +124,19 @@ private:
     std::vector<SymbolInstance> symbolInstances;
     std::vector<SymbolFeature> features;
 
+    // The order in which the symbol instances were last placed, which is also their drawing order,
+    // and the scales from which their text and icon can be shown.
+    struct PlacedSymbol {
+        float textScale;
+        float iconScale;
+    };
+    std::vector<std::size_t> placementOrder;
+    std::vector<PlacedSymbol> placedSymbols;
+
+    // Whether each symbol instance may interact with another one or the tile edges, as found by
+    // findInteractingSymbols().
+    std::vector<bool> interacting;
+
     BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
 };
 
@@ -10,9 +10,11 @@
 #include <mbgl/style/observer.hpp>
 #include <mbgl/renderer/update_parameters.hpp>
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_style.hpp>
 #include <mbgl/renderer/render_style_observer.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/math.hpp>
@@ -21,6 +23,8 @@
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/math/log2.hpp>
 #include <utility>
@@ -69,6 +73,8 @@ public:
     void render(View&);
     void renderStill();
 
+    void queryRenderedFeatures(const ScreenLineString&, const RenderedQueryOptions&, FeatureQueryCallback);
+
     Map& map;
     MapObserver& observer;
     Backend& backend;
@@ -89,17 +95,23 @@ public:
 
     AnnotationManager annotationManager;
     std::unique_ptr<Painter> painter;
+    std::unique_ptr<FrameProfiler> profiler;
     std::unique_ptr<Style> style;
     std::unique_ptr<RenderStyle> renderStyle;
 
     bool cameraMutated = false;
 
     uint8_t prefetchZoomDelta = util::DEFAULT_PREFETCH_ZOOM_DELTA;
+    uint64_t tileCacheSize = util::DEFAULT_TILE_CACHE_SIZE;
+    bool parallelTileLayout = false;
 
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
     std::unique_ptr<StillImageRequest> stillImageRequest;
+
+    Actor<FeatureQueryRequestor> queryRequestor;
+    Actor<FeatureQueryWorker> queryWorker;
 };
 
 Map::Map(Backend& backend,
@@ -153,7 +165,11 @@ Map::Impl::Impl(Map& map_,
           } else {
               renderStill();
           }
-      }) {
+      }),
+      queryRequestor(*util::RunLoop::Get()),
+      queryWorker(scheduler, queryRequestor.self()) {
+    // Queries are issued in response to user input, so don't queue them behind tile parsing.
+    queryWorker.setPriority(Mailbox::Priority::High);
     style = std::make_unique<Style>(scheduler, fileSource, pixelRatio);
     style->impl->setObserver(this);
 }
@@ -165,6 +181,7 @@ Map::~Map() {
     // cleaned up by context.reset();
     impl->renderStyle.reset();
     impl->painter.reset();
+    impl->profiler.reset();
 }
 
 void Map::renderStill(View& view, StillImageCallback callback) {
@@ -255,7 +272,9 @@ void Map::Impl::render(View& view) {
         scheduler,
         fileSource,
         annotationManager,
-        prefetchZoomDelta
+        prefetchZoomDelta,
+        tileCacheSize,
+        parallelTileLayout
     });
 
     bool loaded = style->impl->isLoaded() && renderStyle->isLoaded();
@@ -275,10 +294,19 @@ void Map::Impl::render(View& view) {
 
         backend.updateAssumedState();
 
+        painter->profiler = profiler.get();
+        if (profiler) {
+            profiler->beginFrame(context);
+        }
+
         painter->render(*renderStyle,
                         frameData,
                         view);
 
+        if (profiler) {
+            profiler->endFrame();
+        }
+
         painter->cleanup();
 
         observer.onDidFinishRenderingFrame(loaded
@@ -310,10 +338,19 @@ void Map::Impl::render(View& view) {
 
         backend.updateAssumedState();
 
+        painter->profiler = profiler.get();
+        if (profiler) {
+            profiler->beginFrame(context);
+        }
+
         painter->render(*renderStyle,
                         frameData,
                         view);
 
+        if (profiler) {
+            profiler->endFrame();
+        }
+
         auto request = std::move(stillImageRequest);
         request->callback(nullptr);
 
@@ -742,30 +779,34 @@ void Map::removeAnnotation(AnnotationID annotation) {
 
 #pragma mark - Feature query api
 
+static ScreenLineString toLineString(const ScreenBox& box) {
+    return {
+        box.min,
+        { box.max.x, box.min.y },
+        box.max,
+        { box.min.x, box.max.y },
+        box.min
+    };
+}
+
 std::vector<Feature> Map::queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options) {
     if (!impl->renderStyle) return {};
 
-    return impl->renderStyle->queryRenderedFeatures(
+    return impl->renderStyle->createRenderedFeatureQuery(
         { point },
         impl->transform.getState(),
         options
-    );
+    ).run();
 }
 
 std::vector<Feature> Map::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options) {
     if (!impl->renderStyle) return {};
 
-    return impl->renderStyle->queryRenderedFeatures(
-        {
-            box.min,
-            { box.max.x, box.min.y },
-            box.max,
-            { box.min.x, box.max.y },
-            box.min
-        },
+    return impl->renderStyle->createRenderedFeatureQuery(
+        toLineString(box),
         impl->transform.getState(),
         options
-    );
+    ).run();
 }
 
 std::vector<Feature> Map::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options) {
@@ -774,7 +815,42 @@ std::vector<Feature> Map::querySourceFeatures(const std::string& sourceID, const
     const RenderSource* source = impl->renderStyle->getRenderSource(sourceID);
     if (!source) return {};
 
-    return source->querySourceFeatures(options);
+    SourceFeatureQuery query(options);
+    source->querySourceFeatures(query);
+    return query.run();
+}
+
+void Map::queryRenderedFeatures(const ScreenCoordinate& point, const RenderedQueryOptions& options, FeatureQueryCallback callback) {
+    impl->queryRenderedFeatures({ point }, options, std::move(callback));
+}
+
+void Map::queryRenderedFeatures(const ScreenBox& box, const RenderedQueryOptions& options, FeatureQueryCallback callback) {
+    impl->queryRenderedFeatures(toLineString(box), options, std::move(callback));
+}
+
+void Map::Impl::queryRenderedFeatures(const ScreenLineString& geometry, const RenderedQueryOptions& options, FeatureQueryCallback callback) {
+    if (!renderStyle) {
+        queryRequestor.invoke(&FeatureQueryRequestor::onFeatures, std::vector<Feature>(), std::move(callback));
+        return;
+    }
+
+    auto query = renderStyle->createRenderedFeatureQuery(geometry, transform.getState(), options);
+    query.detach();
+
+    queryWorker.invoke(&FeatureQueryWorker::queryRenderedFeatures, std::move(query), std::move(callback));
+}
+
+void Map::querySourceFeatures(const std::string& sourceID, const SourceQueryOptions& options, FeatureQueryCallback callback) {
+    const RenderSource* source = impl->renderStyle ? impl->renderStyle->getRenderSource(sourceID) : nullptr;
+    if (!source) {
+        impl->queryRequestor.invoke(&FeatureQueryRequestor::onFeatures, std::vector<Feature>(), std::move(callback));
+        return;
+    }
+
+    SourceFeatureQuery query(options);
+    source->querySourceFeatures(query);
+
+    impl->queryWorker.invoke(&FeatureQueryWorker::querySourceFeatures, std::move(query), std::move(callback));
 }
 
 AnnotationIDs Map::queryPointAnnotations(const ScreenBox& box) {
@@ -841,6 +917,41 @@ uint8_t Map::getPrefetchZoomDelta() const {
     return impl->prefetchZoomDelta;
 }
 
+void Map::setParallelTileLayout(bool enabled) {
+    impl->parallelTileLayout = enabled;
+}
+
+bool Map::getParallelTileLayout() const {
+    return impl->parallelTileLayout;
+}
+
+void Map::setTileCacheSize(uint64_t size) {
+    impl->tileCacheSize = size;
+    impl->onUpdate(Update::Repaint);
+}
+
+uint64_t Map::getTileCacheSize() const {
+    return impl->tileCacheSize;
+}
+
+void Map::setRenderProfiling(uint32_t frames) {
+    if (frames == getRenderProfiling()) {
+        return;
+    }
+
+    // Replacing the profiler deletes the timer queries of the previous one.
+    BackendScope guard(impl->backend);
+    impl->profiler = frames ? std::make_unique<FrameProfiler>(frames) : nullptr;
+}
+
+uint32_t Map::getRenderProfiling() const {
+    return impl->profiler ? impl->profiler->getFrameCount() : 0;
+}
+
+RenderProfile Map::getRenderProfile() const {
+    return impl->profiler ? impl->profiler->getProfile() : RenderProfile();
+}
+
 void Map::onLowMemory() {
     if (impl->painter) {
         BackendScope guard(impl->backend);
@@ -0,0 +1,58 @@
+#include <mbgl/map/render_profile.hpp>
+
+#include <rapidjson/writer.h>
+#include <rapidjson/stringbuffer.h>
+
+namespace mbgl {
+
+namespace {
+
+template <class Writer>
+void writeTiming(Writer& writer, const RenderProfile::Timing& timing) {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    writer.StartObject();
+    writer.Key("name");
+    writer.String(timing.name);
+    writer.Key("frames");
+    writer.Uint(timing.frames);
+    writer.Key("cpu");
+    writer.Double(std::chrono::duration_cast<Milliseconds>(timing.cpuTime).count());
+    writer.Key("gpu");
+    if (timing.gpuTime) {
+        writer.Double(std::chrono::duration_cast<Milliseconds>(*timing.gpuTime).count());
+    } else {
+        writer.Null();
+    }
+    writer.EndObject();
+}
+
+} // namespace
+
+std::string RenderProfile::toJSON() const {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+    writer.StartObject();
+    writer.Key("frames");
+    writer.Uint(frames);
+    writer.Key("total");
+    writeTiming(writer, total);
+    writer.Key("passes");
+    writer.StartArray();
+    for (const auto& pass : passes) {
+        writeTiming(writer, pass);
+    }
+    writer.EndArray();
+    writer.Key("layers");
+    writer.StartArray();
+    for (const auto& layer : layers) {
+        writeTiming(writer, layer);
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    return s.GetString();
+}
+
+} // namespace mbgl
@@ -54,7 +54,6 @@ struct SymbolLayoutAttributes : gl::Attributes<
                          uint16_t ty,
                          float minzoom,
                          float maxzoom,
-                         float labelminzoom,
                          uint8_t labelangle) {
         return Vertex {
             // combining pos and offset to reduce number of vertex attributes passed to shader (8 max for some devices)
@@ -67,18 +66,40 @@ struct SymbolLayoutAttributes : gl::Attributes<
             {{
                 tx,
                 ty,
+                static_cast<uint16_t>(labelangle),
                 mbgl::attributes::packUint8Pair(
-                   static_cast<uint8_t>(labelminzoom * 10), // 1/10 zoom levels: z16 == 160
-                   static_cast<uint8_t>(labelangle)
-                ),
-                mbgl::attributes::packUint8Pair(
-                   static_cast<uint8_t>(minzoom * 10),
+                   static_cast<uint8_t>(minzoom * 10), // 1/10 zoom levels: z16 == 160
                    static_cast<uint8_t>(::fmin(maxzoom, 25) * 10)
                 )
             }}
         };
     }
 };
+
+// The part of a symbol vertex that depends on the placement: the zoom level from which its symbol
+// is shown, in 1/10 zoom levels, or `hidden`. It's one byte in a separate buffer, so that placing
+// the symbols again only replaces this buffer.
+struct SymbolPlacementAttributes : gl::Attributes<
+    attributes::a_labelminzoom>
+{
+    static constexpr uint8_t hidden = 255;
+
+    static Vertex vertex(float labelminzoom) {
+        return Vertex {
+            {{
+                static_cast<uint8_t>(::fmin(labelminzoom * 10, hidden - 1))
+            }}
+        };
+    }
+
+    static Vertex hiddenVertex() {
+        return Vertex {
+            {{
+                hidden
+            }}
+        };
+    }
+};
     
 class SymbolSizeAttributes : public gl::Attributes<attributes::a_size> {
 public:
@@ -113,19 +134,19 @@ public:
 
 // Return the smallest range of stops that covers the interval [lowerZoom, upperZoom]
 template <class Stops>
-Range<float> getCoveringStops(Stops s, float lowerZoom, float upperZoom) {
-    assert(!s.stops.empty());
-    auto minIt = s.stops.lower_bound(lowerZoom);
-    auto maxIt = s.stops.lower_bound(upperZoom);
+Range<float> getCoveringStops(const Stops& stops, float lowerZoom, float upperZoom) {
+    assert(!stops.empty());
+    auto minIt = stops.lower_bound(lowerZoom);
+    auto maxIt = stops.lower_bound(upperZoom);
     
     // lower_bound yields first element >= lowerZoom, but we want the *last*
     // element <= lowerZoom, so if we found a stop > lowerZoom, back up by one.
-    if (minIt != s.stops.begin() && minIt != s.stops.end() && minIt->first > lowerZoom) {
+    if (minIt != stops.begin() && minIt != stops.end() && minIt->first > lowerZoom) {
         minIt--;
     }
     return Range<float> {
-        minIt == s.stops.end() ? s.stops.rbegin()->first : minIt->first,
-        maxIt == s.stops.end() ? s.stops.rbegin()->first : maxIt->first
+        minIt == stops.end() ? stops.rbegin()->first : minIt->first,
+        maxIt == stops.end() ? stops.rbegin()->first : maxIt->first
     };
 }
 
@@ -141,12 +162,12 @@ public:
       : layoutSize(function_.evaluate(tileZoom + 1)) {
         function_.stops.match(
             [&] (const style::ExponentialStops<float>& stops) {
-                const auto& zoomLevels = getCoveringStops(stops, tileZoom, tileZoom + 1);
+                const auto& zoomLevels = getCoveringStops(stops.getStops(), tileZoom, tileZoom + 1);
                 coveringRanges = std::make_tuple(
                     zoomLevels,
                     Range<float> { function_.evaluate(zoomLevels.min), function_.evaluate(zoomLevels.max) }
                 );
-                functionInterpolationBase = stops.base;
+                functionInterpolationBase = stops.getBase();
             },
             [&] (const style::IntervalStops<float>&) {
                 function = function_;
@@ -259,7 +280,7 @@ public:
           layoutZoom(tileZoom + 1),
           coveringZoomStops(function.stops.match(
             [&] (const auto& stops) {
-            return getCoveringStops(stops, tileZoom, tileZoom + 1); }))
+            return getCoveringStops(stops.getStops(), tileZoom, tileZoom + 1); }))
     {}
 
     SymbolSizeAttributes::Bindings attributeBindings() const override {
@@ -320,7 +341,11 @@ public:
     using LayoutAttributes = LayoutAttrs;
     using LayoutVertex = typename LayoutAttributes::Vertex;
     
-    using LayoutAndSizeAttributes = gl::ConcatenateAttributes<LayoutAttributes, SymbolSizeAttributes>;
+    using PlacementVertex = SymbolPlacementAttributes::Vertex;
+
+    using LayoutAndSizeAttributes = gl::ConcatenateAttributes<
+        gl::ConcatenateAttributes<LayoutAttributes, SymbolPlacementAttributes>,
+        SymbolSizeAttributes>;
 
     using PaintProperties = PaintProps;
     using PaintPropertyBinders = typename PaintProperties::Binders;
@@ -353,6 +378,7 @@ public:
               gl::ColorMode colorMode,
               UniformValues&& uniformValues,
               const gl::VertexBuffer<LayoutVertex>& layoutVertexBuffer,
+              const gl::VertexBuffer<PlacementVertex>& placementVertexBuffer,
               const SymbolSizeBinder& symbolSizeBinder,
               const gl::IndexBuffer<DrawMode>& indexBuffer,
               const gl::SegmentVector<Attributes>& segments,
@@ -369,6 +395,7 @@ public:
                 .concat(symbolSizeBinder.uniformValues(currentZoom))
                 .concat(paintPropertyBinders.uniformValues(currentZoom, currentProperties)),
             LayoutAttributes::bindings(layoutVertexBuffer)
+                .concat(SymbolPlacementAttributes::bindings(placementVertexBuffer))
                 .concat(symbolSizeBinder.attributeBindings())
                 .concat(paintPropertyBinders.attributeBindings(currentProperties)),
             indexBuffer,
@@ -470,6 +497,7 @@ using SymbolSDFIconProgram = SymbolSDFProgram<style::IconPaintProperties>;
 using SymbolSDFTextProgram = SymbolSDFProgram<style::TextPaintProperties>;
 
 using SymbolLayoutVertex = SymbolLayoutAttributes::Vertex;
+using SymbolPlacementVertex = SymbolPlacementAttributes::Vertex;
 using SymbolIconAttributes = SymbolIconProgram::Attributes;
 using SymbolTextAttributes = SymbolSDFTextProgram::Attributes;
 
@@ -44,6 +44,11 @@ public:
 
     virtual bool hasData() const = 0;
 
+    // Returns an estimate of the memory held by this bucket, used to budget the tile cache.
+    virtual std::size_t byteSize() const {
+        return 0;
+    }
+
     virtual float getQueryRadius(const RenderLayer&) const {
         return 0;
     };
@@ -53,6 +58,12 @@ public:
     }
 
 protected:
+    // Vertex and index vectors are retained after upload, so uploaded data is held twice: once
+    // in client memory and once in GL buffers.
+    std::size_t withUploadedSize(std::size_t bytes) const {
+        return uploaded ? bytes * 2 : bytes;
+    }
+
     std::atomic<bool> uploaded { false };
 };
 
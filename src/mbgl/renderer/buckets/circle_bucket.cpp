@@ -45,6 +45,10 @@ bool CircleBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t CircleBucket::byteSize() const {
+    return withUploadedSize(vertices.byteSize() + triangles.byteSize());
+}
+
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
                               const GeometryCollection& geometry) {
     constexpr const uint16_t vertexLength = 4;
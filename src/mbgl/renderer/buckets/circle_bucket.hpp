@@ -20,6 +20,7 @@ public:
     void addFeature(const GeometryTileFeature&,
                     const GeometryCollection&) override;
     bool hasData() const override;
+    std::size_t byteSize() const override;
 
     void upload(gl::Context&) override;
 
@@ -132,6 +132,10 @@ bool FillBucket::hasData() const {
     return !triangleSegments.empty() || !lineSegments.empty();
 }
 
+std::size_t FillBucket::byteSize() const {
+    return withUploadedSize(vertices.byteSize() + lines.byteSize() + triangles.byteSize());
+}
+
 float FillBucket::getQueryRadius(const RenderLayer& layer) const {
     if (!layer.is<RenderFillLayer>()) {
         return 0;
@@ -165,6 +165,10 @@ bool FillExtrusionBucket::hasData() const {
     return !triangleSegments.empty();
 }
 
+std::size_t FillExtrusionBucket::byteSize() const {
+    return withUploadedSize(vertices.byteSize() + triangles.byteSize());
+}
+
 float FillExtrusionBucket::getQueryRadius(const RenderLayer& layer) const {
     if (!layer.is<RenderFillExtrusionLayer>()) {
         return 0;
@@ -469,6 +469,10 @@ bool LineBucket::hasData() const {
     return !segments.empty();
 }
 
+std::size_t LineBucket::byteSize() const {
+    return withUploadedSize(vertices.byteSize() + triangles.byteSize());
+}
+
 template <class Property>
 static float get(const RenderLineLayer& layer, const std::map<std::string, LineProgram::PaintPropertyBinders>& paintPropertyBinders) {
     auto it = paintPropertyBinders.find(layer.getID());
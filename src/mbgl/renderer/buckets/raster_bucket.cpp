@@ -50,4 +50,8 @@ bool RasterBucket::hasData() const {
     return true;
 }
 
+std::size_t RasterBucket::byteSize() const {
+    return withUploadedSize(image.bytes() + vertices.byteSize() + indices.byteSize());
+}
+
 } // namespace mbgl
@@ -22,6 +22,7 @@ public:
                 const RenderLayer& layer,
                 const mat4& matrix);
     bool hasData() const override;
+    std::size_t byteSize() const override;
 
     void clear();
     UnassociatedImage image;
@@ -36,16 +36,41 @@ SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::PossiblyEvaluated layo
 }
 
 void SymbolBucket::upload(gl::Context& context) {
+    // The layout vertices and the feature data are only uploaded once; later uploads follow a new
+    // placement, which updates the placement vertices and, if it reordered them, the triangles in
+    // place. Their sizes don't change, so the vertex arrays of the segments stay valid.
     if (hasTextData()) {
-        text.vertexBuffer = context.createVertexBuffer(std::move(text.vertices));
-        text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
-        textSizeBinder->upload(context);
+        if (!text.vertexBuffer) {
+            text.vertexBuffer = context.createVertexBuffer(std::move(text.vertices));
+            textSizeBinder->upload(context);
+        }
+        if (!text.placementVertexBuffer) {
+            text.placementVertexBuffer = context.createVertexBuffer(std::move(text.placementVertices));
+        } else if (placementChanged) {
+            context.updateVertexBuffer(*text.placementVertexBuffer, std::move(text.placementVertices));
+        }
+        if (!text.indexBuffer) {
+            text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
+        } else if (textTrianglesChanged) {
+            context.updateIndexBuffer(*text.indexBuffer, std::move(text.triangles));
+        }
     }
 
     if (hasIconData()) {
-        icon.vertexBuffer = context.createVertexBuffer(std::move(icon.vertices));
-        icon.indexBuffer = context.createIndexBuffer(std::move(icon.triangles));
-        iconSizeBinder->upload(context);
+        if (!icon.vertexBuffer) {
+            icon.vertexBuffer = context.createVertexBuffer(std::move(icon.vertices));
+            iconSizeBinder->upload(context);
+        }
+        if (!icon.placementVertexBuffer) {
+            icon.placementVertexBuffer = context.createVertexBuffer(std::move(icon.placementVertices));
+        } else if (placementChanged) {
+            context.updateVertexBuffer(*icon.placementVertexBuffer, std::move(icon.placementVertices));
+        }
+        if (!icon.indexBuffer) {
+            icon.indexBuffer = context.createIndexBuffer(std::move(icon.triangles));
+        } else if (iconTrianglesChanged) {
+            context.updateIndexBuffer(*icon.indexBuffer, std::move(icon.triangles));
+        }
     }
 
     if (!collisionBox.vertices.empty()) {
@@ -53,14 +78,48 @@ void SymbolBucket::upload(gl::Context& context) {
         collisionBox.indexBuffer = context.createIndexBuffer(std::move(collisionBox.lines));
     }
 
-    for (auto& pair : paintPropertyBinders) {
-        pair.second.first.upload(context);
-        pair.second.second.upload(context);
+    placementChanged = false;
+    textTrianglesChanged = false;
+    iconTrianglesChanged = false;
+
+    if (!paintPropertiesUploaded) {
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.first.upload(context);
+            pair.second.second.upload(context);
+        }
+        paintPropertiesUploaded = true;
     }
 
     uploaded = true;
 }
 
+void SymbolBucket::place(SymbolPlacementBuffers placement) {
+    assert(placement.text.vertices.vertexSize() == text.vertices.vertexSize());
+    assert(placement.icon.vertices.vertexSize() == icon.vertices.vertexSize());
+
+    text.placementVertices = std::move(placement.text.vertices);
+    icon.placementVertices = std::move(placement.icon.vertices);
+    placementChanged = true;
+
+    if (!placement.text.triangles.empty()) {
+        text.triangles = std::move(placement.text.triangles);
+        textTrianglesChanged = true;
+    }
+
+    if (!placement.icon.triangles.empty()) {
+        icon.triangles = std::move(placement.icon.triangles);
+        iconTrianglesChanged = true;
+    }
+
+    collisionBox.vertices = std::move(placement.collisionBox.vertices);
+    collisionBox.lines = std::move(placement.collisionBox.lines);
+    collisionBox.segments = std::move(placement.collisionBox.segments);
+    collisionBox.vertexBuffer = {};
+    collisionBox.indexBuffer = {};
+
+    uploaded = false;
+}
+
 void SymbolBucket::render(Painter& painter,
                           PaintParameters& parameters,
                           const RenderLayer& layer,
@@ -72,6 +131,13 @@ bool SymbolBucket::hasData() const {
     return hasTextData() || hasIconData() || hasCollisionBoxData();
 }
 
+std::size_t SymbolBucket::byteSize() const {
+    return withUploadedSize(text.vertices.byteSize() + text.placementVertices.byteSize() + text.triangles.byteSize() +
+                            icon.vertices.byteSize() + icon.placementVertices.byteSize() + icon.triangles.byteSize() +
+                            collisionBox.vertices.byteSize() + collisionBox.lines.byteSize()) +
+           icon.atlasImage.bytes();
+}
+
 bool SymbolBucket::hasTextData() const {
     return !text.segments.empty();
 }
@@ -15,6 +15,27 @@
 
 namespace mbgl {
 
+// The buffers of a symbol bucket that depend on where its symbols are placed: the placement vertex
+// of every glyph and icon vertex, the collision debug boxes, and the triangles if the placement
+// changed their drawing order. Placing the symbols again only replaces these.
+class SymbolPlacementBuffers {
+public:
+    struct Buffer {
+        gl::VertexVector<SymbolPlacementVertex> vertices;
+        // Empty if the triangles of the bucket keep their order.
+        gl::IndexVector<gl::Triangles> triangles;
+    };
+
+    Buffer text;
+    Buffer icon;
+
+    struct CollisionBoxBuffer {
+        gl::VertexVector<CollisionBoxVertex> vertices;
+        gl::IndexVector<gl::Lines> lines;
+        gl::SegmentVector<CollisionBoxAttributes> segments;
+    } collisionBox;
+};
+
 class SymbolBucket : public Bucket {
 public:
     SymbolBucket(style::SymbolLayoutProperties::PossiblyEvaluated,
@@ -27,7 +48,14 @@ public:
 
     void upload(gl::Context&) override;
     void render(Painter&, PaintParameters&, const RenderLayer&, const RenderTile&) override;
+
+    // Replaces the placement buffers. The layout vertices, and the triangles unless the placement
+    // has new ones, stay in place and aren't uploaded again; the others are updated in the buffers
+    // uploaded before.
+    void place(SymbolPlacementBuffers);
+
     bool hasData() const override;
+    std::size_t byteSize() const override;
     bool hasTextData() const;
     bool hasIconData() const;
     bool hasCollisionBoxData() const;
@@ -44,10 +72,12 @@ public:
 
     struct TextBuffer {
         gl::VertexVector<SymbolLayoutVertex> vertices;
+        gl::VertexVector<SymbolPlacementVertex> placementVertices;
         gl::IndexVector<gl::Triangles> triangles;
         gl::SegmentVector<SymbolTextAttributes> segments;
 
         optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
+        optional<gl::VertexBuffer<SymbolPlacementVertex>> placementVertexBuffer;
         optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
     } text;
     
@@ -55,11 +85,13 @@ public:
     
     struct IconBuffer {
         gl::VertexVector<SymbolLayoutVertex> vertices;
+        gl::VertexVector<SymbolPlacementVertex> placementVertices;
         gl::IndexVector<gl::Triangles> triangles;
         gl::SegmentVector<SymbolIconAttributes> segments;
         PremultipliedImage atlasImage;
 
         optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
+        optional<gl::VertexBuffer<SymbolPlacementVertex>> placementVertexBuffer;
         optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
     } icon;
 
@@ -71,6 +103,12 @@ public:
         optional<gl::VertexBuffer<CollisionBoxVertex>> vertexBuffer;
         optional<gl::IndexBuffer<gl::Lines>> indexBuffer;
     } collisionBox;
+
+private:
+    bool paintPropertiesUploaded = false;
+    bool placementChanged = false;
+    bool textTrianglesChanged = false;
+    bool iconTrianglesChanged = false;
 };
 
 } // namespace mbgl
@@ -0,0 +1,224 @@
+#include <mbgl/renderer/feature_query.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/geometry/source_feature_index.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/util/intersection_tests.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
+
+#include <numeric>
+#include <set>
+#include <unordered_map>
+
+namespace mbgl {
+
+namespace {
+
+// Appends the features that haven't been seen yet. Features without an ID can't be told apart, so
+// they are always appended.
+void appendUnique(std::vector<Feature>& result,
+                  std::vector<Feature>&& features,
+                  std::set<FeatureIdentifier>& seen) {
+    for (auto& feature : features) {
+        if (feature.id && !seen.insert(*feature.id).second) {
+            continue;
+        }
+        result.push_back(std::move(feature));
+    }
+}
+
+bool intersects(const GeometryCoordinates& polygon, const GeometryTileFeature& feature) {
+    switch (feature.getType()) {
+    case FeatureType::Point:
+        return util::polygonIntersectsBufferedMultiPoint(polygon, feature.getGeometries(), 0);
+    case FeatureType::LineString:
+        return util::polygonIntersectsBufferedMultiLine(polygon, feature.getGeometries(), 0);
+    case FeatureType::Polygon:
+        return util::polygonIntersectsMultiPolygon(polygon, feature.getGeometries());
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+RenderedFeatureQuery::RenderedFeatureQuery(RenderedQueryOptions options_, float bearing_)
+    : options(std::move(options_)), bearing(bearing_) {
+}
+
+void RenderedFeatureQuery::addLayer(const RenderLayer& layer) {
+    layers.push_back(&layer);
+}
+
+void RenderedFeatureQuery::addTile(Tile tile) {
+    tiles.push_back(std::move(tile));
+}
+
+void RenderedFeatureQuery::detach() {
+    std::vector<const RenderLayer*> copies;
+    for (const RenderLayer* layer : layers) {
+        // Layers that can't be copied don't have any queryable features.
+        if (auto copy = layer->clone()) {
+            copies.push_back(copy.get());
+            detachedLayers.push_back(std::move(copy));
+        }
+    }
+    layers = std::move(copies);
+}
+
+std::vector<Feature> RenderedFeatureQuery::run() const {
+    std::vector<Feature> result;
+    if (tiles.empty()) {
+        return result;
+    }
+
+    std::unordered_map<std::string, const RenderLayer*> layersByID;
+    for (const RenderLayer* layer : layers) {
+        layersByID.emplace(layer->getID(), layer);
+    }
+
+    // Collect the results of each tile separately, so that duplicates can be removed while
+    // combining them by layer.
+    std::vector<std::unordered_map<std::string, std::vector<Feature>>> resultsByTile(tiles.size());
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const Tile& tile = tiles[i];
+        tile.featureIndex->query(resultsByTile[i],
+                                 tile.queryGeometry,
+                                 bearing,
+                                 tile.tileSize,
+                                 tile.scale,
+                                 tile.additionalQueryRadius,
+                                 options,
+                                 *tile.data,
+                                 tile.id,
+                                 layersByID,
+                                 tile.collisionTile.get());
+    }
+
+    // Combine all results based on the style layer order.
+    for (const RenderLayer* layer : layers) {
+        std::set<FeatureIdentifier> seen;
+        for (auto& tileResult : resultsByTile) {
+            auto it = tileResult.find(layer->getID());
+            if (it != tileResult.end()) {
+                appendUnique(result, std::move(it->second), seen);
+            }
+        }
+    }
+
+    return result;
+}
+
+SourceFeatureQuery::SourceFeatureQuery(SourceQueryOptions options_)
+    : options(std::move(options_)) {
+}
+
+void SourceFeatureQuery::addTile(const CanonicalTileID& id,
+                                 std::shared_ptr<const GeometryTileData> data,
+                                 std::shared_ptr<const SourceFeatureIndex> index,
+                                 std::vector<std::string> sourceLayers) {
+    tiles.push_back({ id, std::move(data), std::move(index), std::move(sourceLayers) });
+}
+
+std::vector<Feature> SourceFeatureQuery::run() const {
+    std::vector<Feature> result;
+    if (options.limit && *options.limit == 0) {
+        return result;
+    }
+
+    // Feature IDs are only unique within a source layer.
+    std::unordered_map<std::string, std::set<FeatureIdentifier>> seen;
+
+    // The bounds, projected to world coordinates; each tile converts them to its own coordinates.
+    optional<std::pair<TileCoordinatePoint, TileCoordinatePoint>> bounds;
+    if (options.bounds) {
+        bounds = std::make_pair(TileCoordinate::fromLatLng(0, options.bounds->northwest()).p,
+                                TileCoordinate::fromLatLng(0, options.bounds->southeast()).p);
+    }
+
+    for (const auto& tile : tiles) {
+        SourceFeatureIndex::BBox bbox { {}, {} };
+        GeometryCoordinates boundsPolygon;
+        if (bounds) {
+            const UnwrappedTileID tileID(0, tile.id);
+            bbox.min = TileCoordinate::toGeometryCoordinate(tileID, bounds->first);
+            bbox.max = TileCoordinate::toGeometryCoordinate(tileID, bounds->second);
+            boundsPolygon = {
+                bbox.min,
+                { bbox.max.x, bbox.min.y },
+                bbox.max,
+                { bbox.min.x, bbox.max.y },
+                bbox.min
+            };
+        }
+
+        for (const auto& sourceLayer : tile.sourceLayers) {
+            auto layer = tile.data->getLayer(sourceLayer);
+            if (!layer) {
+                continue;
+            }
+
+            // Narrow the features down to the ones whose bounding boxes intersect the bounds,
+            // without decoding the others.
+            std::vector<std::size_t> candidates;
+            if (bounds) {
+                candidates = tile.index->query(*layer, bbox);
+            } else {
+                candidates.resize(layer->featureCount());
+                std::iota(candidates.begin(), candidates.end(), 0);
+            }
+
+            auto& seenIDs = seen[sourceLayer];
+            for (const std::size_t i : candidates) {
+                auto feature = layer->getFeature(i);
+
+                // Skip features that an earlier tile already returned, before converting them.
+                auto id = feature->getID();
+                if (id && seenIDs.count(*id)) {
+                    continue;
+                }
+
+                // Apply filter, if any
+                if (options.filter && !(*options.filter)(*feature)) {
+                    continue;
+                }
+
+                if (bounds && !intersects(boundsPolygon, *feature)) {
+                    continue;
+                }
+
+                if (id) {
+                    seenIDs.insert(*id);
+                }
+                result.push_back(options.properties ? convertFeature(*feature, tile.id, *options.properties)
+                                                    : convertFeature(*feature, tile.id));
+
+                if (options.limit && result.size() >= *options.limit) {
+                    return result;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+void FeatureQueryRequestor::onFeatures(std::vector<Feature> features, FeatureQueryCallback callback) {
+    callback(std::move(features));
+}
+
+FeatureQueryWorker::FeatureQueryWorker(ActorRef<FeatureQueryWorker>,
+                                       ActorRef<FeatureQueryRequestor> requestor_)
+    : requestor(std::move(requestor_)) {
+}
+
+void FeatureQueryWorker::queryRenderedFeatures(RenderedFeatureQuery query, FeatureQueryCallback callback) {
+    requestor.invoke(&FeatureQueryRequestor::onFeatures, query.run(), std::move(callback));
+}
+
+void FeatureQueryWorker::querySourceFeatures(SourceFeatureQuery query, FeatureQueryCallback callback) {
+    requestor.invoke(&FeatureQueryRequestor::onFeatures, query.run(), std::move(callback));
+}
+
+} // namespace mbgl
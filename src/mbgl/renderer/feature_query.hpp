@@ -0,0 +1,131 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/map/query.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/feature.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+class CollisionTile;
+class FeatureIndex;
+class RenderLayer;
+class SourceFeatureIndex;
+
+// A snapshot of the style layers and loaded tiles that a rendered feature query covers. Tiles are
+// referenced through their immutable data, feature index and collision tile, so the snapshot stays
+// valid while the tiles are re-laid out or removed. Once detached from the render thread's layers,
+// it can be run on any thread.
+class RenderedFeatureQuery {
+public:
+    class Tile {
+    public:
+        CanonicalTileID id;
+        GeometryCoordinates queryGeometry;
+        double tileSize;
+        double scale;
+        int16_t additionalQueryRadius;
+        std::shared_ptr<const FeatureIndex> featureIndex;
+        std::shared_ptr<const GeometryTileData> data;
+        std::shared_ptr<const CollisionTile> collisionTile;
+    };
+
+    RenderedFeatureQuery(RenderedQueryOptions, float bearing);
+
+    const RenderedQueryOptions& getOptions() const {
+        return options;
+    }
+
+    float getBearing() const {
+        return bearing;
+    }
+
+    // Layers are added in style order, which is the order of the results.
+    void addLayer(const RenderLayer&);
+    const std::vector<const RenderLayer*>& getLayers() const {
+        return layers;
+    }
+
+    void addTile(Tile);
+
+    // Replaces the layers with copies of their evaluated state, so that the query no longer
+    // refers to anything owned by the render thread.
+    void detach();
+
+    // Returns the features that intersect the query geometry, in style layer order. Features
+    // that are present in several tiles are returned once per layer.
+    std::vector<Feature> run() const;
+
+private:
+    RenderedQueryOptions options;
+    float bearing;
+
+    std::vector<const RenderLayer*> layers;
+    std::vector<std::unique_ptr<const RenderLayer>> detachedLayers;
+
+    std::vector<Tile> tiles;
+};
+
+// A snapshot of the loaded tiles of a source, for a source feature query. It only refers to
+// immutable tile data and thread-safe indexes, so it can be run on any thread.
+class SourceFeatureQuery {
+public:
+    SourceFeatureQuery(SourceQueryOptions);
+
+    const SourceQueryOptions& getOptions() const {
+        return options;
+    }
+
+    void addTile(const CanonicalTileID&,
+                 std::shared_ptr<const GeometryTileData>,
+                 std::shared_ptr<const SourceFeatureIndex>,
+                 std::vector<std::string> sourceLayers);
+
+    // Returns the features of the requested source layers that match the filter and bounds, up
+    // to the limit. Features that are present in several tiles are returned once. When bounds
+    // are given, only features whose bounding boxes intersect them are decoded.
+    std::vector<Feature> run() const;
+
+private:
+    class Tile {
+    public:
+        CanonicalTileID id;
+        std::shared_ptr<const GeometryTileData> data;
+        std::shared_ptr<const SourceFeatureIndex> index;
+        std::vector<std::string> sourceLayers;
+    };
+
+    SourceQueryOptions options;
+    std::vector<Tile> tiles;
+};
+
+using FeatureQueryCallback = std::function<void (std::vector<Feature>)>;
+
+// Receives query results on the thread that issued the queries. Results that arrive after it has
+// been destroyed are dropped.
+class FeatureQueryRequestor {
+public:
+    FeatureQueryRequestor(ActorRef<FeatureQueryRequestor>) {}
+
+    void onFeatures(std::vector<Feature>, FeatureQueryCallback);
+};
+
+// Runs detached queries on the worker pool.
+class FeatureQueryWorker {
+public:
+    FeatureQueryWorker(ActorRef<FeatureQueryWorker>, ActorRef<FeatureQueryRequestor>);
+
+    void queryRenderedFeatures(RenderedFeatureQuery, FeatureQueryCallback);
+    void querySourceFeatures(SourceFeatureQuery, FeatureQueryCallback);
+
+private:
+    ActorRef<FeatureQueryRequestor> requestor;
+};
+
+} // namespace mbgl
@@ -0,0 +1,221 @@
+#include <mbgl/renderer/frame_profiler.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/gl/timer_query_extension.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <vector>
+
+namespace mbgl {
+
+FrameProfiler::FrameProfiler(uint32_t frameCount_)
+    : frameCount(frameCount_) {
+    assert(frameCount > 0);
+}
+
+FrameProfiler::~FrameProfiler() {
+    if (context && !queries.empty()) {
+        auto& extension = *context->getTimerQueryExtension();
+        if (queryActive) {
+            MBGL_CHECK_ERROR(extension.endQuery(GL_TIME_ELAPSED));
+        }
+        MBGL_CHECK_ERROR(extension.deleteQueries(int(queries.size()), queries.data()));
+    }
+}
+
+void FrameProfiler::beginFrame(gl::Context& context_) {
+    assert(open.empty());
+    assert(!context || context == &context_);
+    context = &context_;
+    timerQueries = context->supportsTimerQueries();
+
+    if (timerQueries) {
+        for (auto& frame : frames) {
+            if (!frame.gpuTimed && !frame.queries.empty()) {
+                collect(frame);
+            }
+        }
+    }
+
+    current = Frame();
+    begin(Kind::Frame, "frame");
+}
+
+void FrameProfiler::endFrame() {
+    end();
+    assert(open.empty());
+
+    frames.push_back(std::move(current));
+    while (frames.size() > frameCount) {
+        release(frames.front());
+        frames.pop_front();
+    }
+}
+
+void FrameProfiler::begin(Kind kind, const std::string& name) {
+    const int32_t parent = open.empty() ? -1 : open.back();
+    open.push_back(static_cast<int32_t>(current.sections.size()));
+    current.sections.push_back({ kind, name, parent, TimePoint(), Duration::zero(), Duration::zero() });
+    switchQuery();
+    current.sections.back().start = Clock::now();
+}
+
+void FrameProfiler::end() {
+    assert(!open.empty());
+    Section& section = current.sections[open.back()];
+    section.cpuTime = Clock::now() - section.start;
+    open.pop_back();
+    switchQuery();
+}
+
+void FrameProfiler::switchQuery() {
+    if (!timerQueries) {
+        return;
+    }
+
+    auto& extension = *context->getTimerQueryExtension();
+
+    if (queryActive) {
+        MBGL_CHECK_ERROR(extension.endQuery(GL_TIME_ELAPSED));
+        queryActive = false;
+    }
+
+    if (open.empty()) {
+        return;
+    }
+
+    gl::QueryID id = 0;
+    if (unusedQueries.empty()) {
+        MBGL_CHECK_ERROR(extension.genQueries(1, &id));
+        queries.push_back(id);
+    } else {
+        id = unusedQueries.back();
+        unusedQueries.pop_back();
+    }
+
+    MBGL_CHECK_ERROR(extension.beginQuery(GL_TIME_ELAPSED, id));
+    queryActive = true;
+    current.queries.push_back({ id, open.back() });
+}
+
+void FrameProfiler::collect(Frame& frame) {
+    auto& extension = *context->getTimerQueryExtension();
+
+    // Queries complete in the order in which they were issued, so if the last one is available,
+    // all of them are.
+    GLuint available = 0;
+    MBGL_CHECK_ERROR(extension.getQueryObjectuiv(frame.queries.back().id,
+                                                 GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return;
+    }
+
+    for (const auto& query : frame.queries) {
+        uint64_t elapsed = 0;
+        MBGL_CHECK_ERROR(extension.getQueryObjectui64v(query.id, GL_QUERY_RESULT, &elapsed));
+        for (int32_t index = query.section; index >= 0; index = frame.sections[index].parent) {
+            frame.sections[index].gpuTime += std::chrono::nanoseconds(elapsed);
+        }
+    }
+
+    frame.gpuTimed = true;
+    release(frame);
+}
+
+void FrameProfiler::release(Frame& frame) {
+    for (const auto& query : frame.queries) {
+        unusedQueries.push_back(query.id);
+    }
+    frame.queries.clear();
+}
+
+RenderProfile FrameProfiler::getProfile() const {
+    struct Totals {
+        std::size_t order = 0;
+        uint32_t frames = 0;
+        uint32_t gpuFrames = 0;
+        Duration cpuTime = Duration::zero();
+        Duration gpuTime = Duration::zero();
+    };
+
+    using Key = std::pair<Kind, std::string>;
+    std::map<Key, Totals> totals;
+
+    for (const auto& frame : frames) {
+        // A layer may be rendered in more than one pass; add up its time within the frame first.
+        std::map<Key, std::pair<Duration, Duration>> sums;
+        std::vector<const Key*> order;
+        for (const auto& section : frame.sections) {
+            auto result = sums.emplace(Key { section.kind, section.name },
+                                       std::make_pair(Duration::zero(), Duration::zero()));
+            if (result.second) {
+                order.push_back(&result.first->first);
+            }
+            result.first->second.first += section.cpuTime;
+            result.first->second.second += section.gpuTime;
+        }
+
+        for (const Key* key : order) {
+            const auto& sum = sums[*key];
+            auto it = totals.find(*key);
+            if (it == totals.end()) {
+                it = totals.emplace(*key, Totals()).first;
+                it->second.order = totals.size();
+            }
+            Totals& total = it->second;
+            total.frames++;
+            total.cpuTime += sum.first;
+            if (frame.gpuTimed) {
+                total.gpuFrames++;
+                total.gpuTime += sum.second;
+            }
+        }
+    }
+
+    RenderProfile profile;
+    profile.frames = static_cast<uint32_t>(frames.size());
+
+    std::vector<std::pair<std::size_t, RenderProfile::Timing>> passes;
+    for (const auto& entry : totals) {
+        const Totals& total = entry.second;
+
+        RenderProfile::Timing timing;
+        timing.name = entry.first.second;
+        timing.frames = total.frames;
+        timing.cpuTime = total.cpuTime / total.frames;
+        if (total.gpuFrames) {
+            timing.gpuTime = total.gpuTime / total.gpuFrames;
+        }
+
+        switch (entry.first.first) {
+        case Kind::Frame:
+            profile.total = std::move(timing);
+            break;
+        case Kind::Pass:
+            passes.emplace_back(total.order, std::move(timing));
+            break;
+        case Kind::Layer:
+            profile.layers.push_back(std::move(timing));
+            break;
+        }
+    }
+
+    // Sections are first seen in the order in which they're rendered, except that passes which
+    // were skipped in the first recorded frames would be appended at the end.
+    std::sort(passes.begin(), passes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (auto& pass : passes) {
+        profile.passes.push_back(std::move(pass.second));
+    }
+
+    std::stable_sort(profile.layers.begin(), profile.layers.end(), [](const auto& a, const auto& b) {
+        return a.cpuTime + a.gpuTime.value_or(Duration::zero()) >
+               b.cpuTime + b.gpuTime.value_or(Duration::zero());
+    });
+
+    return profile;
+}
+
+} // namespace mbgl
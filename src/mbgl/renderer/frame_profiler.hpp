@@ -0,0 +1,111 @@
+#pragma once
+
+#include <mbgl/map/render_profile.hpp>
+#include <mbgl/gl/types.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+namespace gl {
+class Context;
+} // namespace gl
+
+// Records the CPU time and, where timer queries are supported, the GPU time of the render passes
+// and layers of the most recent frames.
+//
+// Sections nest, but GL allows only one timer query to be active at a time. The GPU time of a
+// frame is therefore split into consecutive intervals at every section boundary; each interval
+// is attributed to the innermost open section and all sections enclosing it. Query results are
+// collected at the start of later frames, so that reading them never waits for the GPU.
+class FrameProfiler : private util::noncopyable {
+public:
+    enum class Kind : uint8_t {
+        Frame,
+        Pass,
+        Layer,
+    };
+
+    // Opens a section for the lifetime of the scope. Does nothing if `profiler` is null.
+    class Scope {
+    public:
+        Scope(FrameProfiler* profiler_, Kind kind, const std::string& name)
+            : profiler(profiler_) {
+            if (profiler) {
+                profiler->begin(kind, name);
+            }
+        }
+
+        ~Scope() {
+            if (profiler) {
+                profiler->end();
+            }
+        }
+
+    private:
+        FrameProfiler* const profiler;
+    };
+
+    FrameProfiler(uint32_t frameCount);
+
+    // Deletes the timer queries, so the context must be active.
+    ~FrameProfiler();
+
+    uint32_t getFrameCount() const {
+        return frameCount;
+    }
+
+    void beginFrame(gl::Context&);
+    void endFrame();
+
+    void begin(Kind, const std::string& name);
+    void end();
+
+    // Averages the timings of the recorded frames.
+    RenderProfile getProfile() const;
+
+private:
+    struct Section {
+        Kind kind;
+        std::string name;
+        int32_t parent;
+        TimePoint start;
+        Duration cpuTime;
+        Duration gpuTime;
+    };
+
+    struct Query {
+        gl::QueryID id;
+        int32_t section;
+    };
+
+    struct Frame {
+        std::vector<Section> sections;
+        std::vector<Query> queries;
+        bool gpuTimed = false;
+    };
+
+    // Ends the active timer query, and starts one for the innermost open section, if any.
+    void switchQuery();
+    // Adds the query results to the sections of the frame once all of them are available.
+    void collect(Frame&);
+    void release(Frame&);
+
+    const uint32_t frameCount;
+    gl::Context* context = nullptr;
+    bool timerQueries = false;
+    bool queryActive = false;
+
+    std::deque<Frame> frames;
+    Frame current;
+    std::vector<int32_t> open;
+
+    std::vector<gl::QueryID> queries;
+    std::vector<gl::QueryID> unusedQueries;
+};
+
+} // namespace mbgl
@@ -16,6 +16,10 @@ const style::CircleLayer::Impl& RenderCircleLayer::impl() const {
     return static_cast<const style::CircleLayer::Impl&>(*baseImpl);
 }
 
+std::unique_ptr<RenderLayer> RenderCircleLayer::clone() const {
+    return std::make_unique<RenderCircleLayer>(*this);
+}
+
 std::unique_ptr<Bucket> RenderCircleLayer::createBucket(const BucketParameters& parameters, const std::vector<const RenderLayer*>& layers) const {
     return std::make_unique<CircleBucket>(parameters, layers);
 }
@@ -134,6 +134,9 @@ public:
           defaultValue(std::move(defaultValue_)) {
     }
 
+    // Buckets add their features one at a time, and GeometryTileFeature only looks values up by
+    // key, so each feature is evaluated on its own. The stops are compiled when the function is
+    // constructed, which keeps this to one lookup and one binary search.
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) override {
         auto evaluated = function.evaluate(feature, defaultValue);
         this->statistics.add(evaluated);
@@ -3,6 +3,7 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/render_style.hpp>
+#include <mbgl/renderer/frame_profiler.hpp>
 
 #include <mbgl/style/source.hpp>
 #include <mbgl/style/source_impl.hpp>
@@ -23,6 +24,7 @@
 
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
 
 #include <mbgl/programs/program_parameters.hpp>
 #include <mbgl/programs/programs.hpp>
@@ -139,6 +141,7 @@ void Painter::render(RenderStyle& style, const FrameData& frame_, View& view) {
 
     imageManager = style.imageManager.get();
     lineAtlas = style.lineAtlas.get();
+    symbolAtlas = style.symbolAtlas.get();
 
     evaluatedLight = style.getRenderLight().getEvaluated();
 
@@ -166,9 +169,11 @@ void Painter::render(RenderStyle& style, const FrameData& frame_, View& view) {
     // Uploads all required buffers and images before we do any actual rendering.
     {
         MBGL_DEBUG_GROUP(context, "upload");
+        FrameProfiler::Scope profile { profiler, FrameProfiler::Kind::Pass, "upload" };
 
         imageManager->upload(context, 0);
         lineAtlas->upload(context, 0);
+        symbolAtlas->upload(context, 0);
         frameHistory.upload(context, 0);
     }
 
@@ -177,6 +182,7 @@ void Painter::render(RenderStyle& style, const FrameData& frame_, View& view) {
     // tiles whatsoever.
     {
         MBGL_DEBUG_GROUP(context, "clear");
+        FrameProfiler::Scope profile { profiler, FrameProfiler::Kind::Pass, "clear" };
         view.bind();
         context.clear(paintMode() == PaintMode::Overdraw
                         ? Color::black()
@@ -189,6 +195,7 @@ void Painter::render(RenderStyle& style, const FrameData& frame_, View& view) {
     // Draws the clipping masks to the stencil buffer.
     {
         MBGL_DEBUG_GROUP(context, "clip");
+        FrameProfiler::Scope profile { profiler, FrameProfiler::Kind::Pass, "clip" };
 
         // Update all clipping IDs.
         clipIDGenerator = algorithm::ClipIDGenerator();
@@ -236,6 +243,7 @@ void Painter::render(RenderStyle& style, const FrameData& frame_, View& view) {
     // Renders debug overlays.
     {
         MBGL_DEBUG_GROUP(context, "debug");
+        FrameProfiler::Scope profile { profiler, FrameProfiler::Kind::Pass, "debug" };
 
         // Finalize the rendering, e.g. by calling debug render calls per tile.
         // This guarantees that we have at least one function per tile called.
@@ -274,6 +282,8 @@ void Painter::renderPass(PaintParameters& parameters,
     pass = pass_;
 
     MBGL_DEBUG_GROUP(context, pass == RenderPass::Opaque ? "opaque" : "translucent");
+    FrameProfiler::Scope profilePass { profiler, FrameProfiler::Kind::Pass,
+                                       pass == RenderPass::Opaque ? "opaque" : "translucent" };
 
     if (debug::renderTree) {
         Log::Info(Event::Render, "%*s%s {", indent++ * 4, "",
@@ -289,6 +299,8 @@ void Painter::renderPass(PaintParameters& parameters,
         if (!layer.hasRenderPass(pass))
             continue;
 
+        FrameProfiler::Scope profileLayer { profiler, FrameProfiler::Kind::Layer, layer.getID() };
+
         if (layer.is<RenderBackgroundLayer>()) {
             MBGL_DEBUG_GROUP(context, "background");
             renderBackground(parameters, *layer.as<RenderBackgroundLayer>());
@@ -35,6 +35,8 @@ class RenderTile;
 class ImageManager;
 class View;
 class LineAtlas;
+class SymbolAtlas;
+class FrameProfiler;
 struct FrameData;
 class Tile;
 
@@ -153,6 +155,10 @@ public:
 
     ImageManager* imageManager = nullptr;
     LineAtlas* lineAtlas = nullptr;
+    SymbolAtlas* symbolAtlas = nullptr;
+
+    // Records the timings of passes and layers while render profiling is enabled.
+    FrameProfiler* profiler = nullptr;
 
     optional<OffscreenTexture> extrusionTexture;
 
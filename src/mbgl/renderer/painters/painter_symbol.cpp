@@ -4,12 +4,11 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
-#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/symbol_program.hpp>
 #include <mbgl/programs/collision_box_program.hpp>
 #include <mbgl/util/math.hpp>
-#include <mbgl/tile/geometry_tile.hpp>
 
 #include <cmath>
 
@@ -52,6 +51,7 @@ void Painter::renderSymbol(PaintParameters& parameters,
             colorModeForRenderPass(),
             std::move(uniformValues),
             *buffers.vertexBuffer,
+            *buffers.placementVertexBuffer,
             *symbolSizeBinder,
             *buffers.indexBuffer,
             buffers.segments,
@@ -61,9 +61,6 @@ void Painter::renderSymbol(PaintParameters& parameters,
         );
     };
 
-    assert(dynamic_cast<GeometryTile*>(&tile.tile));
-    GeometryTile& geometryTile = static_cast<GeometryTile&>(tile.tile);
-
     if (bucket.hasIconData()) {
         auto values = layer.iconPropertyValues(layout);
         auto paintPropertyValues = layer.iconPaintProperties();
@@ -71,11 +68,11 @@ void Painter::renderSymbol(PaintParameters& parameters,
         const bool iconScaled = layout.get<IconSize>().constantOr(1.0) != 1.0 || bucket.iconsNeedLinear;
         const bool iconTransformed = values.rotationAlignment == AlignmentType::Map || state.getPitch() != 0;
 
-        context.bindTexture(*geometryTile.iconAtlasTexture, 0,
+        symbolAtlas->bindIcons(context, 0,
             bucket.sdfIcons || state.isChanging() || iconScaled || iconTransformed
                 ? gl::TextureFilter::Linear : gl::TextureFilter::Nearest);
 
-        const Size texsize = geometryTile.iconAtlasTexture->size;
+        const Size texsize = symbolAtlas->getIconAtlasSize();
 
         if (bucket.sdfIcons) {
             if (values.hasHalo) {
@@ -109,12 +106,12 @@ void Painter::renderSymbol(PaintParameters& parameters,
     }
 
     if (bucket.hasTextData()) {
-        context.bindTexture(*geometryTile.glyphAtlasTexture, 0, gl::TextureFilter::Linear);
+        symbolAtlas->bindGlyphs(context, 0);
 
         auto values = layer.textPropertyValues(layout);
         auto paintPropertyValues = layer.textPaintProperties();
 
-        const Size texsize = geometryTile.glyphAtlasTexture->size;
+        const Size texsize = symbolAtlas->getGlyphAtlasSize();
 
         if (values.hasHalo) {
             draw(parameters.programs.symbolGlyph,
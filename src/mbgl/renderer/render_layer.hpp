@@ -23,6 +23,10 @@ class RenderLayer {
 protected:
     RenderLayer(style::LayerType, Immutable<style::Layer::Impl>);
 
+    // Copies the evaluated state of the layer, but not its render tiles, which belong to the
+    // render thread.
+    RenderLayer(const RenderLayer&);
+
     const style::LayerType type;
 
 public:
@@ -73,6 +77,10 @@ public:
             const float,
             const float) const { return false; };
 
+    // Returns a copy of the evaluated state of this layer that can be used to query features
+    // on another thread, or nullptr if the layer doesn't have queryable features.
+    virtual std::unique_ptr<RenderLayer> clone() const { return nullptr; }
+
     virtual std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const RenderLayer*>&) const = 0;
 
     void setRenderTiles(std::vector<std::reference_wrapper<RenderTile>>);
@@ -18,10 +18,9 @@ namespace mbgl {
 class Painter;
 class TransformState;
 class RenderTile;
-class RenderStyle;
 class RenderLayer;
-class RenderedQueryOptions;
-class SourceQueryOptions;
+class RenderedFeatureQuery;
+class SourceFeatureQuery;
 class Tile;
 class RenderSourceObserver;
 class TileParameters;
@@ -60,14 +59,12 @@ public:
     // Returns an unsorted list of RenderTiles.
     virtual std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() = 0;
 
-    virtual std::unordered_map<std::string, std::vector<Feature>>
-    queryRenderedFeatures(const ScreenLineString& geometry,
-                          const TransformState& transformState,
-                          const RenderStyle& style,
-                          const RenderedQueryOptions& options) const = 0;
+    // Adds the loaded tiles that a query covers to it.
+    virtual void queryRenderedFeatures(RenderedFeatureQuery& query,
+                                       const ScreenLineString& geometry,
+                                       const TransformState& transformState) const = 0;
 
-    virtual std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const = 0;
+    virtual void querySourceFeatures(SourceFeatureQuery& query) const = 0;
 
     virtual void onLowMemory() = 0;
 
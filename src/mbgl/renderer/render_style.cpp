@@ -17,6 +17,7 @@
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/style_diff.hpp>
 #include <mbgl/renderer/image_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/transition_options.hpp>
@@ -25,7 +26,9 @@
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/map/backend_scope.hpp>
 #include <mbgl/map/query.hpp>
+#include <mbgl/map/transform_state.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/string.hpp>
 
@@ -41,6 +44,8 @@ RenderStyle::RenderStyle(Scheduler& scheduler_, FileSource& fileSource_)
       glyphManager(std::make_unique<GlyphManager>(fileSource)),
       imageManager(std::make_unique<ImageManager>()),
       lineAtlas(std::make_unique<LineAtlas>(Size{ 256, 512 })),
+      symbolAtlas(std::make_unique<SymbolAtlas>()),
+      tileCache(std::make_unique<TileCache>()),
       imageImpls(makeMutable<std::vector<Immutable<style::Image::Impl>>>()),
       sourceImpls(makeMutable<std::vector<Immutable<style::Source::Impl>>>()),
       layerImpls(makeMutable<std::vector<Immutable<style::Layer::Impl>>>()),
@@ -106,9 +111,14 @@ void RenderStyle::update(const UpdateParameters& parameters) {
         parameters.annotationManager,
         *imageManager,
         *glyphManager,
-        parameters.prefetchZoomDelta
+        *symbolAtlas,
+        *tileCache,
+        parameters.prefetchZoomDelta,
+        parameters.parallelTileLayout
     };
 
+    tileCache->setSize(parameters.tileCacheSize);
+
     glyphManager->setURL(parameters.glyphURL);
 
     // Update light.
@@ -371,56 +381,47 @@ RenderData RenderStyle::getRenderData(MapDebugOptions debugOptions, float angle)
     return result;
 }
 
-std::vector<Feature> RenderStyle::queryRenderedFeatures(const ScreenLineString& geometry,
-                                                  const TransformState& transformState,
-                                                  const RenderedQueryOptions& options) const {
-    std::unordered_map<std::string, std::vector<Feature>> resultsByLayer;
+RenderedFeatureQuery RenderStyle::createRenderedFeatureQuery(const ScreenLineString& geometry,
+                                                             const TransformState& transformState,
+                                                             const RenderedQueryOptions& options) const {
+    RenderedFeatureQuery query(options, transformState.getAngle());
+
+    // Results are combined based on the style layer order.
+    for (const auto& layerImpl : *layerImpls) {
+        if (options.layerIDs &&
+            std::find(options.layerIDs->begin(), options.layerIDs->end(), layerImpl->id) == options.layerIDs->end()) {
+            continue;
+        }
+        const RenderLayer* layer = getRenderLayer(layerImpl->id);
+        if (layer->needsRendering(zoomHistory.lastZoom)) {
+            query.addLayer(*layer);
+        }
+    }
 
     if (options.layerIDs) {
         std::unordered_set<std::string> sourceIDs;
-        for (const auto& layerID : *options.layerIDs) {
-            if (const RenderLayer* layer = getRenderLayer(layerID)) {
-                sourceIDs.emplace(layer->baseImpl->source);
-            }
+        for (const RenderLayer* layer : query.getLayers()) {
+            sourceIDs.emplace(layer->baseImpl->source);
         }
         for (const auto& sourceID : sourceIDs) {
             if (RenderSource* renderSource = getRenderSource(sourceID)) {
-                auto sourceResults = renderSource->queryRenderedFeatures(geometry, transformState, *this, options);
-                std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
+                renderSource->queryRenderedFeatures(query, geometry, transformState);
             }
         }
     } else {
         for (const auto& entry : renderSources) {
-            auto sourceResults = entry.second->queryRenderedFeatures(geometry, transformState, *this, options);
-            std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
+            entry.second->queryRenderedFeatures(query, geometry, transformState);
         }
     }
 
-    std::vector<Feature> result;
-
-    if (resultsByLayer.empty()) {
-        return result;
-    }
-
-    // Combine all results based on the style layer order.
-    for (const auto& layerImpl : *layerImpls) {
-        const RenderLayer* layer = getRenderLayer(layerImpl->id);
-        if (!layer->needsRendering(zoomHistory.lastZoom)) {
-            continue;
-        }
-        auto it = resultsByLayer.find(layer->baseImpl->id);
-        if (it != resultsByLayer.end()) {
-            std::move(it->second.begin(), it->second.end(), std::back_inserter(result));
-        }
-    }
-
-    return result;
+    return query;
 }
 
 void RenderStyle::onLowMemory() {
     for (const auto& entry : renderSources) {
         entry.second->onLowMemory();
     }
+    tileCache->clear();
 }
 
 void RenderStyle::onGlyphsError(const FontStack& fontStack, const GlyphRange& glyphRange, std::exception_ptr error) {
@@ -5,6 +5,7 @@
 #include <mbgl/renderer/render_source_observer.hpp>
 #include <mbgl/renderer/render_layer.hpp>
 #include <mbgl/renderer/render_light.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/text/glyph_manager_observer.hpp>
 #include <mbgl/map/zoom_history.hpp>
 #include <mbgl/map/mode.hpp>
@@ -19,9 +20,10 @@ class FileSource;
 class GlyphManager;
 class ImageManager;
 class LineAtlas;
+class SymbolAtlas;
+class TileCache;
 class RenderData;
 class TransformState;
-class RenderedQueryOptions;
 class Scheduler;
 class UpdateParameters;
 class RenderStyleObserver;
@@ -55,9 +57,11 @@ public:
 
     RenderData getRenderData(MapDebugOptions, float angle);
 
-    std::vector<Feature> queryRenderedFeatures(const ScreenLineString& geometry,
-                                               const TransformState& transformState,
-                                               const RenderedQueryOptions& options) const;
+    // Snapshots the layers and tiles that a rendered feature query covers. The query refers to
+    // the render layers until it is detached.
+    RenderedFeatureQuery createRenderedFeatureQuery(const ScreenLineString& geometry,
+                                                    const TransformState& transformState,
+                                                    const RenderedQueryOptions& options) const;
 
     void onLowMemory();
 
@@ -68,6 +72,10 @@ public:
     std::unique_ptr<GlyphManager> glyphManager;
     std::unique_ptr<ImageManager> imageManager;
     std::unique_ptr<LineAtlas> lineAtlas;
+    std::unique_ptr<SymbolAtlas> symbolAtlas;
+
+    // Shared by the tile pyramids of all render sources, so it must outlive them.
+    std::unique_ptr<TileCache> tileCache;
 
 private:
     Immutable<std::vector<Immutable<style::Image::Impl>>> imageImpls;
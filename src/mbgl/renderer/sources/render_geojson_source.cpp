@@ -1,7 +1,9 @@
 #include <mbgl/renderer/sources/render_geojson_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <mbgl/algorithm/generate_clip_ids.hpp>
 #include <mbgl/algorithm/generate_clip_ids_impl.hpp>
@@ -40,7 +42,7 @@ void RenderGeoJSONSource::update(Immutable<style::Source::Impl> baseImpl_,
 
     if (data_ != data) {
         data = data_;
-        tilePyramid.cache.clear();
+        parameters.tileCache.clear(tilePyramid);
 
         for (auto const& item : tilePyramid.tiles) {
             static_cast<GeoJSONTile*>(item.second.get())->updateData(data->getTile(item.first.canonical));
@@ -72,16 +74,14 @@ std::vector<std::reference_wrapper<RenderTile>> RenderGeoJSONSource::getRenderTi
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
-RenderGeoJSONSource::queryRenderedFeatures(const ScreenLineString& geometry,
-                                           const TransformState& transformState,
-                                           const RenderStyle& style,
-                                           const RenderedQueryOptions& options) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
+void RenderGeoJSONSource::queryRenderedFeatures(RenderedFeatureQuery& query,
+                                                const ScreenLineString& geometry,
+                                                const TransformState& transformState) const {
+    tilePyramid.queryRenderedFeatures(query, geometry, transformState);
 }
 
-std::vector<Feature> RenderGeoJSONSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderGeoJSONSource::querySourceFeatures(SourceFeatureQuery& query) const {
+    tilePyramid.querySourceFeatures(query);
 }
 
 void RenderGeoJSONSource::onLowMemory() {
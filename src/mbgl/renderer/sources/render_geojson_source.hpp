@@ -27,14 +27,11 @@ public:
 
     std::vector<std::reference_wrapper<RenderTile>> getRenderTiles() final;
 
-    std::unordered_map<std::string, std::vector<Feature>>
-    queryRenderedFeatures(const ScreenLineString& geometry,
-                          const TransformState& transformState,
-                          const RenderStyle& style,
-                          const RenderedQueryOptions& options) const final;
-
-    std::vector<Feature>
-    querySourceFeatures(const SourceQueryOptions&) const final;
+    void queryRenderedFeatures(RenderedFeatureQuery& query,
+                               const ScreenLineString& geometry,
+                               const TransformState& transformState) const final;
+
+    void querySourceFeatures(SourceFeatureQuery& query) const final;
 
     void onLowMemory() final;
     void dumpDebugLogs() const final;
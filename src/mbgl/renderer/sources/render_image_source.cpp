@@ -55,16 +55,12 @@ void RenderImageSource::finishRender(Painter& painter) {
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
-RenderImageSource::queryRenderedFeatures(const ScreenLineString&,
-                                         const TransformState&,
-                                         const RenderStyle&,
-                                         const RenderedQueryOptions&) const {
-    return {};
+void RenderImageSource::queryRenderedFeatures(RenderedFeatureQuery&,
+                                              const ScreenLineString&,
+                                              const TransformState&) const {
 }
 
-std::vector<Feature> RenderImageSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderImageSource::querySourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderImageSource::update(Immutable<style::Source::Impl> baseImpl_,
@@ -34,13 +34,11 @@ public:
         return {};
     }
 
-    std::unordered_map<std::string, std::vector<Feature>>
-    queryRenderedFeatures(const ScreenLineString& geometry,
-                          const TransformState& transformState,
-                          const RenderStyle& style,
-                          const RenderedQueryOptions& options) const final;
+    void queryRenderedFeatures(RenderedFeatureQuery& query,
+                               const ScreenLineString& geometry,
+                               const TransformState& transformState) const final;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const final;
+    void querySourceFeatures(SourceFeatureQuery& query) const final;
 
     void onLowMemory() final {
     }
@@ -1,6 +1,8 @@
 #include <mbgl/renderer/sources/render_raster_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/tile/raster_tile.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 namespace mbgl {
 
@@ -41,7 +43,7 @@ void RenderRasterSource::update(Immutable<style::Source::Impl> baseImpl_,
         // Should instead refresh tile data in place.
         tilePyramid.tiles.clear();
         tilePyramid.renderTiles.clear();
-        tilePyramid.cache.clear();
+        parameters.tileCache.clear(tilePyramid);
     }
 
     tilePyramid.update(layers,
@@ -68,16 +70,12 @@ std::vector<std::reference_wrapper<RenderTile>> RenderRasterSource::getRenderTil
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
-RenderRasterSource::queryRenderedFeatures(const ScreenLineString&,
-                                          const TransformState&,
-                                          const RenderStyle&,
-                                          const RenderedQueryOptions&) const {
-    return {};
+void RenderRasterSource::queryRenderedFeatures(RenderedFeatureQuery&,
+                                               const ScreenLineString&,
+                                               const TransformState&) const {
 }
 
-std::vector<Feature> RenderRasterSource::querySourceFeatures(const SourceQueryOptions&) const {
-    return {};
+void RenderRasterSource::querySourceFeatures(SourceFeatureQuery&) const {
 }
 
 void RenderRasterSource::onLowMemory() {
@@ -1,7 +1,9 @@
 #include <mbgl/renderer/sources/render_vector_source.hpp>
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/renderer/tile_parameters.hpp>
 #include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <mbgl/algorithm/generate_clip_ids.hpp>
 #include <mbgl/algorithm/generate_clip_ids_impl.hpp>
@@ -45,7 +47,7 @@ void RenderVectorSource::update(Immutable<style::Source::Impl> baseImpl_,
         // Should instead refresh tile data in place.
         tilePyramid.tiles.clear();
         tilePyramid.renderTiles.clear();
-        tilePyramid.cache.clear();
+        parameters.tileCache.clear(tilePyramid);
     }
 
     tilePyramid.update(layers,
@@ -73,16 +75,14 @@ std::vector<std::reference_wrapper<RenderTile>> RenderVectorSource::getRenderTil
     return tilePyramid.getRenderTiles();
 }
 
-std::unordered_map<std::string, std::vector<Feature>>
-RenderVectorSource::queryRenderedFeatures(const ScreenLineString& geometry,
-                                          const TransformState& transformState,
-                                          const RenderStyle& style,
-                                          const RenderedQueryOptions& options) const {
-    return tilePyramid.queryRenderedFeatures(geometry, transformState, style, options);
+void RenderVectorSource::queryRenderedFeatures(RenderedFeatureQuery& query,
+                                               const ScreenLineString& geometry,
+                                               const TransformState& transformState) const {
+    tilePyramid.queryRenderedFeatures(query, geometry, transformState);
 }
 
-std::vector<Feature> RenderVectorSource::querySourceFeatures(const SourceQueryOptions& options) const {
-    return tilePyramid.querySourceFeatures(options);
+void RenderVectorSource::querySourceFeatures(SourceFeatureQuery& query) const {
+    tilePyramid.querySourceFeatures(query);
 }
 
 void RenderVectorSource::onLowMemory() {
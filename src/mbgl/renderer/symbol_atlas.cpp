@@ -0,0 +1,338 @@
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/gl/context.hpp>
+#include <mbgl/util/rect.hpp>
+#include <mbgl/util/logging.hpp>
+
+#include <mapbox/shelf-pack.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+namespace {
+
+constexpr uint32_t padding = 1;
+constexpr int32_t initialSize = 128;
+
+// One of the two atlas images, along with the bins of the glyphs or images it currently holds.
+// `T` is the immutable source of each entry: either a glyph or a style image.
+template <class T, class Image>
+class Atlas {
+public:
+    struct Entry {
+        Immutable<T> source;
+        mapbox::Bin* bin;
+    };
+
+    Atlas(int32_t maximumSize_)
+        : maximumSize(maximumSize_),
+          pack(initialSize, initialSize),
+          image({ static_cast<uint32_t>(initialSize), static_cast<uint32_t>(initialSize) }) {
+    }
+
+    // Returns the bin of the given source, packing and copying it into the atlas image if it
+    // isn't in the atlas yet. Either way, the bin gains one reference. Returns nullptr if the
+    // atlas is full, i.e. the source doesn't fit even after growing the atlas to its maximum size.
+    const mapbox::Bin* add(const Immutable<T>& source, const Image& src) {
+        auto it = entries.find(source.get());
+        if (it != entries.end()) {
+            pack.ref(*it->second.bin);
+            return it->second.bin;
+        }
+
+        const int32_t width = src.size.width + 2 * padding;
+        const int32_t height = src.size.height + 2 * padding;
+        if (width > maximumSize || height > maximumSize) {
+            return nullptr;
+        }
+
+        mapbox::Bin* packed = pack.packOne(-1, width, height);
+        while (!packed && grow()) {
+            packed = pack.packOne(-1, width, height);
+        }
+        if (!packed) {
+            return nullptr;
+        }
+        mapbox::Bin& bin = *packed;
+
+        const Size packSize {
+            static_cast<uint32_t>(pack.width()),
+            static_cast<uint32_t>(pack.height())
+        };
+        if (image.size != packSize) {
+            image.resize(packSize);
+        }
+
+        // A reused bin may still contain the pixels of a larger entry that was released earlier.
+        const Rect<uint32_t> area {
+            static_cast<uint32_t>(bin.x),
+            static_cast<uint32_t>(bin.y),
+            static_cast<uint32_t>(bin.maxw),
+            static_cast<uint32_t>(bin.maxh)
+        };
+        for (uint32_t y = area.y; y < area.y + area.h; y++) {
+            uint8_t* row = image.data.get() + y * image.stride() + area.x * Image::channels;
+            std::fill(row, row + area.w * Image::channels, 0);
+        }
+
+        Image::copy(src, image, { 0, 0 }, { bin.x + padding, bin.y + padding }, src.size);
+        markDirty(area);
+
+        entries.emplace(source.get(), Entry { source, &bin });
+        return &bin;
+    }
+
+    // Releases one reference to the bin of the given source, removing it from the atlas once no
+    // references are left.
+    void release(const T* source) {
+        auto it = entries.find(source);
+        assert(it != entries.end());
+        if (pack.unref(*it->second.bin) == 0) {
+            entries.erase(it);
+            if (entries.empty()) {
+                // Start packing from scratch so that the atlas doesn't stay fragmented.
+                pack.clear();
+            }
+        }
+    }
+
+    void upload(gl::Context& context, optional<gl::Texture>& texture, gl::TextureUnit unit) {
+        if (!texture) {
+            texture = context.createTexture(image, unit);
+        } else if (texture->size != image.size) {
+            context.updateTexture(*texture, image, unit);
+        } else if (dirty) {
+            Image region({ dirty->w, dirty->h });
+            Image::copy(image, region, { dirty->x, dirty->y }, { 0, 0 }, region.size);
+            context.updateTexture(*texture, region, { dirty->x, dirty->y }, unit);
+        }
+
+        dirty = {};
+    }
+
+    // Returns the number of bytes of the atlas image that are used by the given source, divided
+    // evenly among the references to it.
+    std::size_t byteSize(const T* source) const {
+        const mapbox::Bin& bin = *entries.at(source).bin;
+        return std::size_t(bin.maxw) * bin.maxh * Image::channels / std::max(bin.refcount(), 1);
+    }
+
+    // Lowered to the GPU's maximum texture size on the first upload.
+    int32_t maximumSize;
+
+    mapbox::ShelfPack pack;
+    Image image;
+    std::unordered_map<const T*, Entry> entries;
+
+private:
+    // Doubles the shorter side of the atlas, unless that would exceed the maximum size. The
+    // image is resized to match once a bin has been packed.
+    bool grow() {
+        int32_t width = pack.width();
+        int32_t height = pack.height();
+        if (width <= height && width * 2 <= maximumSize) {
+            width *= 2;
+        } else if (height * 2 <= maximumSize) {
+            height *= 2;
+        } else if (width * 2 <= maximumSize) {
+            width *= 2;
+        } else {
+            return false;
+        }
+        return pack.resize(width, height);
+    }
+
+    void markDirty(const Rect<uint32_t>& area) {
+        if (!dirty) {
+            dirty = area;
+            return;
+        }
+
+        const uint32_t x1 = std::max(dirty->x + dirty->w, area.x + area.w);
+        const uint32_t y1 = std::max(dirty->y + dirty->h, area.y + area.h);
+        dirty->x = std::min(dirty->x, area.x);
+        dirty->y = std::min(dirty->y, area.y);
+        dirty->w = x1 - dirty->x;
+        dirty->h = y1 - dirty->y;
+    }
+
+    // The bounding box of the regions that changed since the last upload.
+    optional<Rect<uint32_t>> dirty;
+};
+
+} // namespace
+
+class SymbolAtlas::State {
+public:
+    State(int32_t maximumSize)
+        : glyphs(maximumSize), icons(maximumSize) {
+    }
+
+    std::mutex mutex;
+    Atlas<Glyph, AlphaImage> glyphs;
+    Atlas<style::Image::Impl, PremultipliedImage> icons;
+    bool warnedFull = false;
+};
+
+class SymbolAtlas::Reference {
+public:
+    Reference(std::shared_ptr<State> state_)
+        : state(std::move(state_)) {
+    }
+
+    ~Reference() {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        for (const Glyph* glyph : glyphs) {
+            state->glyphs.release(glyph);
+        }
+        for (const style::Image::Impl* icon : icons) {
+            state->icons.release(icon);
+        }
+    }
+
+    // Keeps the atlas state alive even if the SymbolAtlas is destroyed before its references.
+    const std::shared_ptr<State> state;
+    std::vector<const Glyph*> glyphs;
+    std::vector<const style::Image::Impl*> icons;
+};
+
+SymbolAtlas::SymbolAtlas(uint16_t maximumSize)
+    : state(std::make_shared<State>(std::max<int32_t>(maximumSize, initialSize))) {
+}
+
+SymbolAtlas::~SymbolAtlas() = default;
+
+std::shared_ptr<const SymbolAtlas::Reference> SymbolAtlas::add(const GlyphMap& glyphMap,
+                                                               const ImageMap& imageMap,
+                                                               GlyphPositions& glyphPositions,
+                                                               ImagePositions& imagePositions) {
+    auto reference = std::make_shared<Reference>(state);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+
+    // Glyphs and images that don't fit into the atlas get no position, and aren't drawn.
+    bool full = false;
+
+    for (const auto& glyphMapEntry : glyphMap) {
+        GlyphPositionMap& positions = glyphPositions[glyphMapEntry.first];
+
+        for (const auto& entry : glyphMapEntry.second) {
+            if (entry.second && (*entry.second)->bitmap.valid()) {
+                const Glyph& glyph = **entry.second;
+                const mapbox::Bin* bin = state->glyphs.add(*entry.second, glyph.bitmap);
+                if (!bin) {
+                    full = true;
+                    continue;
+                }
+                reference->glyphs.push_back(&glyph);
+
+                positions.emplace(glyph.id,
+                                  GlyphPosition {
+                                     Rect<uint16_t> {
+                                         static_cast<uint16_t>(bin->x),
+                                         static_cast<uint16_t>(bin->y),
+                                         static_cast<uint16_t>(bin->w),
+                                         static_cast<uint16_t>(bin->h)
+                                     },
+                                     glyph.metrics
+                                  });
+            }
+        }
+    }
+
+    for (const auto& entry : imageMap) {
+        const style::Image::Impl& image = *entry.second;
+        const mapbox::Bin* bin = state->icons.add(entry.second, image.image);
+        if (!bin) {
+            full = true;
+            continue;
+        }
+        reference->icons.push_back(&image);
+
+        imagePositions.emplace(image.id, ImagePosition { *bin, image });
+    }
+
+    if (full && !state->warnedFull) {
+        Log::Warning(Event::General, "Symbol atlas is full; some glyphs or icons won't be drawn");
+        state->warnedFull = true;
+    }
+
+    return reference;
+}
+
+void SymbolAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+
+    if (!glyphTexture && !iconTexture) {
+        // Atlases packed before the first upload are already bounded by the initial maximum size,
+        // which every GPU we support can hold.
+        const auto limit = static_cast<int32_t>(std::min<uint32_t>(context.maximumTextureSize(),
+                                                                   std::numeric_limits<int32_t>::max()));
+        state->glyphs.maximumSize = std::max(std::min(state->glyphs.maximumSize, limit), initialSize);
+        state->icons.maximumSize = std::max(std::min(state->icons.maximumSize, limit), initialSize);
+    }
+
+    state->glyphs.upload(context, glyphTexture, unit);
+    state->icons.upload(context, iconTexture, unit);
+}
+
+void SymbolAtlas::bindGlyphs(gl::Context& context, gl::TextureUnit unit) {
+    if (!glyphTexture) {
+        upload(context, unit);
+    }
+    context.bindTexture(*glyphTexture, unit, gl::TextureFilter::Linear);
+}
+
+void SymbolAtlas::bindIcons(gl::Context& context, gl::TextureUnit unit, gl::TextureFilter filter) {
+    if (!iconTexture) {
+        upload(context, unit);
+    }
+    context.bindTexture(*iconTexture, unit, filter);
+}
+
+Size SymbolAtlas::getGlyphAtlasSize() const {
+    return glyphTexture ? glyphTexture->size : Size();
+}
+
+Size SymbolAtlas::getIconAtlasSize() const {
+    return iconTexture ? iconTexture->size : Size();
+}
+
+AlphaImage SymbolAtlas::getGlyphAtlasImage() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->glyphs.image.clone();
+}
+
+PremultipliedImage SymbolAtlas::getIconAtlasImage() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->icons.image.clone();
+}
+
+std::size_t SymbolAtlas::byteSize(const Reference& reference) {
+    std::lock_guard<std::mutex> lock(reference.state->mutex);
+    std::size_t size = 0;
+    for (const Glyph* glyph : reference.glyphs) {
+        size += reference.state->glyphs.byteSize(glyph);
+    }
+    for (const style::Image::Impl* icon : reference.icons) {
+        size += reference.state->icons.byteSize(icon);
+    }
+    return size;
+}
+
+std::size_t SymbolAtlas::glyphCount() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->glyphs.entries.size();
+}
+
+std::size_t SymbolAtlas::iconCount() const {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->icons.entries.size();
+}
+
+} // namespace mbgl
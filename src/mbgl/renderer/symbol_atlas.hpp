@@ -0,0 +1,72 @@
+#pragma once
+
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/renderer/image_atlas.hpp>
+#include <mbgl/gl/texture.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <memory>
+
+namespace mbgl {
+
+namespace gl {
+class Context;
+} // namespace gl
+
+/*
+    SymbolAtlas packs the glyphs and icons used by symbol buckets into a pair of textures that are
+    shared by all tiles of a style, instead of each tile building and uploading its own atlases.
+
+    Tile workers call add() with the glyphs and images they need. Each glyph or image is packed
+    once, no matter how many tiles use it, and stays in the atlas for as long as a Reference to it
+    is alive. Released bins are reused for later glyphs and images. The render thread uploads only
+    the region of each atlas that changed since the previous upload.
+
+    Each atlas grows as needed up to the given maximum size, or the GPU's maximum texture size if
+    that is smaller. Glyphs and images that don't fit once an atlas has reached it are skipped.
+*/
+class SymbolAtlas : private util::noncopyable {
+public:
+    // Keeps the glyphs and images returned from a call to add() in the atlas.
+    class Reference;
+
+    // Positions in the atlas are stored as 16 bit values, so it can't be any larger.
+    SymbolAtlas(uint16_t maximumSize = 2048);
+    ~SymbolAtlas();
+
+    // Adds the glyphs and images to the atlas if they aren't already in it, and fills in their
+    // positions. The positions remain valid for the lifetime of the returned reference.
+    // May be called from any thread.
+    std::shared_ptr<const Reference> add(const GlyphMap&,
+                                         const ImageMap&,
+                                         GlyphPositions&,
+                                         ImagePositions&);
+
+    // Must only be called from the render thread.
+    void upload(gl::Context&, gl::TextureUnit);
+    void bindGlyphs(gl::Context&, gl::TextureUnit);
+    void bindIcons(gl::Context&, gl::TextureUnit, gl::TextureFilter);
+
+    // Returns the atlas memory used by the glyphs and images of the reference. Entries that are
+    // shared with other references are divided evenly among them.
+    static std::size_t byteSize(const Reference&);
+
+    Size getGlyphAtlasSize() const;
+    Size getIconAtlasSize() const;
+
+    // Only for use in tests.
+    AlphaImage getGlyphAtlasImage() const;
+    PremultipliedImage getIconAtlasImage() const;
+    std::size_t glyphCount() const;
+    std::size_t iconCount() const;
+
+private:
+    class State;
+    const std::shared_ptr<State> state;
+
+    optional<gl::Texture> glyphTexture;
+    optional<gl::Texture> iconTexture;
+};
+
+} // namespace mbgl
@@ -10,6 +10,8 @@ class FileSource;
 class AnnotationManager;
 class ImageManager;
 class GlyphManager;
+class SymbolAtlas;
+class TileCache;
 
 class TileParameters {
 public:
@@ -22,7 +24,10 @@ public:
     AnnotationManager& annotationManager;
     ImageManager& imageManager;
     GlyphManager& glyphManager;
+    SymbolAtlas& symbolAtlas;
+    TileCache& tileCache;
     const uint8_t prefetchZoomDelta = 0;
+    const bool parallelLayout = false;
 };
 
 } // namespace mbgl
@@ -3,6 +3,7 @@
 #include <mbgl/renderer/painter.hpp>
 #include <mbgl/renderer/render_source.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/text/placement_config.hpp>
@@ -27,7 +28,12 @@ TilePyramid::TilePyramid()
     : observer(&nullObserver) {
 }
 
-TilePyramid::~TilePyramid() = default;
+TilePyramid::~TilePyramid() {
+    // Cached tiles refer to our observer, so they can't outlive us.
+    if (cache) {
+        cache->clear(*this);
+    }
+}
 
 bool TilePyramid::isLoaded() const {
     for (const auto& pair : tiles) {
@@ -65,17 +71,24 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
                          const uint16_t tileSize,
                          const Range<uint8_t> zoomRange,
                          std::function<std::unique_ptr<Tile> (const OverscaledTileID&)> createTile) {
-    // If we need a relayout, abandon any cached tiles; they're now stale.
-    if (needsRelayout) {
-        cache.clear();
+    // Annotation tiles are regenerated whenever annotations change, so they're never cached.
+    TileCache* newCache = type != SourceType::Annotations ? &parameters.tileCache : nullptr;
+    if (cache && cache != newCache) {
+        cache->clear(*this);
     }
+    cache = newCache;
+
+    // Cached tiles keep the layers they were laid out with, even when a relayout is needed. They
+    // are sent the current layers once they're used again, and their workers then only rebuild
+    // the buckets of layers with a layout difference. This way, tiles that aren't shown don't
+    // compete with the visible ones for the workers, and their size in the cache stays valid.
 
     // If we're not going to render anything, move our existing tiles into
-    // the cache (if they're not stale) or abandon them, and return.
+    // the cache and return.
     if (!needsRendering) {
-        if (!needsRelayout) {
+        if (cache) {
             for (auto& entry : tiles) {
-                cache.add(entry.first, std::move(entry.second));
+                cache->add(*this, entry.first, std::move(entry.second));
             }
         }
 
@@ -123,8 +136,29 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
     // we're actively using, e.g. as a replacement for tile that aren't loaded yet.
     std::set<OverscaledTileID> retain;
 
+    // Pan tiles are only prefetched, so their work shouldn't delay any of the tiles we're going
+    // to render. Ideal tiles are sorted by distance to the center of the viewport; load and lay
+    // out the innermost quarter of them before everything else. Priorities are set before the
+    // necessity, so that the network requests of required tiles are queued with them.
+    std::set<OverscaledTileID> prefetchTiles;
+    for (const auto& panTile : panTiles) {
+        prefetchTiles.emplace(panZoom, panTile.canonical);
+    }
+
+    std::set<OverscaledTileID> centralTiles;
+    for (std::size_t i = 0; i < (idealTiles.size() + 3) / 4; ++i) {
+        centralTiles.emplace(tileZoom, idealTiles[i].canonical);
+    }
+
     auto retainTileFn = [&](Tile& tile, Resource::Necessity necessity) -> void {
         if (retain.emplace(tile.id).second) {
+            if (centralTiles.count(tile.id)) {
+                tile.setPriority(Tile::Priority::High);
+            } else if (prefetchTiles.count(tile.id) || necessity == Resource::Necessity::Optional) {
+                tile.setPriority(Tile::Priority::Low);
+            } else {
+                tile.setPriority(Tile::Priority::Normal);
+            }
             tile.setNecessity(necessity);
         }
 
@@ -137,17 +171,16 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
         return it == tiles.end() ? nullptr : it->second.get();
     };
     auto createTileFn = [&](const OverscaledTileID& tileID) -> Tile* {
-        std::unique_ptr<Tile> tile = cache.get(tileID);
+        std::unique_ptr<Tile> tile = cache ? cache->get(*this, tileID) : nullptr;
         if (!tile) {
             tile = createTile(tileID);
-            if (tile) {
-                tile->setObserver(observer);
-                tile->setLayers(layers);
-            }
         }
         if (!tile) {
             return nullptr;
         }
+        // The cache observes the tiles it holds.
+        tile->setObserver(observer);
+        tile->setLayers(layers);
         return tiles.emplace(tileID, std::move(tile)).first->second.get();
     };
     auto renderTileFn = [&](const UnwrappedTileID& tileID, Tile& tile) {
@@ -164,15 +197,6 @@ void TilePyramid::update(const std::vector<Immutable<style::Layer::Impl>>& layer
     algorithm::updateRenderables(getTileFn, createTileFn, retainTileFn, renderTileFn,
                                  idealTiles, zoomRange, tileZoom);
 
-    if (type != SourceType::Annotations) {
-        size_t conservativeCacheSize =
-            std::max((float)parameters.transformState.getSize().width / tileSize, 1.0f) *
-            std::max((float)parameters.transformState.getSize().height / tileSize, 1.0f) *
-            (parameters.transformState.getMaxZoom() - parameters.transformState.getMinZoom() + 1) *
-            0.5;
-        cache.setSize(conservativeCacheSize);
-    }
-
     removeStaleTiles(retain);
 
     const PlacementConfig config { parameters.transformState.getAngle(),
@@ -193,7 +217,10 @@ void TilePyramid::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
     while (tilesIt != tiles.end()) {
         if (retainIt == retain.end() || tilesIt->first < *retainIt) {
             tilesIt->second->setNecessity(Tile::Necessity::Optional);
-            cache.add(tilesIt->first, std::move(tilesIt->second));
+            tilesIt->second->setPriority(Tile::Priority::Low);
+            if (cache) {
+                cache->add(*this, tilesIt->first, std::move(tilesIt->second));
+            }
             tiles.erase(tilesIt++);
         } else {
             if (!(*retainIt < tilesIt->first)) {
@@ -204,13 +231,11 @@ void TilePyramid::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
     }
 }
 
-std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRenderedFeatures(const ScreenLineString& geometry,
-                                           const TransformState& transformState,
-                                           const RenderStyle& style,
-                                           const RenderedQueryOptions& options) const {
-    std::unordered_map<std::string, std::vector<Feature>> result;
+void TilePyramid::queryRenderedFeatures(RenderedFeatureQuery& query,
+                                        const ScreenLineString& geometry,
+                                        const TransformState& transformState) const {
     if (renderTiles.empty() || geometry.empty()) {
-        return result;
+        return;
     }
 
     LineString<double> queryGeometry;
@@ -246,32 +271,22 @@ std::unordered_map<std::string, std::vector<Feature>> TilePyramid::queryRendered
             tileSpaceQueryGeometry.push_back(TileCoordinate::toGeometryCoordinate(renderTile.id, c));
         }
 
-        renderTile.tile.queryRenderedFeatures(result,
+        renderTile.tile.queryRenderedFeatures(query,
                                               tileSpaceQueryGeometry,
-                                              transformState,
-                                              style,
-                                              options);
+                                              transformState);
     }
-
-    return result;
 }
 
-std::vector<Feature> TilePyramid::querySourceFeatures(const SourceQueryOptions& options) const {
-    std::vector<Feature> result;
-
+void TilePyramid::querySourceFeatures(SourceFeatureQuery& query) const {
     for (const auto& pair : tiles) {
-        pair.second->querySourceFeatures(result, options);
+        pair.second->querySourceFeatures(query);
     }
-
-    return result;
-}
-
-void TilePyramid::setCacheSize(size_t size) {
-    cache.setSize(size);
 }
 
 void TilePyramid::onLowMemory() {
-    cache.clear();
+    if (cache) {
+        cache->clear(*this);
+    }
 }
 
 void TilePyramid::setObserver(TileObserver* observer_) {
@@ -3,7 +3,6 @@
 #include <mbgl/tile/tile_id.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/tile/tile.hpp>
-#include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/style/types.hpp>
 #include <mbgl/style/layer_impl.hpp>
 
@@ -21,10 +20,10 @@ namespace mbgl {
 class Painter;
 class TransformState;
 class RenderTile;
-class RenderStyle;
-class RenderedQueryOptions;
-class SourceQueryOptions;
+class RenderedFeatureQuery;
+class SourceFeatureQuery;
 class TileParameters;
+class TileCache;
 
 class TilePyramid {
 public:
@@ -47,15 +46,12 @@ public:
 
     std::vector<std::reference_wrapper<RenderTile>> getRenderTiles();
 
-    std::unordered_map<std::string, std::vector<Feature>>
-    queryRenderedFeatures(const ScreenLineString& geometry,
-                          const TransformState& transformState,
-                          const RenderStyle& style,
-                          const RenderedQueryOptions& options) const;
+    void queryRenderedFeatures(RenderedFeatureQuery& query,
+                               const ScreenLineString& geometry,
+                               const TransformState& transformState) const;
 
-    std::vector<Feature> querySourceFeatures(const SourceQueryOptions&) const;
+    void querySourceFeatures(SourceFeatureQuery& query) const;
 
-    void setCacheSize(size_t);
     void onLowMemory();
 
     void setObserver(TileObserver*);
@@ -66,7 +62,10 @@ public:
     void removeStaleTiles(const std::set<OverscaledTileID>&);
 
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    TileCache cache;
+
+    // The cache shared by all tile pyramids of the map, or null if tiles of this pyramid are never
+    // cached.
+    TileCache* cache = nullptr;
 
     std::vector<RenderTile> renderTiles;
 
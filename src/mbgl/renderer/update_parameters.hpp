@@ -35,6 +35,8 @@ public:
     AnnotationManager& annotationManager;
 
     const uint8_t prefetchZoomDelta = 0;
+    const uint64_t tileCacheSize = 0;
+    const bool parallelTileLayout = false;
 };
 
 } // namespace mbgl
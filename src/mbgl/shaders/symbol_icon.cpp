@@ -10,6 +10,9 @@ const char* symbol_icon::vertexSource = R"MBGL_SHADER(
 
 attribute vec4 a_pos_offset;
 attribute vec4 a_data;
+// The zoom level from which the label is shown, in tenths, or 255 if it's hidden at the current
+// placement. It lives in a separate buffer, which is the only one replaced on a new placement.
+attribute float a_labelminzoom;
 
 // icon-size data (see symbol_sdf.vertex.glsl for more)
 attribute vec3 a_size;
@@ -53,10 +56,10 @@ void main() {
     vec2 a_offset = a_pos_offset.zw;
 
     vec2 a_tex = a_data.xy;
-    mediump vec2 label_data = unpack_float(a_data[2]);
-    mediump float a_labelminzoom = label_data[0];
     mediump vec2 a_zoom = unpack_float(a_data[3]);
-    mediump float a_minzoom = a_zoom[0];
+    // Lower min zoom so that while fading out the label
+    // it can be shown outside of collision-free zoom levels
+    mediump float a_minzoom = a_zoom[0] > a_labelminzoom ? a_zoom[0] : 0.0;
     mediump float a_maxzoom = a_zoom[1];
 
     float size;
@@ -98,6 +101,11 @@ void main() {
         gl_Position = u_matrix * vec4(a_pos, 0, 1) + vec4(extrude, 0, 0);
     }
 
+    // Move the vertices of hidden quads out of the clip space.
+    if (a_labelminzoom == 255.0) {
+        gl_Position = vec4(-2.0, -2.0, -2.0, 1.0);
+    }
+
     v_tex = a_tex / u_texsize;
     v_fade_tex = vec2(a_labelminzoom / 255.0, 0.0);
 }
@@ -25,6 +25,7 @@ struct SpriteLoader::Loader {
           worker(scheduler, ActorRef<SpriteLoader>(imageManager, mailbox)) {
     }
 
+    std::string url;
     std::shared_ptr<const std::string> image;
     std::shared_ptr<const std::string> json;
     std::unique_ptr<AsyncRequest> jsonRequest;
@@ -48,6 +49,7 @@ void SpriteLoader::load(const std::string& url, Scheduler& scheduler, FileSource
     }
 
     loader = std::make_unique<Loader>(scheduler, *this);
+    loader->url = Resource::spriteImage(url, pixelRatio).url;
 
     loader->jsonRequest = fileSource.request(Resource::spriteJSON(url, pixelRatio), [this](Response res) {
         if (res.error) {
@@ -86,11 +88,19 @@ void SpriteLoader::emitSpriteLoadedIfComplete() {
         return;
     }
 
-    loader->worker.invoke(&SpriteLoaderWorker::parse, loader->image, loader->json);
+    loader->worker.invoke(&SpriteLoaderWorker::parse, loader->url, loader->image, loader->json);
 }
 
-void SpriteLoader::onParsed(std::vector<std::unique_ptr<style::Image>>&& result) {
-    observer->onSpriteLoaded(std::move(result));
+void SpriteLoader::onParsed(std::shared_ptr<const std::vector<std::unique_ptr<style::Image>>> result) {
+    images = std::move(result);
+
+    // The copies share their pixels with the registered images.
+    std::vector<std::unique_ptr<style::Image>> copies;
+    copies.reserve(images->size());
+    for (const auto& image : *images) {
+        copies.push_back(std::make_unique<style::Image>(*image));
+    }
+    observer->onSpriteLoaded(std::move(copies));
 }
 
 void SpriteLoader::onError(std::exception_ptr err) {
@@ -30,7 +30,7 @@ private:
 
     // Invoked by SpriteAtlasWorker
     friend class SpriteLoaderWorker;
-    void onParsed(std::vector<std::unique_ptr<style::Image>>&&);
+    void onParsed(std::shared_ptr<const std::vector<std::unique_ptr<style::Image>>>);
     void onError(std::exception_ptr);
 
     const float pixelRatio;
@@ -38,6 +38,9 @@ private:
     struct Loader;
     std::unique_ptr<Loader> loader;
 
+    // The parsed sprite, shared with other maps that loaded the same one.
+    std::shared_ptr<const std::vector<std::unique_ptr<style::Image>>> images;
+
     SpriteLoaderObserver* observer = nullptr;
 };
 
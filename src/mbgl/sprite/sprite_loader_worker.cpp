@@ -1,6 +1,8 @@
 #include <mbgl/sprite/sprite_loader_worker.hpp>
 #include <mbgl/sprite/sprite_loader.hpp>
 #include <mbgl/sprite/sprite_parser.hpp>
+#include <mbgl/style/image.hpp>
+#include <mbgl/util/resource_registry.hpp>
 
 namespace mbgl {
 
@@ -8,8 +10,9 @@ SpriteLoaderWorker::SpriteLoaderWorker(ActorRef<SpriteLoaderWorker>, ActorRef<Sp
     : parent(std::move(parent_)) {
 }
 
-void SpriteLoaderWorker::parse(std::shared_ptr<const std::string> image,
-                              std::shared_ptr<const std::string> json) {
+void SpriteLoaderWorker::parse(std::string url,
+                               std::shared_ptr<const std::string> image,
+                               std::shared_ptr<const std::string> json) {
     try {
         if (!image) {
             // This shouldn't happen, since we always invoke it with a non-empty pointer.
@@ -20,7 +23,16 @@ void SpriteLoaderWorker::parse(std::shared_ptr<const std::string> image,
             throw std::runtime_error("missing sprite metadata");
         }
 
-        parent.invoke(&SpriteLoader::onParsed, parseSprite(*image, *json));
+        using Images = std::vector<std::unique_ptr<style::Image>>;
+        auto& registry = util::ResourceRegistry<Images>::get();
+        const util::ResourceRegistry<Images>::Key key { std::move(url), *image, *json };
+
+        std::shared_ptr<const Images> images = registry.find(key);
+        if (!images) {
+            images = registry.insert(key, parseSprite(*image, *json));
+        }
+
+        parent.invoke(&SpriteLoader::onParsed, std::move(images));
     } catch (...) {
         parent.invoke(&SpriteLoader::onError, std::current_exception());
     }
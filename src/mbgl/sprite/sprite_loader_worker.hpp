@@ -14,7 +14,9 @@ class SpriteLoaderWorker {
 public:
     SpriteLoaderWorker(ActorRef<SpriteLoaderWorker>, ActorRef<SpriteLoader>);
 
-    void parse(std::shared_ptr<const std::string> image, std::shared_ptr<const std::string> json);
+    void parse(std::string url,
+               std::shared_ptr<const std::string> image,
+               std::shared_ptr<const std::string> json);
 
 private:
     ActorRef<SpriteLoader> parent;
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <mbgl/storage/file_source.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace mbgl {
+
+namespace util {
+template <typename T> class Thread;
+} // namespace util
+
+// Serves tiles and TileJSON from local MBTiles archives, so that self-hosted rendering doesn't
+// need a tile server. URLs have the form
+//
+//     mbtiles:///path/to/archive.mbtiles           TileJSON, built from the metadata table
+//     mbtiles:///path/to/archive.mbtiles/z/x/y     tile data
+//
+// The generated TileJSON uses the TMS scheme, as the archive does, so tile URLs address rows
+// of the tiles table directly.
+//
+// Archives are opened read-only. Each worker thread keeps its own connection and prepared
+// statements per archive, and requests are spread across the workers so that tiles are read
+// concurrently. Gzip-compressed tiles, as commonly stored for vector tiles, are decompressed.
+class MBTilesFileSource : public FileSource {
+public:
+    MBTilesFileSource(std::size_t connections = 4);
+    ~MBTilesFileSource() override;
+
+    std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
+
+    static bool acceptsURL(const std::string& url);
+
+private:
+    class Worker;
+
+    std::vector<std::unique_ptr<util::Thread<Worker>>> workers;
+    std::atomic<std::size_t> nextWorker { 0 };
+};
+
+} // namespace mbgl
@@ -15,6 +15,7 @@ Response& Response::operator=(const Response& res) {
     noContent = res.noContent;
     notModified = res.notModified;
     data = res.data;
+    mappedData = res.mappedData;
     modified = res.modified;
     expires = res.expires;
     etag = res.etag;
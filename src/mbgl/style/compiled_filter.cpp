@@ -0,0 +1,247 @@
+#include <mbgl/style/compiled_filter.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+namespace style {
+
+class CompiledFilter::Compiler {
+public:
+    CompiledFilter& compiled;
+
+    void operator()(const NullFilter&) {
+        emit(Op::True);
+    }
+
+    void operator()(const EqualsFilter& filter) {
+        emit(Op::Equals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const NotEqualsFilter& filter) {
+        emit(Op::Equals, key(filter.key), value(filter.value));
+        emit(Op::Not);
+    }
+
+    void operator()(const LessThanFilter& filter) {
+        emit(Op::LessThan, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const LessThanEqualsFilter& filter) {
+        emit(Op::LessThanEquals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const GreaterThanFilter& filter) {
+        emit(Op::GreaterThan, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const GreaterThanEqualsFilter& filter) {
+        emit(Op::GreaterThanEquals, key(filter.key), value(filter.value));
+    }
+
+    void operator()(const InFilter& filter) {
+        emit(Op::In, key(filter.key), valueSet(filter.values));
+    }
+
+    void operator()(const NotInFilter& filter) {
+        emit(Op::In, key(filter.key), valueSet(filter.values));
+        emit(Op::Not);
+    }
+
+    void operator()(const AnyFilter& filter) {
+        combine(filter.filters, Op::JumpIfTrue);
+    }
+
+    void operator()(const AllFilter& filter) {
+        combine(filter.filters, Op::JumpIfFalse);
+    }
+
+    void operator()(const NoneFilter& filter) {
+        combine(filter.filters, Op::JumpIfTrue);
+        emit(Op::Not);
+    }
+
+    void operator()(const HasFilter& filter) {
+        emit(Op::Has, key(filter.key));
+    }
+
+    void operator()(const NotHasFilter& filter) {
+        emit(Op::Has, key(filter.key));
+        emit(Op::Not);
+    }
+
+    void operator()(const TypeEqualsFilter& filter) {
+        emit(Op::TypeIn, 0, typeMask({ filter.value }));
+    }
+
+    void operator()(const TypeNotEqualsFilter& filter) {
+        emit(Op::TypeIn, 0, typeMask({ filter.value }));
+        emit(Op::Not);
+    }
+
+    void operator()(const TypeInFilter& filter) {
+        emit(Op::TypeIn, 0, typeMask(filter.values));
+    }
+
+    void operator()(const TypeNotInFilter& filter) {
+        emit(Op::TypeIn, 0, typeMask(filter.values));
+        emit(Op::Not);
+    }
+
+    void operator()(const IdentifierEqualsFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifierSet({ filter.value }));
+    }
+
+    void operator()(const IdentifierNotEqualsFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifierSet({ filter.value }));
+        emit(Op::Not);
+    }
+
+    void operator()(const IdentifierInFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifierSet(filter.values));
+    }
+
+    void operator()(const IdentifierNotInFilter& filter) {
+        emit(Op::IdentifierIn, 0, identifierSet(filter.values));
+        emit(Op::Not);
+    }
+
+    void operator()(const HasIdentifierFilter&) {
+        emit(Op::HasIdentifier);
+    }
+
+    void operator()(const NotHasIdentifierFilter&) {
+        emit(Op::HasIdentifier);
+        emit(Op::Not);
+    }
+
+private:
+    void emit(Op op, uint16_t key_ = 0, uint32_t operand = 0) {
+        compiled.program.push_back({ op, key_, operand });
+    }
+
+    // Emits `filters` so that evaluation stops at the first operand for which the result
+    // triggers `jump`. Empty "all" evaluates to true, empty "any" to false.
+    void combine(const std::vector<Filter>& filters, Op jump) {
+        if (filters.empty()) {
+            emit(Op::True);
+            if (jump == Op::JumpIfTrue) {
+                emit(Op::Not);
+            }
+            return;
+        }
+
+        // Filters have no side effects, so their operands can be evaluated in any order.
+        std::vector<const Filter*> ordered;
+        ordered.reserve(filters.size());
+        for (const auto& filter : filters) {
+            ordered.push_back(&filter);
+        }
+        std::stable_sort(ordered.begin(), ordered.end(), [] (const Filter* lhs, const Filter* rhs) {
+            return cost(*lhs) < cost(*rhs);
+        });
+
+        std::vector<std::size_t> jumps;
+        for (std::size_t i = 0; i < ordered.size(); ++i) {
+            if (i != 0) {
+                jumps.push_back(compiled.program.size());
+                emit(jump);
+            }
+            Filter::visit(*ordered[i], *this);
+        }
+
+        const auto end = static_cast<uint32_t>(compiled.program.size());
+        for (std::size_t index : jumps) {
+            compiled.program[index].operand = end;
+        }
+    }
+
+    uint16_t key(const std::string& name) {
+        auto it = std::find(compiled.keys.begin(), compiled.keys.end(), name);
+        if (it != compiled.keys.end()) {
+            return static_cast<uint16_t>(it - compiled.keys.begin());
+        }
+        compiled.keys.push_back(name);
+        return static_cast<uint16_t>(compiled.keys.size() - 1);
+    }
+
+    uint32_t value(const Value& v) {
+        compiled.values.push_back(v);
+        return static_cast<uint32_t>(compiled.values.size() - 1);
+    }
+
+    uint32_t valueSet(const std::vector<Value>& values) {
+        ValueSet set { values, true, {} };
+        for (const auto& v : values) {
+            if (!v.is<std::string>()) {
+                set.stringsOnly = false;
+                set.strings.clear();
+                break;
+            }
+            set.strings.insert(v.get<std::string>());
+        }
+        compiled.valueSets.push_back(std::move(set));
+        return static_cast<uint32_t>(compiled.valueSets.size() - 1);
+    }
+
+    uint32_t typeMask(const std::vector<FeatureType>& types) {
+        uint32_t mask = 0;
+        for (const auto& type : types) {
+            mask |= 1u << static_cast<uint8_t>(type);
+        }
+        return mask;
+    }
+
+    uint32_t identifierSet(std::vector<FeatureIdentifier> identifiers) {
+        compiled.identifierSets.push_back(std::move(identifiers));
+        return static_cast<uint32_t>(compiled.identifierSets.size() - 1);
+    }
+
+    // A rough estimate of the cost of evaluating a filter: tests of the feature's type or
+    // identifier don't touch its properties, and are the cheapest to evaluate.
+    static std::size_t cost(const Filter& filter) {
+        return Filter::visit(filter, Cost());
+    }
+
+    struct Cost {
+        std::size_t operator()(const NullFilter&) const { return 0; }
+        std::size_t operator()(const TypeEqualsFilter&) const { return 1; }
+        std::size_t operator()(const TypeNotEqualsFilter&) const { return 1; }
+        std::size_t operator()(const TypeInFilter&) const { return 1; }
+        std::size_t operator()(const TypeNotInFilter&) const { return 1; }
+        std::size_t operator()(const HasIdentifierFilter&) const { return 1; }
+        std::size_t operator()(const NotHasIdentifierFilter&) const { return 1; }
+        std::size_t operator()(const IdentifierEqualsFilter&) const { return 2; }
+        std::size_t operator()(const IdentifierNotEqualsFilter&) const { return 2; }
+        std::size_t operator()(const IdentifierInFilter& filter) const { return 2 + filter.values.size(); }
+        std::size_t operator()(const IdentifierNotInFilter& filter) const { return 2 + filter.values.size(); }
+        std::size_t operator()(const HasFilter&) const { return 4; }
+        std::size_t operator()(const NotHasFilter&) const { return 4; }
+        std::size_t operator()(const EqualsFilter&) const { return 5; }
+        std::size_t operator()(const NotEqualsFilter&) const { return 5; }
+        std::size_t operator()(const LessThanFilter&) const { return 5; }
+        std::size_t operator()(const LessThanEqualsFilter&) const { return 5; }
+        std::size_t operator()(const GreaterThanFilter&) const { return 5; }
+        std::size_t operator()(const GreaterThanEqualsFilter&) const { return 5; }
+        std::size_t operator()(const InFilter&) const { return 6; }
+        std::size_t operator()(const NotInFilter&) const { return 6; }
+        std::size_t operator()(const AnyFilter& filter) const { return sum(filter.filters); }
+        std::size_t operator()(const AllFilter& filter) const { return sum(filter.filters); }
+        std::size_t operator()(const NoneFilter& filter) const { return sum(filter.filters); }
+
+        std::size_t sum(const std::vector<Filter>& filters) const {
+            std::size_t result = 0;
+            for (const auto& filter : filters) {
+                result += Filter::visit(filter, *this);
+            }
+            return result;
+        }
+    };
+};
+
+CompiledFilter::CompiledFilter(const Filter& filter) {
+    Compiler compiler { *this };
+    Filter::visit(filter, compiler);
+}
+
+} // namespace style
+} // namespace mbgl
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <mbgl/style/filter.hpp>
+#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/util/feature.hpp>
+#include <mbgl/util/geometry.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+/*
+   A `Filter` compiled into a flat program, for evaluating the same filter on many features.
+
+   Compared to visiting the `Filter` tree, the program:
+
+   - looks up each distinct property key at most once per feature, no matter how many
+     comparisons refer to it;
+   - evaluates the operands of "all", "any" and "none" in order of increasing cost, so that
+     e.g. a `$type` test short-circuits before any property is looked up;
+   - tests membership in string-valued "in" filters with a hash set.
+
+   Evaluation results are identical to those of `Filter::operator()`.
+*/
+class CompiledFilter {
+public:
+    explicit CompiledFilter(const Filter&);
+
+    bool operator()(const Feature&) const;
+
+    template <class GeometryTileFeature>
+    bool operator()(const GeometryTileFeature& feature) const {
+        return operator()(feature.getType(), feature.getID(), [&] (const std::string& key) {
+            return feature.getValue(key);
+        });
+    }
+
+    template <class PropertyAccessor>
+    bool operator()(FeatureType, const optional<FeatureIdentifier>&, const PropertyAccessor&) const;
+
+private:
+    enum class Op : uint8_t {
+        True,
+        Equals,      // operand: index into `values`
+        LessThan,
+        LessThanEquals,
+        GreaterThan,
+        GreaterThanEquals,
+        In,          // operand: index into `valueSets`
+        Has,
+        TypeIn,      // operand: bit mask of feature types
+        IdentifierIn, // operand: index into `identifierSets`
+        HasIdentifier,
+        Not,
+        JumpIfFalse, // operand: index of the instruction to jump to
+        JumpIfTrue,
+    };
+
+    struct Instruction {
+        Op op;
+        uint16_t key;
+        uint32_t operand;
+    };
+
+    struct ValueSet {
+        std::vector<Value> values;
+        // Set if all values are strings, which is the common case.
+        bool stringsOnly;
+        std::unordered_set<std::string> strings;
+    };
+
+    class Compiler;
+
+    // Keys beyond this many distinct ones are looked up again on each use.
+    static constexpr std::size_t maxCachedKeys = 8;
+
+    std::vector<Instruction> program;
+    std::vector<std::string> keys;
+    std::vector<Value> values;
+    std::vector<ValueSet> valueSets;
+    std::vector<std::vector<FeatureIdentifier>> identifierSets;
+};
+
+inline bool CompiledFilter::operator()(const Feature& feature) const {
+    return operator()(apply_visitor(ToFeatureType(), feature.geometry), feature.id, [&] (const std::string& key) -> optional<Value> {
+        auto it = feature.properties.find(key);
+        if (it == feature.properties.end())
+            return {};
+        return it->second;
+    });
+}
+
+template <class PropertyAccessor>
+bool CompiledFilter::operator()(FeatureType type,
+                                const optional<FeatureIdentifier>& id,
+                                const PropertyAccessor& accessor) const {
+    std::array<optional<Value>, maxCachedKeys> cachedValues;
+    uint32_t resolved = 0;
+    optional<Value> uncachedValue;
+
+    auto lookup = [&] (uint16_t key) -> const optional<Value>& {
+        if (key >= maxCachedKeys) {
+            uncachedValue = accessor(keys[key]);
+            return uncachedValue;
+        }
+        if (!(resolved & (1u << key))) {
+            cachedValues[key] = accessor(keys[key]);
+            resolved |= 1u << key;
+        }
+        return cachedValues[key];
+    };
+
+    auto compare = [&] (const Instruction& instruction, const auto& op) {
+        const optional<Value>& actual = lookup(instruction.key);
+        return actual && detail::compare(*actual, values[instruction.operand], op);
+    };
+
+    bool result = true;
+    for (std::size_t pc = 0; pc < program.size(); ++pc) {
+        const Instruction& instruction = program[pc];
+        switch (instruction.op) {
+        case Op::True:
+            result = true;
+            break;
+        case Op::Equals:
+            result = compare(instruction, [] (const auto& lhs, const auto& rhs) { return lhs == rhs; });
+            break;
+        case Op::LessThan:
+            result = compare(instruction, [] (const auto& lhs, const auto& rhs) { return lhs < rhs; });
+            break;
+        case Op::LessThanEquals:
+            result = compare(instruction, [] (const auto& lhs, const auto& rhs) { return lhs <= rhs; });
+            break;
+        case Op::GreaterThan:
+            result = compare(instruction, [] (const auto& lhs, const auto& rhs) { return lhs > rhs; });
+            break;
+        case Op::GreaterThanEquals:
+            result = compare(instruction, [] (const auto& lhs, const auto& rhs) { return lhs >= rhs; });
+            break;
+        case Op::In: {
+            const optional<Value>& actual = lookup(instruction.key);
+            const ValueSet& set = valueSets[instruction.operand];
+            result = false;
+            if (!actual) {
+                break;
+            }
+            if (set.stringsOnly) {
+                result = actual->is<std::string>() && set.strings.count(actual->get<std::string>());
+                break;
+            }
+            for (const auto& value : set.values) {
+                if (detail::equal(*actual, value)) {
+                    result = true;
+                    break;
+                }
+            }
+            break;
+        }
+        case Op::Has:
+            result = bool(lookup(instruction.key));
+            break;
+        case Op::TypeIn:
+            result = instruction.operand & (1u << static_cast<uint8_t>(type));
+            break;
+        case Op::IdentifierIn:
+            result = false;
+            for (const auto& identifier : identifierSets[instruction.operand]) {
+                if (id == identifier) {
+                    result = true;
+                    break;
+                }
+            }
+            break;
+        case Op::HasIdentifier:
+            result = bool(id);
+            break;
+        case Op::Not:
+            result = !result;
+            break;
+        case Op::JumpIfFalse:
+            if (!result) {
+                pc = instruction.operand - 1;
+            }
+            break;
+        case Op::JumpIfTrue:
+            if (result) {
+                pc = instruction.operand - 1;
+            }
+            break;
+        }
+    }
+
+    return result;
+}
+
+} // namespace style
+} // namespace mbgl
@@ -301,9 +301,9 @@ public:
         writer.Key("type");
         writer.String("exponential");
         writer.Key("base");
-        writer.Double(f.base);
+        writer.Double(f.getBase());
         writer.Key("stops");
-        stringifyStops(f.stops);
+        stringifyStops(f.getStops());
     }
 
     template <class T>
@@ -311,7 +311,7 @@ public:
         writer.Key("type");
         writer.String("interval");
         writer.Key("stops");
-        stringifyStops(f.stops);
+        stringifyStops(f.getStops());
     }
 
     template <class T>
@@ -333,9 +333,9 @@ public:
         writer.Key("type");
         writer.String("exponential");
         writer.Key("base");
-        writer.Double(f.base);
+        writer.Double(f.getBase());
         writer.Key("stops");
-        stringifyCompositeStops(f.stops);
+        stringifyCompositeStops(f.getStops());
     }
 
     template <class T>
@@ -343,7 +343,7 @@ public:
         writer.Key("type");
         writer.String("interval");
         writer.Key("stops");
-        stringifyCompositeStops(f.stops);
+        stringifyCompositeStops(f.getStops());
     }
 
     template <class T>
@@ -351,7 +351,7 @@ public:
         writer.Key("type");
         writer.String("categorical");
         writer.Key("stops");
-        stringifyCompositeStops(f.stops);
+        stringifyCompositeStops(f.getStops());
     }
 
 private:
@@ -399,7 +399,7 @@ void stringify(Writer& writer, const SourceFunction<T>& f) {
     writer.StartObject();
     writer.Key("property");
     writer.String(f.property);
-    SourceFunction<T>::Stops::visit(f.stops, StringifyStops<Writer> { writer });
+    SourceFunction<T>::Stops::visit(f.getStops(), StringifyStops<Writer> { writer });
     if (f.defaultValue) {
         writer.Key("default");
         stringify(writer, *f.defaultValue);
@@ -23,7 +23,7 @@ namespace style {
 
 Parser::~Parser() = default;
 
-StyleParseResult Parser::parse(const std::string& json) {
+StyleParseResult Parser::parse(const std::string& json, bool withLayers) {
     rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
     document.Parse<0>(json.c_str());
 
@@ -106,7 +106,7 @@ StyleParseResult Parser::parse(const std::string& json) {
         parseSources(document["sources"]);
     }
 
-    if (document.HasMember("layers")) {
+    if (withLayers && document.HasMember("layers")) {
         parseLayers(document["layers"]);
     }
     
@@ -292,7 +292,7 @@ std::vector<FontStack> Parser::fontStacks() const {
             } else if (textFont.isCameraFunction()) {
                 textFont.asCameraFunction().stops.match(
                     [&] (const auto& stops) {
-                        for (const auto& stop : stops.stops) {
+                        for (const auto& stop : stops.getStops()) {
                             optional.insert(stop.second);
                         }
                     }
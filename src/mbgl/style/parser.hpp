@@ -24,7 +24,9 @@ class Parser {
 public:
     ~Parser();
 
-    StyleParseResult parse(const std::string&);
+    // Layers are skipped unless `withLayers` is true, e.g. when they're shared with an earlier
+    // parse of the same style.
+    StyleParseResult parse(const std::string&, bool withLayers = true);
 
     std::string spriteURL;
     std::string glyphURL;
@@ -10,21 +10,59 @@
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/raster_layer.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/style/layers/background_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer_impl.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer_impl.hpp>
+#include <mbgl/style/layers/line_layer_impl.hpp>
+#include <mbgl/style/layers/circle_layer_impl.hpp>
+#include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/style/parser.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/sprite/sprite_loader.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/resource_registry.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 
+#include <cassert>
+
 namespace mbgl {
 namespace style {
 
 static Observer nullObserver;
 
+using ParsedLayers = std::vector<Immutable<Layer::Impl>>;
+
+// Creates a layer that shares its properties with another map's layer, until either is changed.
+static std::unique_ptr<Layer> makeLayer(const Immutable<Layer::Impl>& impl) {
+    switch (impl->type) {
+    case LayerType::Fill:
+        return std::make_unique<FillLayer>(staticImmutableCast<FillLayer::Impl>(impl));
+    case LayerType::Line:
+        return std::make_unique<LineLayer>(staticImmutableCast<LineLayer::Impl>(impl));
+    case LayerType::Circle:
+        return std::make_unique<CircleLayer>(staticImmutableCast<CircleLayer::Impl>(impl));
+    case LayerType::Symbol:
+        return std::make_unique<SymbolLayer>(staticImmutableCast<SymbolLayer::Impl>(impl));
+    case LayerType::Raster:
+        return std::make_unique<RasterLayer>(staticImmutableCast<RasterLayer::Impl>(impl));
+    case LayerType::Background:
+        return std::make_unique<BackgroundLayer>(staticImmutableCast<BackgroundLayer::Impl>(impl));
+    case LayerType::Custom:
+        // Custom layers can't be declared in style JSON.
+        break;
+    case LayerType::FillExtrusion:
+        return std::make_unique<FillExtrusionLayer>(staticImmutableCast<FillExtrusionLayer::Impl>(impl));
+    }
+
+    assert(false);
+    return nullptr;
+}
+
 Style::Impl::Impl(Scheduler& scheduler_, FileSource& fileSource_, float pixelRatio)
     : scheduler(scheduler_),
       fileSource(fileSource_),
@@ -75,9 +113,15 @@ void Style::Impl::loadURL(const std::string& url_) {
 }
 
 void Style::Impl::parse(const std::string& json_) {
+    // Converting the layers is the bulk of the work; skip it if another map has already parsed
+    // the same style.
+    auto& registry = util::ResourceRegistry<ParsedLayers>::get();
+    const util::ResourceRegistry<ParsedLayers>::Key key { url, json_ };
+    std::shared_ptr<const ParsedLayers> shared = registry.find(key);
+
     Parser parser;
 
-    if (auto error = parser.parse(json_)) {
+    if (auto error = parser.parse(json_, !shared)) {
         std::string message = "Failed to parse style: " + util::toString(error);
         Log::Error(Event::ParseStyle, message.c_str());
         observer->onStyleError(std::make_exception_ptr(util::StyleParseException(message)));
@@ -100,9 +144,20 @@ void Style::Impl::parse(const std::string& json_) {
         addSource(std::move(source));
     }
 
-    for (auto& layer : parser.layers) {
-        addLayer(std::move(layer));
+    if (shared) {
+        for (const auto& impl : *shared) {
+            addLayer(makeLayer(impl));
+        }
+    } else {
+        ParsedLayers impls;
+        impls.reserve(parser.layers.size());
+        for (auto& layer : parser.layers) {
+            impls.push_back(layer->baseImpl);
+            addLayer(std::move(layer));
+        }
+        shared = registry.insert(key, std::move(impls));
     }
+    parsedLayers = std::move(shared);
 
     name = parser.name;
     defaultLatLng = parser.latLng;
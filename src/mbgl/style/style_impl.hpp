@@ -105,6 +105,9 @@ private:
     std::string url;
     std::string json;
 
+    // The layers as parsed from `json`, shared with other maps that loaded the same style.
+    std::shared_ptr<const std::vector<Immutable<Layer::Impl>>> parsedLayers;
+
     std::unique_ptr<AsyncRequest> styleRequest;
     std::unique_ptr<SpriteLoader> spriteLoader;
 
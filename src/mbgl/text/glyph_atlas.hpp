@@ -2,8 +2,6 @@
 
 #include <mbgl/text/glyph.hpp>
 
-#include <mapbox/shelf-pack.hpp>
-
 namespace mbgl {
 
 struct GlyphPosition {
@@ -14,12 +12,4 @@ struct GlyphPosition {
 using GlyphPositionMap = std::map<GlyphID, GlyphPosition>;
 using GlyphPositions = std::map<FontStack, GlyphPositionMap>;
 
-class GlyphAtlas {
-public:
-    AlphaImage image;
-    GlyphPositions positions;
-};
-
-GlyphAtlas makeGlyphAtlas(const GlyphMap&);
-
 } // namespace mbgl
@@ -4,6 +4,7 @@
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/resource_registry.hpp>
 
 namespace mbgl {
 
@@ -77,19 +78,34 @@ void GlyphManager::processResponse(const Response& res, const FontStack& fontSta
     GlyphRequest& request = entry.ranges[range];
 
     if (!res.noContent) {
-        std::vector<Glyph> glyphs;
+        using ParsedGlyphs = std::vector<Immutable<Glyph>>;
+        auto& registry = util::ResourceRegistry<ParsedGlyphs>::get();
+        const util::ResourceRegistry<ParsedGlyphs>::Key key {
+            Resource::glyphs(glyphURL, fontStack, range).url, *res.data
+        };
+
+        std::shared_ptr<const ParsedGlyphs> glyphs = registry.find(key);
+        if (!glyphs) {
+            ParsedGlyphs parsed;
+
+            try {
+                for (auto& glyph : parseGlyphPBF(range, *res.data)) {
+                    parsed.push_back(makeMutable<Glyph>(std::move(glyph)));
+                }
+            } catch (...) {
+                observer->onGlyphsError(fontStack, range, std::current_exception());
+                return;
+            }
 
-        try {
-            glyphs = parseGlyphPBF(range, *res.data);
-        } catch (...) {
-            observer->onGlyphsError(fontStack, range, std::current_exception());
-            return;
+            glyphs = registry.insert(key, std::move(parsed));
         }
 
-        for (auto& glyph : glyphs) {
-            entry.glyphs.erase(glyph.id);
-            entry.glyphs.emplace(glyph.id, makeMutable<Glyph>(std::move(glyph)));
+        for (const auto& glyph : *glyphs) {
+            entry.glyphs.erase(glyph->id);
+            entry.glyphs.emplace(glyph->id, glyph);
         }
+
+        request.glyphs = std::move(glyphs);
     }
 
     request.parsed = true;
@@ -47,6 +47,8 @@ private:
 
     struct GlyphRequest {
         bool parsed = false;
+        // The parsed range, shared with other maps that loaded the same one.
+        std::shared_ptr<const std::vector<Immutable<Glyph>>> glyphs;
         std::unique_ptr<AsyncRequest> req;
         std::unordered_map<GlyphRequestor*, std::shared_ptr<GlyphDependencies>> requestors;
     };
@@ -1,6 +1,6 @@
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
-#include <mbgl/map/query.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
 
 #include <mapbox/geojsonvt.hpp>
@@ -111,25 +111,10 @@ void GeoJSONTile::updateData(mapbox::geometry::feature_collection<int16_t> featu
 
 void GeoJSONTile::setNecessity(Necessity) {}
     
-void GeoJSONTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
-    
+void GeoJSONTile::querySourceFeatures(SourceFeatureQuery& query) {
     // Ignore the sourceLayer, there is only one
-    auto layer = getData()->getLayer({});
-    
-    if (layer) {
-        auto featureCount = layer->featureCount();
-        for (std::size_t i = 0; i < featureCount; i++) {
-            auto feature = layer->getFeature(i);
-            
-            // Apply filter, if any
-            if (options.filter && !(*options.filter)(*feature)) {
-                continue;
-            }
-            
-            result.push_back(convertFeature(*feature, id.canonical));
-        }
+    if (auto tileData = getData()) {
+        query.addTile(id.canonical, std::move(tileData), getSourceFeatureIndex(), { std::string() });
     }
 }
 
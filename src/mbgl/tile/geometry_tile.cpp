@@ -10,19 +10,18 @@
 #include <mbgl/renderer/layers/render_custom_layer.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
-#include <mbgl/text/glyph_atlas.hpp>
-#include <mbgl/renderer/image_atlas.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/geometry/source_feature_index.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/map/transform_state.hpp>
-#include <mbgl/map/query.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/util/run_loop.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/logging.hpp>
 
 #include <iostream>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -39,7 +38,10 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
              id_,
              obsolete,
              parameters.mode,
-             parameters.pixelRatio),
+             parameters.pixelRatio,
+             parameters.symbolAtlas,
+             parameters.workerScheduler,
+             parameters.parallelLayout),
       glyphManager(parameters.glyphManager),
       imageManager(parameters.imageManager),
       placementThrottler(Milliseconds(300), [this] { invokePlacement(); }) {
@@ -74,6 +76,10 @@ void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
     worker.invoke(&GeometryTileWorker::setData, std::move(data_), correlationID);
 }
 
+void GeometryTile::setPriority(Priority priority) {
+    worker.setPriority(priority);
+}
+
 void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
     if (requestedConfig == desiredConfig) {
         return;
@@ -95,10 +101,6 @@ void GeometryTile::invokePlacement() {
 }
 
 void GeometryTile::setLayers(const std::vector<Immutable<Layer::Impl>>& layers) {
-    // Mark the tile as pending again if it was complete before to prevent signaling a complete
-    // state despite pending parse operations.
-    pending = true;
-
     std::vector<Immutable<Layer::Impl>> impls;
 
     for (const auto& layer : layers) {
@@ -115,6 +117,17 @@ void GeometryTile::setLayers(const std::vector<Immutable<Layer::Impl>>& layers)
         impls.push_back(layer);
     }
 
+    // Tiles that come back from the cache are sent the current layers; only lay them out again
+    // if the layers changed in the meantime.
+    if (layoutLayers && *layoutLayers == impls) {
+        return;
+    }
+    layoutLayers = impls;
+
+    // Mark the tile as pending again if it was complete before to prevent signaling a complete
+    // state despite pending parse operations.
+    pending = true;
+
     ++correlationID;
     worker.invoke(&GeometryTileWorker::setLayers, std::move(impls), correlationID);
 }
@@ -125,6 +138,8 @@ void GeometryTile::onLayout(LayoutResult result) {
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
     featureIndex = std::move(result.featureIndex);
     data = std::move(result.tileData);
+    // Source layers are indexed lazily, by the first query with bounds.
+    sourceFeatureIndex = std::make_shared<SourceFeatureIndex>();
     collisionTile.reset();
     observer->onTileChanged(*this);
 }
@@ -136,13 +151,11 @@ void GeometryTile::onPlacement(PlacementResult result) {
         pending = false;
     }
     symbolBuckets = std::move(result.symbolBuckets);
-    collisionTile = std::move(result.collisionTile);
-    if (result.glyphAtlasImage) {
-        glyphAtlasImage = std::move(*result.glyphAtlasImage);
-    }
-    if (result.iconAtlasImage) {
-        iconAtlasImage = std::move(*result.iconAtlasImage);
+    for (auto& placement : result.symbolPlacements) {
+        static_cast<SymbolBucket&>(*symbolBuckets.at(placement.first)).place(std::move(*placement.second));
     }
+    collisionTile = std::move(result.collisionTile);
+    symbolAtlasReference = std::move(result.symbolAtlasReference);
     observer->onTileChanged(*this);
 }
 
@@ -183,16 +196,6 @@ void GeometryTile::upload(gl::Context& context) {
     for (auto& entry : symbolBuckets) {
         upload(*entry.second);
     }
-
-    if (glyphAtlasImage) {
-        glyphAtlasTexture = context.createTexture(*glyphAtlasImage, 0);
-        glyphAtlasImage = {};
-    }
-
-    if (iconAtlasImage) {
-        iconAtlasTexture = context.createTexture(*iconAtlasImage, 0);
-        iconAtlasImage = {};
-    }
 }
 
 Bucket* GeometryTile::getBucket(const Layer::Impl& layer) const {
@@ -206,31 +209,61 @@ Bucket* GeometryTile::getBucket(const Layer::Impl& layer) const {
     return it->second.get();
 }
 
+std::size_t GeometryTile::byteSize() const {
+    std::size_t size = 0;
+
+    // Layers that share a layout share a bucket; count each bucket once.
+    std::unordered_set<const Bucket*> buckets;
+    for (const auto* map : { &nonSymbolBuckets, &symbolBuckets }) {
+        for (const auto& entry : *map) {
+            if (buckets.insert(entry.second.get()).second) {
+                size += entry.second->byteSize();
+            }
+        }
+    }
+
+    if (featureIndex) {
+        size += featureIndex->byteSize();
+    }
+
+    if (symbolAtlasReference) {
+        size += SymbolAtlas::byteSize(*symbolAtlasReference);
+    }
+
+    return size;
+}
+
 void GeometryTile::queryRenderedFeatures(
-    std::unordered_map<std::string, std::vector<Feature>>& result,
+    RenderedFeatureQuery& query,
     const GeometryCoordinates& queryGeometry,
-    const TransformState& transformState,
-    const RenderStyle& style,
-    const RenderedQueryOptions& options) {
+    const TransformState& transformState) {
 
     if (!featureIndex || !data) return;
 
-    featureIndex->query(result,
-                        queryGeometry,
-                        transformState.getAngle(),
-                        util::tileSize * id.overscaleFactor(),
-                        std::pow(2, transformState.getZoom() - id.overscaledZ),
-                        options,
-                        *data,
-                        id.canonical,
-                        style,
-                        collisionTile.get(),
-                        *this);
+    const double tileSize = util::tileSize * id.overscaleFactor();
+    const double scale = std::pow(2, transformState.getZoom() - id.overscaledZ);
+    const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
+
+    // Determine the additional radius needed factoring in property functions
+    float additionalRadius = 0;
+    for (const RenderLayer* layer : query.getLayers()) {
+        auto bucket = getBucket(*layer->baseImpl);
+        if (bucket) {
+            additionalRadius = std::max(additionalRadius, bucket->getQueryRadius(*layer) * pixelsToTileUnits);
+        }
+    }
+
+    query.addTile({ id.canonical,
+                    queryGeometry,
+                    tileSize,
+                    scale,
+                    std::min<int16_t>(util::EXTENT, additionalRadius),
+                    featureIndex,
+                    data,
+                    collisionTile });
 }
 
-void GeometryTile::querySourceFeatures(
-    std::vector<Feature>& result,
-    const SourceQueryOptions& options) {
+void GeometryTile::querySourceFeatures(SourceFeatureQuery& query) {
 
     // Data not yet available
     if (!data) {
@@ -238,30 +271,12 @@ void GeometryTile::querySourceFeatures(
     }
     
     // No source layers, specified, nothing to do
-    if (!options.sourceLayers) {
+    if (!query.getOptions().sourceLayers) {
         Log::Warning(Event::General, "At least one sourceLayer required");
         return;
     }
 
-    for (auto sourceLayer : *options.sourceLayers) {
-        // Go throught all sourceLayers, if any
-        // to gather all the features
-        auto layer = data->getLayer(sourceLayer);
-        
-        if (layer) {
-            auto featureCount = layer->featureCount();
-            for (std::size_t i = 0; i < featureCount; i++) {
-                auto feature = layer->getFeature(i);
-
-                // Apply filter, if any
-                if (options.filter && !(*options.filter)(*feature)) {
-                    continue;
-                }
-
-                result.push_back(convertFeature(*feature, id.canonical));
-            }
-        }
-    }
+    query.addTile(id.canonical, data, sourceFeatureIndex, *query.getOptions().sourceLayers);
 }
 
 } // namespace mbgl
@@ -18,13 +18,10 @@ namespace mbgl {
 
 class GeometryTileData;
 class FeatureIndex;
+class SourceFeatureIndex;
 class CollisionTile;
-class RenderStyle;
-class RenderLayer;
-class SourceQueryOptions;
+class SymbolPlacementBuffers;
 class TileParameters;
-class GlyphAtlas;
-class ImageAtlas;
 
 class GeometryTile : public Tile, public GlyphRequestor, ImageRequestor {
 public:
@@ -37,6 +34,7 @@ public:
     void setError(std::exception_ptr);
     void setData(std::unique_ptr<const GeometryTileData>);
 
+    void setPriority(Priority) override;
     void setPlacementConfig(const PlacementConfig&) override;
     void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) override;
     
@@ -48,20 +46,14 @@ public:
 
     void upload(gl::Context&) override;
     Bucket* getBucket(const style::Layer::Impl&) const override;
-
-    Size bindGlyphAtlas(gl::Context&);
-    Size bindIconAtlas(gl::Context&);
+    std::size_t byteSize() const override;
 
     void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            RenderedFeatureQuery& query,
             const GeometryCoordinates& queryGeometry,
-            const TransformState&,
-            const RenderStyle&,
-            const RenderedQueryOptions& options) override;
+            const TransformState&) override;
 
-    void querySourceFeatures(
-        std::vector<Feature>& result,
-        const SourceQueryOptions&) override;
+    void querySourceFeatures(SourceFeatureQuery& query) override;
 
     void cancel() override;
 
@@ -77,9 +69,10 @@ public:
     class PlacementResult {
     public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
-        std::unique_ptr<CollisionTile> collisionTile;
-        optional<AlphaImage> glyphAtlasImage;
-        optional<PremultipliedImage> iconAtlasImage;
+        // The placement buffers of each symbol bucket, keyed by the ID of its first layer.
+        std::unordered_map<std::string, std::unique_ptr<SymbolPlacementBuffers>> symbolPlacements;
+        std::shared_ptr<const CollisionTile> collisionTile;
+        std::shared_ptr<const SymbolAtlas::Reference> symbolAtlasReference;
         uint64_t correlationID;
     };
     void onPlacement(PlacementResult);
@@ -87,8 +80,12 @@ public:
     void onError(std::exception_ptr);
     
 protected:
-    const GeometryTileData* getData() {
-        return data.get();
+    std::shared_ptr<const GeometryTileData> getData() const {
+        return data;
+    }
+
+    std::shared_ptr<const SourceFeatureIndex> getSourceFeatureIndex() const {
+        return sourceFeatureIndex;
     }
 
 private:
@@ -107,23 +104,23 @@ private:
     ImageManager& imageManager;
 
     uint64_t correlationID = 0;
+    optional<std::vector<Immutable<style::Layer::Impl>>> layoutLayers;
     optional<PlacementConfig> requestedConfig;
 
+    // The feature indexes, tile data and collision tile are shared with queries that are still
+    // running when a new layout or placement replaces them.
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
-    std::unique_ptr<FeatureIndex> featureIndex;
-    std::unique_ptr<const GeometryTileData> data;
-
-    optional<AlphaImage> glyphAtlasImage;
-    optional<PremultipliedImage> iconAtlasImage;
+    std::shared_ptr<const FeatureIndex> featureIndex;
+    std::shared_ptr<const GeometryTileData> data;
+    std::shared_ptr<const SourceFeatureIndex> sourceFeatureIndex;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
-    std::unique_ptr<CollisionTile> collisionTile;
+    std::shared_ptr<const CollisionTile> collisionTile;
+
+    // Keeps the glyphs and icons that the symbol buckets refer to in the shared atlas.
+    std::shared_ptr<const SymbolAtlas::Reference> symbolAtlasReference;
     
     util::Throttler placementThrottler;
-
-public:
-    optional<gl::Texture> glyphAtlasTexture;
-    optional<gl::Texture> iconAtlasTexture;
 };
 
 } // namespace mbgl
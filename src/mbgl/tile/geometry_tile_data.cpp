@@ -180,4 +180,15 @@ Feature convertFeature(const GeometryTileFeature& geometryTileFeature, const Can
     return feature;
 }
 
+Feature convertFeature(const GeometryTileFeature& geometryTileFeature, const CanonicalTileID& tileID, const std::vector<std::string>& properties) {
+    Feature feature { convertGeometry(geometryTileFeature, tileID) };
+    for (const auto& key : properties) {
+        if (auto value = geometryTileFeature.getValue(key)) {
+            feature.properties.emplace(key, std::move(*value));
+        }
+    }
+    feature.id = geometryTileFeature.getID();
+    return feature;
+}
+
 } // namespace mbgl
@@ -5,8 +5,8 @@
 #include <mbgl/layout/symbol_layout.hpp>
 #include <mbgl/renderer/bucket_parameters.hpp>
 #include <mbgl/renderer/group_by_layout.hpp>
-#include <mbgl/style/filter.hpp>
-#include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/renderer/style_diff.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/layers/render_symbol_layer.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
@@ -14,7 +14,11 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/parallel_for.hpp>
 
+#include <mapbox/geometry/envelope.hpp>
+
+#include <algorithm>
 #include <unordered_set>
 
 namespace mbgl {
@@ -26,13 +30,19 @@ GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        OverscaledTileID id_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_,
-                                       const float pixelRatio_)
+                                       const float pixelRatio_,
+                                       SymbolAtlas& symbolAtlas_,
+                                       Scheduler& scheduler_,
+                                       const bool parallelLayout_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
       id(std::move(id_)),
       obsolete(obsolete_),
       mode(mode_),
-      pixelRatio(pixelRatio_) {
+      pixelRatio(pixelRatio_),
+      symbolAtlas(symbolAtlas_),
+      scheduler(scheduler_),
+      parallelLayout(parallelLayout_) {
 }
 
 GeometryTileWorker::~GeometryTileWorker() = default;
@@ -75,6 +85,9 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
         data = std::move(data_);
         correlationID = correlationID_;
 
+        // None of the previous layout's results apply to the new data.
+        layoutGroups.clear();
+
         switch (state) {
         case Idle:
             redoLayout();
@@ -281,21 +294,49 @@ void GeometryTileWorker::redoLayout() {
     GlyphDependencies glyphDependencies;
     ImageDependencies imageDependencies;
 
+    // Determine which layers changed in a way that affects their buckets since the last layout.
+    const LayerDifference layerDiff = diffLayers(
+        makeMutable<std::vector<Immutable<Layer::Impl>>>(layoutLayers),
+        makeMutable<std::vector<Immutable<Layer::Impl>>>(*layers));
+    std::unordered_map<std::string, LayoutGroup> newLayoutGroups;
+
     // Create render layers and group by layout
     std::vector<std::unique_ptr<RenderLayer>> renderLayers = toRenderLayers(*layers, id.overscaledZ);
     std::vector<std::vector<const RenderLayer*>> groups = groupByLayout(renderLayers);
 
-    for (auto& group : groups) {
-        if (obsolete) {
-            return;
+    // A single group's share of the layout. Groups are independent of each other, so they can be
+    // laid out concurrently; their results are merged in group order afterwards, which keeps the
+    // feature index and dependencies identical to those of a serial layout.
+    struct GroupLayout {
+        GroupLayout(const std::vector<const RenderLayer*>& group_,
+                    std::unique_ptr<GeometryTileLayer> geometryLayer_,
+                    std::vector<std::string> layerIDs_)
+            : group(group_),
+              geometryLayer(std::move(geometryLayer_)),
+              layerIDs(std::move(layerIDs_)) {
         }
 
+        const std::vector<const RenderLayer*>& group;
+        std::unique_ptr<GeometryTileLayer> geometryLayer;
+        std::vector<std::string> layerIDs;
+        bool reused = false;
+        LayoutGroup layoutGroup;
+        std::unique_ptr<SymbolLayout> symbolLayout;
+        GlyphDependencies glyphDependencies;
+        ImageDependencies imageDependencies;
+    };
+
+    std::vector<GroupLayout> groupLayouts;
+    groupLayouts.reserve(groups.size());
+
+    for (auto& group : groups) {
         if (!*data) {
             continue; // Tile has no data.
         }
 
         const RenderLayer& leader = *group.at(0);
 
+        // Tile data is parsed lazily and isn't safe to access concurrently until it has been.
         auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
         if (!geometryLayer) {
             continue;
@@ -308,38 +349,113 @@ void GeometryTileWorker::redoLayout() {
 
         featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
 
+        groupLayouts.emplace_back(group, std::move(geometryLayer), std::move(layerIDs));
+        GroupLayout& groupLayout = groupLayouts.back();
+
+        if (!leader.is<RenderSymbolLayer>()) {
+            auto previous = layoutGroups.find(leader.getID());
+            if (previous != layoutGroups.end() && previous->second.layerIDs == groupLayout.layerIDs &&
+                std::none_of(groupLayout.layerIDs.begin(), groupLayout.layerIDs.end(), [&] (const std::string& layerID) {
+                    return hasLayoutDifference(layerDiff, layerID);
+                })) {
+                groupLayout.layoutGroup = std::move(previous->second);
+                groupLayout.reused = true;
+            }
+        }
+    }
+
+    auto layOutGroup = [&] (std::size_t index) {
+        GroupLayout& groupLayout = groupLayouts[index];
+        const RenderLayer& leader = *groupLayout.group.at(0);
+
+        if (obsolete || groupLayout.reused) {
+            return;
+        }
+
         if (leader.is<RenderSymbolLayer>()) {
-            auto layout = leader.as<RenderSymbolLayer>()->createLayout(
-                parameters, group, std::move(geometryLayer), glyphDependencies, imageDependencies);
-            symbolLayoutMap.emplace(leader.getID(), std::move(layout));
-            symbolLayoutsNeedPreparation = true;
+            groupLayout.symbolLayout = leader.as<RenderSymbolLayer>()->createLayout(
+                parameters, groupLayout.group, std::move(groupLayout.geometryLayer),
+                groupLayout.glyphDependencies, groupLayout.imageDependencies);
         } else {
-            const Filter& filter = leader.baseImpl->filter;
-            const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
-            std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, group);
+            const CompiledFilter filter(leader.baseImpl->filter);
+            const GeometryTileLayer& geometryLayer = *groupLayout.geometryLayer;
+            std::shared_ptr<Bucket> bucket = leader.createBucket(parameters, groupLayout.group);
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+            for (std::size_t i = 0; !obsolete && i < geometryLayer.featureCount(); i++) {
+                std::unique_ptr<GeometryTileFeature> feature = geometryLayer.getFeature(i);
 
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+                if (!filter(*feature))
                     continue;
 
                 GeometryCollection geometries = feature->getGeometries();
                 bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+                for (const auto& ring : geometries) {
+                    groupLayout.layoutGroup.indexedRings.emplace_back(i, mapbox::geometry::envelope(ring));
+                }
             }
 
-            if (!bucket->hasData()) {
-                continue;
+            groupLayout.layoutGroup.layerIDs = groupLayout.layerIDs;
+            if (bucket->hasData()) {
+                groupLayout.layoutGroup.bucket = std::move(bucket);
             }
+        }
+    };
+
+    if (parallelLayout) {
+        // This worker already occupies one of the scheduler's threads.
+        util::parallelFor(scheduler, groupLayouts.size(),
+                          scheduler.threadCount() - 1, layOutGroup);
+    } else {
+        for (std::size_t i = 0; i < groupLayouts.size(); ++i) {
+            layOutGroup(i);
+        }
+    }
+
+    if (obsolete) {
+        return;
+    }
+
+    for (auto& groupLayout : groupLayouts) {
+        const RenderLayer& leader = *groupLayout.group.at(0);
 
-            for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+        if (groupLayout.symbolLayout) {
+            symbolLayoutMap.emplace(leader.getID(), std::move(groupLayout.symbolLayout));
+            symbolLayoutsNeedPreparation = true;
+
+            for (auto& fontDependencies : groupLayout.glyphDependencies) {
+                glyphDependencies[fontDependencies.first].insert(fontDependencies.second.begin(),
+                                                                 fontDependencies.second.end());
             }
+            imageDependencies.insert(groupLayout.imageDependencies.begin(),
+                                     groupLayout.imageDependencies.end());
+            continue;
+        }
+
+        if (leader.is<RenderSymbolLayer>()) {
+            continue;
         }
+
+        const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
+        LayoutGroup& result = groupLayout.layoutGroup;
+        for (const auto& ring : result.indexedRings) {
+            featureIndex->insert(ring.second, ring.first, sourceLayerID, leader.getID());
+        }
+
+        if (result.bucket) {
+            for (const auto& layer : groupLayout.group) {
+                buckets.emplace(layer->getID(), result.bucket);
+            }
+        }
+
+        newLayoutGroups.emplace(leader.getID(), std::move(result));
     }
 
+    layoutLayers = *layers;
+    layoutGroups = std::move(newLayoutGroups);
+
     symbolLayouts.clear();
+    symbolBuckets.clear();
+    collisionTile.reset();
     for (const auto& symbolLayerID : symbolOrder) {
         auto it = symbolLayoutMap.find(symbolLayerID);
         if (it != symbolLayoutMap.end()) {
@@ -374,30 +490,73 @@ void GeometryTileWorker::attemptPlacement() {
         return;
     }
     
-    optional<AlphaImage> glyphAtlasImage;
-    optional<PremultipliedImage> iconAtlasImage;
-
     if (symbolLayoutsNeedPreparation) {
-        GlyphAtlas glyphAtlas = makeGlyphAtlas(glyphMap);
-        ImageAtlas imageAtlas = makeImageAtlas(imageMap);
+        GlyphPositions glyphPositions;
+        ImagePositions imagePositions;
 
-        glyphAtlasImage = std::move(glyphAtlas.image);
-        iconAtlasImage = std::move(imageAtlas.image);
+        // Add the new reference before the previous one is released, so that glyphs and icons
+        // used by both stay in place.
+        symbolAtlasReference = symbolAtlas.add(glyphMap, imageMap, glyphPositions, imagePositions);
 
         for (auto& symbolLayout : symbolLayouts) {
             if (obsolete) {
                 return;
             }
 
-            symbolLayout->prepare(glyphMap, glyphAtlas.positions,
-                                  imageMap, imageAtlas.positions);
+            symbolLayout->prepare(glyphMap, glyphPositions,
+                                  imageMap, imagePositions);
+        }
+
+        // The layout vertices don't depend on the placement, so the buckets are created once and
+        // every placement only replaces their placement buffers.
+        symbolBuckets.clear();
+        for (auto& symbolLayout : symbolLayouts) {
+            if (obsolete) {
+                return;
+            }
+
+            if (!symbolLayout->hasSymbolInstances()) {
+                continue;
+            }
+
+            std::shared_ptr<Bucket> bucket = symbolLayout->createBucket();
+            for (const auto& pair : symbolLayout->layerPaintProperties) {
+                symbolBuckets.emplace(pair.first, bucket);
+            }
         }
 
+        SymbolLayout::findInteractingSymbols(symbolLayouts);
+
+        collisionTile.reset();
         symbolLayoutsNeedPreparation = false;
     }
 
-    auto collisionTile = std::make_unique<CollisionTile>(*placementConfig);
-    std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    // The collisions only depend on the angle and pitch, so the symbols aren't placed again when
+    // only the debug flag changed. Otherwise the symbols that can interact with another one go
+    // through collision detection again; the others keep their previous result.
+    const bool needsCollision = !collisionTile ||
+        collisionTile->config.angle != placementConfig->angle ||
+        collisionTile->config.pitch != placementConfig->pitch;
+
+    if (needsCollision) {
+        auto newCollisionTile = std::make_shared<CollisionTile>(*placementConfig);
+
+        for (auto& symbolLayout : symbolLayouts) {
+            if (obsolete) {
+                return;
+            }
+
+            if (symbolLayout->hasSymbolInstances()) {
+                symbolLayout->placeSymbols(*newCollisionTile);
+            }
+        }
+
+        collisionTile = std::move(newCollisionTile);
+    }
+
+    // The placement buffers hold one byte per vertex, and the triangles only for layouts whose
+    // drawing order depends on the angle.
+    std::unordered_map<std::string, std::unique_ptr<SymbolPlacementBuffers>> symbolPlacements;
 
     for (auto& symbolLayout : symbolLayouts) {
         if (obsolete) {
@@ -408,17 +567,15 @@ void GeometryTileWorker::attemptPlacement() {
             continue;
         }
 
-        std::shared_ptr<Bucket> bucket = symbolLayout->place(*collisionTile);
-        for (const auto& pair : symbolLayout->layerPaintProperties) {
-            buckets.emplace(pair.first, bucket);
-        }
+        symbolPlacements.emplace(symbolLayout->layerPaintProperties.begin()->first,
+            std::make_unique<SymbolPlacementBuffers>(symbolLayout->getPlacement(*collisionTile, placementConfig->debug)));
     }
 
     parent.invoke(&GeometryTile::onPlacement, GeometryTile::PlacementResult {
-        std::move(buckets),
-        std::move(collisionTile),
-        std::move(glyphAtlasImage),
-        std::move(iconAtlasImage),
+        symbolBuckets,
+        std::move(symbolPlacements),
+        collisionTile,
+        symbolAtlasReference,
         correlationID
     });
 }
@@ -5,19 +5,25 @@
 #include <mbgl/style/image_impl.hpp>
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/text/placement_config.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/util/immutable.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/geometry/feature_index.hpp>
 
 #include <atomic>
 #include <memory>
+#include <unordered_map>
 
 namespace mbgl {
 
 class GeometryTile;
 class GeometryTileData;
+class CollisionTile;
 class SymbolLayout;
+class Bucket;
+class Scheduler;
 
 namespace style {
 class Layer;
@@ -30,7 +36,10 @@ public:
                        OverscaledTileID,
                        const std::atomic<bool>&,
                        const MapMode,
-                       const float pixelRatio);
+                       const float pixelRatio,
+                       SymbolAtlas&,
+                       Scheduler&,
+                       const bool parallelLayout);
     ~GeometryTileWorker();
 
     void setLayers(std::vector<Immutable<style::Layer::Impl>>, uint64_t correlationID);
@@ -60,6 +69,11 @@ private:
     const std::atomic<bool>& obsolete;
     const MapMode mode;
     const float pixelRatio;
+    SymbolAtlas& symbolAtlas;
+
+    // When set, independent layer groups are laid out concurrently on the scheduler.
+    Scheduler& scheduler;
+    const bool parallelLayout;
 
     enum State {
         Idle,
@@ -76,12 +90,35 @@ private:
     optional<std::unique_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
+    // The result of laying out one group of non-symbol layers.
+    struct LayoutGroup {
+        std::vector<std::string> layerIDs;
+        std::shared_ptr<Bucket> bucket; // Null if the group has no data in this tile.
+        std::vector<std::pair<std::size_t, FeatureIndex::BBox>> indexedRings;
+    };
+
+    // The layers and groups of the last completed layout, keyed by group leader ID. A relayout
+    // reuses the bucket and feature index entries of every group whose layers have no layout
+    // difference since then, so that e.g. changing the filter of one layer only rebuilds the
+    // bucket of that layer's group.
+    std::vector<Immutable<style::Layer::Impl>> layoutLayers;
+    std::unordered_map<std::string, LayoutGroup> layoutGroups;
+
     bool symbolLayoutsNeedPreparation = false;
     std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+
+    // The buckets of the prepared symbol layouts, keyed by layer ID, and the collision tile of
+    // their last placement. Placing the symbols again only sends new placement buffers for them.
+    std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
+    std::shared_ptr<const CollisionTile> collisionTile;
     GlyphDependencies pendingGlyphDependencies;
     ImageDependencies pendingImageDependencies;
     GlyphMap glyphMap;
     ImageMap imageMap;
+
+    // Keeps the glyphs and icons of the prepared symbol layouts in the shared atlas. Each
+    // placement result hands a copy to the tile, which holds it for as long as it renders them.
+    std::shared_ptr<const SymbolAtlas::Reference> symbolAtlasReference;
 };
 
 } // namespace mbgl
@@ -41,6 +41,13 @@ void RasterTile::setData(std::shared_ptr<const std::string> data,
     worker.invoke(&RasterTileWorker::parse, data);
 }
 
+void RasterTile::setData(const util::MappedData& data,
+                         optional<Timestamp> modified_,
+                         optional<Timestamp> expires_) {
+    // The image decoders need a copy of the data.
+    setData(std::make_shared<const std::string>(data.toString()), modified_, expires_);
+}
+
 void RasterTile::onParsed(std::unique_ptr<Bucket> result) {
     bucket = std::move(result);
     loaded = true;
@@ -65,8 +72,17 @@ Bucket* RasterTile::getBucket(const style::Layer::Impl&) const {
     return bucket.get();
 }
 
+std::size_t RasterTile::byteSize() const {
+    return bucket ? bucket->byteSize() : 0;
+}
+
 void RasterTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void RasterTile::setPriority(Priority priority) {
+    worker.setPriority(priority);
+    loader.setPriority(priority);
+}
+
 } // namespace mbgl
@@ -14,6 +14,10 @@ namespace style {
 class Layer;
 } // namespace style
 
+namespace util {
+class MappedData;
+} // namespace util
+
 class RasterTile : public Tile {
 public:
     RasterTile(const OverscaledTileID&,
@@ -22,16 +26,21 @@ public:
     ~RasterTile() final;
 
     void setNecessity(Necessity) final;
+    void setPriority(Priority) final;
 
     void setError(std::exception_ptr);
     void setData(std::shared_ptr<const std::string> data,
                  optional<Timestamp> modified_,
                  optional<Timestamp> expires_);
+    void setData(const util::MappedData&,
+                 optional<Timestamp> modified_,
+                 optional<Timestamp> expires_);
 
     void cancel() override;
 
     void upload(gl::Context&) override;
     Bucket* getBucket(const style::Layer::Impl&) const override;
+    std::size_t byteSize() const override;
 
     void onParsed(std::unique_ptr<Bucket> result);
     void onError(std::exception_ptr);
@@ -3,7 +3,7 @@
 #include <mbgl/renderer/buckets/debug_bucket.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/logging.hpp>
-#include <mbgl/map/query.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 
 namespace mbgl {
 
@@ -30,14 +30,10 @@ void Tile::dumpDebugLogs() const {
 }
 
 void Tile::queryRenderedFeatures(
-        std::unordered_map<std::string, std::vector<Feature>>&,
+        RenderedFeatureQuery&,
         const GeometryCoordinates&,
-        const TransformState&,
-        const RenderStyle&,
-        const RenderedQueryOptions&) {}
+        const TransformState&) {}
 
-void Tile::querySourceFeatures(
-        std::vector<Feature>&,
-        const SourceQueryOptions&) {}
+void Tile::querySourceFeatures(SourceFeatureQuery&) {}
 
 } // namespace mbgl
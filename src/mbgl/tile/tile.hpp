@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/actor/mailbox.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/optional.hpp>
@@ -22,9 +23,8 @@ class DebugBucket;
 class TransformState;
 class TileObserver;
 class PlacementConfig;
-class RenderStyle;
-class RenderedQueryOptions;
-class SourceQueryOptions;
+class RenderedFeatureQuery;
+class SourceFeatureQuery;
 
 namespace gl {
 class Context;
@@ -46,25 +46,34 @@ public:
 
     virtual void setNecessity(Necessity) = 0;
 
+    // Tiles with a higher priority have their parsing and layout work scheduled first.
+    using Priority = Mailbox::Priority;
+
+    virtual void setPriority(Priority) {}
+
     // Mark this tile as no longer needed and cancel any pending work.
     virtual void cancel() = 0;
 
     virtual void upload(gl::Context&) = 0;
     virtual Bucket* getBucket(const style::Layer::Impl&) const = 0;
 
+    // Returns an estimate of the memory held by this tile's render data, used to budget the
+    // tile cache.
+    virtual std::size_t byteSize() const {
+        return 0;
+    }
+
     virtual void setPlacementConfig(const PlacementConfig&) {}
     virtual void setLayers(const std::vector<Immutable<style::Layer::Impl>>&) {}
 
+    // Adds this tile's share of a feature query. The features themselves are looked up when
+    // the query is run, possibly on another thread.
     virtual void queryRenderedFeatures(
-            std::unordered_map<std::string, std::vector<Feature>>& result,
+            RenderedFeatureQuery& query,
             const GeometryCoordinates& queryGeometry,
-            const TransformState&,
-            const RenderStyle&,
-            const RenderedQueryOptions& options);
+            const TransformState&);
 
-    virtual void querySourceFeatures(
-            std::vector<Feature>& result,
-            const SourceQueryOptions&);
+    virtual void querySourceFeatures(SourceFeatureQuery& query);
 
     void setTriedOptional();
 
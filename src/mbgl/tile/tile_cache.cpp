@@ -1,66 +1,130 @@
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/tile/tile.hpp>
 
+#include <boost/functional/hash.hpp>
+
 #include <cassert>
 
 namespace mbgl {
 
-void TileCache::setSize(size_t size_) {
-    size = size_;
-
-    while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
-    }
+std::size_t TileCache::KeyHash::operator()(const Key& key) const {
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.first);
+    boost::hash_combine(seed, std::hash<OverscaledTileID>{}(key.second));
+    return seed;
+}
 
-    assert(orderedKeys.size() <= size);
+void TileCache::setSize(uint64_t size) {
+    maximumSize = size;
+    evict(maximumSize);
 }
 
-void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
-    if (!tile->isRenderable() || !size) {
+void TileCache::add(const TilePyramid& pyramid, const OverscaledTileID& id, std::unique_ptr<Tile> tile) {
+    if (!tile->isRenderable()) {
         return;
     }
 
-    // insert new or query existing tile
-    if (tiles.emplace(key, std::move(tile)).second) {
-        // remove existing tile key
-        orderedKeys.remove(key);
+    const uint64_t size = tile->byteSize();
+    if (size > maximumSize) {
+        return;
     }
 
-    // (re-)insert tile key as newest
-    orderedKeys.push_back(key);
+    Key key { &pyramid, id };
 
-    // purge oldest key/tile if necessary
-    if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+    // Replace an existing tile for the same key.
+    auto it = tiles.find(key);
+    if (it != tiles.end()) {
+        currentSize -= it->second.size;
+        orderedKeys.erase(it->second.order);
+        keys.erase(it->second.tile.get());
+        tiles.erase(it);
     }
 
-    assert(orderedKeys.size() <= size);
-}
+    // Make room for the new tile before inserting it, so that it can't evict itself.
+    evict(maximumSize - size);
 
-std::unique_ptr<Tile> TileCache::get(const OverscaledTileID& key) {
+    tile->setObserver(this);
+    keys.emplace(tile.get(), key);
+    orderedKeys.push_back(key);
+    tiles.emplace(std::move(key), Entry { std::move(tile), size, std::prev(orderedKeys.end()) });
+    currentSize += size;
 
+    assert(currentSize <= maximumSize);
+}
+
+std::unique_ptr<Tile> TileCache::get(const TilePyramid& pyramid, const OverscaledTileID& id) {
     std::unique_ptr<Tile> tile;
 
-    auto it = tiles.find(key);
+    auto it = tiles.find(Key { &pyramid, id });
     if (it != tiles.end()) {
-        tile = std::move(it->second);
+        tile = std::move(it->second.tile);
+        currentSize -= it->second.size;
+        orderedKeys.erase(it->second.order);
+        keys.erase(tile.get());
         tiles.erase(it);
-        orderedKeys.remove(key);
         assert(tile->isRenderable());
     }
 
     return tile;
 }
 
-bool TileCache::has(const OverscaledTileID& key) {
-    return tiles.find(key) != tiles.end();
+bool TileCache::has(const TilePyramid& pyramid, const OverscaledTileID& id) const {
+    return tiles.find(Key { &pyramid, id }) != tiles.end();
+}
+
+void TileCache::clear(const TilePyramid& pyramid) {
+    for (auto it = orderedKeys.begin(); it != orderedKeys.end();) {
+        if (it->first == &pyramid) {
+            auto entry = tiles.find(*it);
+            assert(entry != tiles.end());
+            currentSize -= entry->second.size;
+            keys.erase(entry->second.tile.get());
+            tiles.erase(entry);
+            it = orderedKeys.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void TileCache::clear() {
     orderedKeys.clear();
+    keys.clear();
     tiles.clear();
+    currentSize = 0;
+}
+
+void TileCache::onTileChanged(Tile& tile) {
+    auto key = keys.find(&tile);
+    if (key == keys.end()) {
+        return;
+    }
+
+    auto it = tiles.find(key->second);
+    assert(it != tiles.end());
+    currentSize -= it->second.size;
+    it->second.size = tile.byteSize();
+    currentSize += it->second.size;
+
+    // The tile that changed can't be destroyed while it notifies its observer. If it no longer
+    // fits on its own, it's evicted when the next tile is added.
+    evict(maximumSize, &tile);
+}
+
+void TileCache::evict(uint64_t budget, const Tile* keep) {
+    auto order = orderedKeys.begin();
+    while (currentSize > budget && order != orderedKeys.end()) {
+        auto it = tiles.find(*order);
+        assert(it != tiles.end());
+        if (it->second.tile.get() == keep) {
+            ++order;
+            continue;
+        }
+        currentSize -= it->second.size;
+        keys.erase(it->second.tile.get());
+        tiles.erase(it);
+        order = orderedKeys.erase(order);
+    }
 }
 
 } // namespace mbgl
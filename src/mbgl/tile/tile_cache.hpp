@@ -1,31 +1,70 @@
 #pragma once
 
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/tile_observer.hpp>
 
+#include <cstdint>
 #include <list>
 #include <memory>
-#include <map>
+#include <unordered_map>
+#include <utility>
 
 namespace mbgl {
 
 class Tile;
+class TilePyramid;
 
-class TileCache {
+// A least-recently-used cache of renderable tiles that are no longer part of any tile pyramid's
+// render set. The capacity is a byte budget, checked against each tile's `Tile::byteSize()`
+// estimate, and is shared by all tile pyramids of a map; entries are keyed by the pyramid that
+// owned the tile as well as the tile ID. The cache observes the tiles it holds, and measures a
+// tile again when it changes, e.g. because a layout that was in progress finished. All
+// operations are O(1), except for `clear(const TilePyramid&)`, which is linear in the number of
+// cached tiles.
+class TileCache : private TileObserver {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    TileCache(uint64_t maximumSize_ = 0) : maximumSize(maximumSize_) {}
 
-    void setSize(size_t);
-    size_t getSize() const { return size; };
-    void add(const OverscaledTileID& key, std::unique_ptr<Tile> data);
-    std::unique_ptr<Tile> get(const OverscaledTileID& key);
-    bool has(const OverscaledTileID& key);
+    void setSize(uint64_t);
+    uint64_t getSize() const { return maximumSize; }
+    uint64_t getCurrentSize() const { return currentSize; }
+    std::size_t getCount() const { return tiles.size(); }
+
+    void add(const TilePyramid&, const OverscaledTileID&, std::unique_ptr<Tile>);
+    std::unique_ptr<Tile> get(const TilePyramid&, const OverscaledTileID&);
+    bool has(const TilePyramid&, const OverscaledTileID&) const;
+
+    // Removes all tiles owned by the given pyramid.
+    void clear(const TilePyramid&);
     void clear();
 
 private:
-    std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
-    std::list<OverscaledTileID> orderedKeys;
+    using Key = std::pair<const TilePyramid*, OverscaledTileID>;
+
+    struct KeyHash {
+        std::size_t operator()(const Key&) const;
+    };
+
+    struct Entry {
+        std::unique_ptr<Tile> tile;
+        uint64_t size;
+        std::list<Key>::iterator order;
+    };
+
+    void onTileChanged(Tile&) override;
+
+    // Evicts the least recently used tiles, other than the given one, until the cache fits the
+    // budget.
+    void evict(uint64_t budget, const Tile* keep = nullptr);
+
+    std::unordered_map<Key, Entry, KeyHash> tiles;
+    std::unordered_map<const Tile*, Key> keys;
+
+    // Least recently used key first.
+    std::list<Key> orderedKeys;
 
-    size_t size;
+    uint64_t maximumSize;
+    uint64_t currentSize = 0;
 };
 
 } // namespace mbgl
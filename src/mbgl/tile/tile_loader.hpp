@@ -34,6 +34,10 @@ public:
         }
     }
 
+    // Re-ranks the pending request for this tile, if any, and applies to the next ones. Set it
+    // before the tile is made required, so that its first network request is queued with it.
+    void setPriority(Tile::Priority);
+
 private:
     // called when the tile is one of the ideal tiles that we want to show definitely. the tile source
     // should try to make every effort (e.g. fetch from internet, or revalidate existing resources).
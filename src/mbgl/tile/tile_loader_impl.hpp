@@ -47,6 +47,31 @@ TileLoader<T>::TileLoader(T& tile_,
 template <typename T>
 TileLoader<T>::~TileLoader() = default;
 
+template <typename T>
+void TileLoader<T>::setPriority(Tile::Priority tilePriority) {
+    Resource::Priority priority = Resource::Normal;
+    switch (tilePriority) {
+    case Tile::Priority::High:
+        priority = Resource::High;
+        break;
+    case Tile::Priority::Normal:
+        priority = Resource::Normal;
+        break;
+    case Tile::Priority::Low:
+        priority = Resource::Low;
+        break;
+    }
+
+    if (priority == resource.priority) {
+        return;
+    }
+
+    resource.priority = priority;
+    if (request) {
+        fileSource.setPriority(*request, priority);
+    }
+}
+
 template <typename T>
 void TileLoader<T>::loadOptional() {
     assert(!request);
@@ -99,7 +124,11 @@ void TileLoader<T>::loadedData(const Response& res) {
         resource.priorModified = res.modified;
         resource.priorExpires = res.expires;
         resource.priorEtag = res.etag;
-        tile.setData(res.noContent ? nullptr : res.data, res.modified, res.expires);
+        if (res.mappedData && !res.noContent) {
+            tile.setData(*res.mappedData, res.modified, res.expires);
+        } else {
+            tile.setData(res.noContent ? nullptr : res.data, res.modified, res.expires);
+        }
     }
 }
 
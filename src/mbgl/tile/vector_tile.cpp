@@ -16,6 +16,11 @@ void VectorTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
 }
 
+void VectorTile::setPriority(Priority priority) {
+    GeometryTile::setPriority(priority);
+    loader.setPriority(priority);
+}
+
 void VectorTile::setData(std::shared_ptr<const std::string> data_,
                          optional<Timestamp> modified_,
                          optional<Timestamp> expires_) {
@@ -25,4 +30,13 @@ void VectorTile::setData(std::shared_ptr<const std::string> data_,
     GeometryTile::setData(data_ ? std::make_unique<VectorTileData>(data_) : nullptr);
 }
 
+void VectorTile::setData(const util::MappedData& data_,
+                         optional<Timestamp> modified_,
+                         optional<Timestamp> expires_) {
+    modified = modified_;
+    expires = expires_;
+
+    GeometryTile::setData(std::make_unique<VectorTileData>(data_));
+}
+
 } // namespace mbgl
@@ -8,6 +8,10 @@ namespace mbgl {
 class Tileset;
 class TileParameters;
 
+namespace util {
+class MappedData;
+} // namespace util
+
 class VectorTile : public GeometryTile {
 public:
     VectorTile(const OverscaledTileID&,
@@ -16,10 +20,16 @@ public:
                const Tileset&);
 
     void setNecessity(Necessity) final;
+    void setPriority(Priority) final;
     void setData(std::shared_ptr<const std::string> data,
                  optional<Timestamp> modified,
                  optional<Timestamp> expires);
 
+    // Parses the tile in place, without copying it out of the mapped file.
+    void setData(const util::MappedData&,
+                 optional<Timestamp> modified,
+                 optional<Timestamp> expires);
+
 private:
     TileLoader<VectorTile> loader;
 };
@@ -1,15 +1,49 @@
 #include <mbgl/tile/vector_tile_data.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/mapped_file.hpp>
 
 namespace mbgl {
 
-VectorTileFeature::VectorTileFeature(const mapbox::vector_tile::layer& layer,
-                                     const protozero::data_view& view)
+// Indexes the layers of a tile by name, like mapbox::vector_tile::buffer, but reads the tile from
+// any memory rather than only from a std::string.
+static std::map<std::string, const protozero::data_view> readLayers(const protozero::data_view& tile) {
+    std::map<std::string, const protozero::data_view> layers;
+    protozero::pbf_reader tileReader(tile);
+    while (tileReader.next(3)) { // Tile.layers
+        const protozero::data_view layer = tileReader.get_view();
+        protozero::pbf_reader layerReader(layer);
+        if (!layerReader.next(1)) { // Layer.name
+            throw std::runtime_error("Layer missing name");
+        }
+        layers.emplace(layerReader.get_string(), layer);
+    }
+    return layers;
+}
+
+VectorTileLayerData::Feature::Feature(const protozero::data_view& view,
+                                      const mapbox::vector_tile::layer& layer)
     : feature(view, layer) {
 }
 
-FeatureType VectorTileFeature::getType() const {
-    switch (feature.getType()) {
+VectorTileLayerData::VectorTileLayerData(std::shared_ptr<const void> data_,
+                                         const protozero::data_view& view)
+    : data(std::move(data_)), layer(view) {
+    const std::size_t count = layer.featureCount();
+    for (std::size_t i = 0; i < count; i++) {
+        features.emplace_back(layer.getFeature(i), layer);
+    }
+}
+
+std::size_t VectorTileLayerData::featureCount() const {
+    return features.size();
+}
+
+std::string VectorTileLayerData::getName() const {
+    return layer.getName();
+}
+
+FeatureType VectorTileLayerData::getType(std::size_t i) const {
+    switch (features[i].feature.getType()) {
     case mapbox::vector_tile::GeomType::POINT:
         return FeatureType::Point;
     case mapbox::vector_tile::GeomType::LINESTRING:
@@ -21,69 +55,122 @@ FeatureType VectorTileFeature::getType() const {
     }
 }
 
+optional<FeatureIdentifier> VectorTileLayerData::getID(std::size_t i) const {
+    return features[i].feature.getID();
+}
+
+const PropertyMap& VectorTileLayerData::getProperties(std::size_t i) const {
+    Feature& feature = features[i];
+    std::call_once(feature.propertiesDecoded, [&] {
+        feature.properties = feature.feature.getProperties();
+    });
+    return feature.properties;
+}
+
+const GeometryCollection& VectorTileLayerData::getGeometries(std::size_t i) const {
+    Feature& feature = features[i];
+    std::call_once(feature.geometriesDecoded, [&] {
+        const float scale = float(util::EXTENT) / feature.feature.getExtent();
+        feature.geometries = feature.feature.getGeometries<GeometryCollection>(scale);
+        if (feature.feature.getVersion() < 2 && feature.feature.getType() == mapbox::vector_tile::GeomType::POLYGON) {
+            feature.geometries = fixupPolygons(feature.geometries);
+        }
+    });
+    return feature.geometries;
+}
+
+VectorTileFeature::VectorTileFeature(std::shared_ptr<const VectorTileLayerData> layer_,
+                                     std::size_t index_)
+    : layer(std::move(layer_)), index(index_) {
+}
+
+FeatureType VectorTileFeature::getType() const {
+    return layer->getType(index);
+}
+
 optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    return feature.getValue(key);
+    const PropertyMap& properties = layer->getProperties(index);
+    auto it = properties.find(key);
+    if (it == properties.end()) {
+        return {};
+    }
+    return it->second;
 }
 
 std::unordered_map<std::string, Value> VectorTileFeature::getProperties() const {
-    return feature.getProperties();
+    return layer->getProperties(index);
 }
 
 optional<FeatureIdentifier> VectorTileFeature::getID() const {
-    return feature.getID();
+    return layer->getID(index);
 }
 
 GeometryCollection VectorTileFeature::getGeometries() const {
-    const float scale = float(util::EXTENT) / feature.getExtent();
-    auto lines = feature.getGeometries<GeometryCollection>(scale);
-    if (feature.getVersion() >= 2 || feature.getType() != mapbox::vector_tile::GeomType::POLYGON) {
-        return lines;
-    } else {
-        return fixupPolygons(lines);
-    }
+    return layer->getGeometries(index);
 }
 
-VectorTileLayer::VectorTileLayer(std::shared_ptr<const std::string> data_,
-                                 const protozero::data_view& view)
-    : data(std::move(data_)), layer(view) {
+VectorTileLayer::VectorTileLayer(std::shared_ptr<const VectorTileLayerData> layer_)
+    : layer(std::move(layer_)) {
 }
 
 std::size_t VectorTileLayer::featureCount() const {
-    return layer.featureCount();
+    return layer->featureCount();
 }
 
 std::unique_ptr<GeometryTileFeature> VectorTileLayer::getFeature(std::size_t i) const {
-    return std::make_unique<VectorTileFeature>(layer, layer.getFeature(i));
+    return std::make_unique<VectorTileFeature>(layer, i);
 }
 
 std::string VectorTileLayer::getName() const {
-    return layer.getName();
+    return layer->getName();
+}
+
+VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
+    : VectorTileData(data_, protozero::data_view(data_->data(), data_->size())) {
+}
+
+VectorTileData::VectorTileData(const util::MappedData& data_)
+    : VectorTileData(data_.getFile(), protozero::data_view(data_.data(), data_.size())) {
 }
 
-VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_) : data(std::move(data_)) {
+VectorTileData::VectorTileData(std::shared_ptr<const void> data_, const protozero::data_view& view_)
+    : data(std::move(data_)), view(view_) {
 }
 
 std::unique_ptr<GeometryTileData> VectorTileData::clone() const {
-    return std::make_unique<VectorTileData>(data);
+    return std::unique_ptr<GeometryTileData>(new VectorTileData(data, view));
 }
 
 std::unique_ptr<GeometryTileLayer> VectorTileData::getLayer(const std::string& name) const {
+    // Feature queries may read the tile while it's shared with the render thread.
+    std::lock_guard<std::mutex> lock(mutex);
+
     if (!parsed) {
         // We're parsing this lazily so that we can construct VectorTileData objects on the main
         // thread without incurring the overhead of parsing immediately.
-        layers = mapbox::vector_tile::buffer(*data).getLayers();
+        layers = readLayers(view);
         parsed = true;
     }
 
     auto it = layers.find(name);
-    if (it != layers.end()) {
-        return std::make_unique<VectorTileLayer>(data, it->second);
+    if (it == layers.end()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<const VectorTileLayerData> layer = decodedLayers[name].lock();
+    if (!layer) {
+        layer = std::make_shared<VectorTileLayerData>(data, it->second);
+        decodedLayers[name] = layer;
     }
-    return nullptr;
+    return std::make_unique<VectorTileLayer>(std::move(layer));
 }
 
 std::vector<std::string> VectorTileData::layerNames() const {
-    return mapbox::vector_tile::buffer(*data).layerNames();
+    std::vector<std::string> names;
+    for (const auto& layer : readLayers(view)) {
+        names.push_back(layer.first);
+    }
+    return names;
 }
 
 } // namespace mbgl
@@ -3,15 +3,55 @@
 #include <mapbox/vector_tile.hpp>
 #include <protozero/pbf_reader.hpp>
 
+#include <deque>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
 #include <utility>
 
 namespace mbgl {
 
+namespace util {
+class MappedData;
+} // namespace util
+
+// The features of a single source layer. Each feature's properties and geometries are decoded at
+// most once, the first time they're read, and then shared by all style layers that use the source
+// layer. Decoding is safe to do from several threads at once.
+class VectorTileLayerData {
+public:
+    VectorTileLayerData(std::shared_ptr<const void> data, const protozero::data_view&);
+
+    std::size_t featureCount() const;
+    std::string getName() const;
+
+    FeatureType getType(std::size_t) const;
+    optional<FeatureIdentifier> getID(std::size_t) const;
+    const PropertyMap& getProperties(std::size_t) const;
+    const GeometryCollection& getGeometries(std::size_t) const;
+
+private:
+    struct Feature {
+        Feature(const protozero::data_view&, const mapbox::vector_tile::layer&);
+
+        const mapbox::vector_tile::feature feature;
+
+        std::once_flag propertiesDecoded;
+        PropertyMap properties;
+
+        std::once_flag geometriesDecoded;
+        GeometryCollection geometries;
+    };
+
+    // Keeps the tile data that the layer refers to alive.
+    std::shared_ptr<const void> data;
+    const mapbox::vector_tile::layer layer;
+    mutable std::deque<Feature> features;
+};
+
 class VectorTileFeature : public GeometryTileFeature {
 public:
-    VectorTileFeature(const mapbox::vector_tile::layer&, const protozero::data_view&);
+    VectorTileFeature(std::shared_ptr<const VectorTileLayerData>, std::size_t index);
 
     FeatureType getType() const override;
     optional<Value> getValue(const std::string& key) const override;
@@ -20,35 +60,49 @@ public:
     GeometryCollection getGeometries() const override;
 
 private:
-    mapbox::vector_tile::feature feature;
+    std::shared_ptr<const VectorTileLayerData> layer;
+    const std::size_t index;
 };
 
 class VectorTileLayer : public GeometryTileLayer {
 public:
-    VectorTileLayer(std::shared_ptr<const std::string> data, const protozero::data_view&);
+    VectorTileLayer(std::shared_ptr<const VectorTileLayerData>);
 
     std::size_t featureCount() const override;
     std::unique_ptr<GeometryTileFeature> getFeature(std::size_t i) const override;
     std::string getName() const override;
 
 private:
-    std::shared_ptr<const std::string> data;
-    mapbox::vector_tile::layer layer;
+    std::shared_ptr<const VectorTileLayerData> layer;
 };
 
 class VectorTileData : public GeometryTileData {
 public:
     VectorTileData(std::shared_ptr<const std::string> data);
 
+    // Reads the tile in place from the mapped file.
+    VectorTileData(const util::MappedData&);
+
     std::unique_ptr<GeometryTileData> clone() const override;
     std::unique_ptr<GeometryTileLayer> getLayer(const std::string& name) const override;
 
     std::vector<std::string> layerNames() const;
 
 private:
-    std::shared_ptr<const std::string> data;
+    VectorTileData(std::shared_ptr<const void> data, const protozero::data_view&);
+
+    // Owns the memory that `view` refers to, which is either a string or a mapped file.
+    std::shared_ptr<const void> data;
+    const protozero::data_view view;
+
+    mutable std::mutex mutex;
     mutable bool parsed = false;
     mutable std::map<std::string, const protozero::data_view> layers;
+
+    // Decoded layers are shared by all GeometryTileLayer objects obtained for the same name while
+    // any of them is alive, and released with the last one so that decoded features don't
+    // outlive the layout that needed them.
+    mutable std::map<std::string, std::weak_ptr<const VectorTileLayerData>> decodedLayers;
 };
 
 } // namespace mbgl
@@ -82,4 +82,6 @@ int32_t GridIndex<T>::convertToCellCoord(int32_t x) const {
 }
 
 template class GridIndex<IndexedSubfeature>;
+template class GridIndex<std::size_t>;
+
 } // namespace mbgl
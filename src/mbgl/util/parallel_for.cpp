@@ -0,0 +1,105 @@
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/actor/mailbox.hpp>
+#include <mbgl/actor/message.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Shared between the caller and its helpers. Helpers that only run after the caller returned
+// find no indices left, and never touch `fn`.
+class ParallelFor {
+public:
+    ParallelFor(std::size_t count_, const std::function<void (std::size_t)>& fn_)
+        : count(count_), fn(fn_) {}
+
+    void run() {
+        for (std::size_t i = next++; i < count; i = next++) {
+            std::exception_ptr error;
+            try {
+                fn(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (error && !firstError) {
+                firstError = error;
+            }
+            if (++finished == count) {
+                cv.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return finished == count; });
+        if (firstError) {
+            std::rethrow_exception(firstError);
+        }
+    }
+
+private:
+    const std::size_t count;
+    const std::function<void (std::size_t)>& fn;
+
+    std::atomic<std::size_t> next { 0 };
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t finished = 0;
+    std::exception_ptr firstError;
+};
+
+class ParallelForMessage : public Message {
+public:
+    ParallelForMessage(std::shared_ptr<ParallelFor> state_)
+        : state(std::move(state_)) {}
+
+    void operator()() override {
+        state->run();
+    }
+
+private:
+    std::shared_ptr<ParallelFor> state;
+};
+
+} // namespace
+
+void parallelFor(Scheduler& scheduler,
+                 std::size_t count,
+                 std::size_t helpers,
+                 const std::function<void (std::size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelFor>(count, fn);
+
+    // Each helper needs a mailbox of its own, since a mailbox is never processed concurrently.
+    // Helpers work on behalf of a caller that is already running, so let them go first.
+    std::vector<std::shared_ptr<Mailbox>> mailboxes;
+    helpers = std::min(helpers, count - 1);
+    mailboxes.reserve(helpers);
+    for (std::size_t i = 0; i < helpers; ++i) {
+        mailboxes.push_back(std::make_shared<Mailbox>(scheduler));
+        mailboxes.back()->setPriority(Mailbox::Priority::High);
+        mailboxes.back()->push(std::make_unique<ParallelForMessage>(state));
+    }
+
+    state->run();
+    state->wait();
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace mbgl {
+
+class Scheduler;
+
+namespace util {
+
+// Calls `fn` once for each index in [0, count), and returns once all calls have completed.
+// Up to `helpers` additional mailboxes are scheduled on the given scheduler to share the work,
+// while the calling thread processes indices as well. Since the caller never waits for an index
+// that hasn't been started yet, this is safe to call from a thread of the same scheduler, even if
+// all of its other threads are busy. If any call throws, the first exception is rethrown after
+// all calls have completed.
+void parallelFor(Scheduler&,
+                 std::size_t count,
+                 std::size_t helpers,
+                 const std::function<void (std::size_t)>& fn);
+
+} // namespace util
+} // namespace mbgl
@@ -2,9 +2,161 @@
 
 #include <cmath>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MBGL_PREMULTIPLY_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MBGL_PREMULTIPLY_NEON
+#endif
+
 namespace mbgl {
 namespace util {
 
+namespace {
+
+// The vector kernels produce exactly the same results as the scalar code below, which handles the
+// pixels that remain after the last full vector. Division by 255 is computed as
+// (x + 1 + (x >> 8)) >> 8, which is exact for all x < 65535. Division by alpha is computed in
+// single precision, which is exact for the range of numerators and denominators involved.
+
+#if defined(MBGL_PREMULTIPLY_SSE2)
+
+// Premultiplies two pixels whose channels are widened to 16 bits.
+inline __m128i premultiplyPixels(const __m128i pixels) {
+    const __m128i colorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaFactor = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+
+    // Multiply the colors by alpha, and alpha by 255 so that it is left unchanged.
+    const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)),
+                                              _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i factor = _mm_or_si128(_mm_and_si128(alpha, colorMask), alphaFactor);
+    const __m128i x = _mm_add_epi16(_mm_mullo_epi16(pixels, factor), _mm_set1_epi16(127));
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+std::size_t premultiplyVector(uint8_t* data, const std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = premultiplyPixels(_mm_unpacklo_epi8(pixels, zero));
+        const __m128i hi = premultiplyPixels(_mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), _mm_packus_epi16(lo, hi));
+    }
+    return i;
+}
+
+// Unpremultiplies one pixel whose channels are widened to 32 bits.
+inline __m128i unpremultiplyPixel(const __m128i pixel) {
+    const __m128i alpha = _mm_shuffle_epi32(pixel, _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i numerator = _mm_add_epi32(_mm_sub_epi32(_mm_slli_epi32(pixel, 8), pixel),
+                                            _mm_srli_epi32(alpha, 1));
+    const __m128i quotient = _mm_cvttps_epi32(
+        _mm_div_ps(_mm_cvtepi32_ps(numerator), _mm_cvtepi32_ps(alpha)));
+
+    // Colors greater than alpha overflow; keep the low byte, as the scalar code does.
+    return _mm_and_si128(quotient, _mm_set1_epi32(0xFF));
+}
+
+std::size_t unpremultiplyVector(uint8_t* data, const std::size_t bytes) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    std::size_t i = 0;
+    for (; i + 16 <= bytes; i += 16) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i lo = _mm_unpacklo_epi8(pixels, zero);
+        const __m128i hi = _mm_unpackhi_epi8(pixels, zero);
+        const __m128i result = _mm_packus_epi16(
+            _mm_packs_epi32(unpremultiplyPixel(_mm_unpacklo_epi16(lo, zero)),
+                            unpremultiplyPixel(_mm_unpackhi_epi16(lo, zero))),
+            _mm_packs_epi32(unpremultiplyPixel(_mm_unpacklo_epi16(hi, zero)),
+                            unpremultiplyPixel(_mm_unpackhi_epi16(hi, zero))));
+
+        // Keep alpha, and the colors of fully transparent pixels.
+        const __m128i keep = _mm_or_si128(
+            _mm_cmpeq_epi32(_mm_and_si128(pixels, alphaMask), zero), alphaMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i),
+                         _mm_or_si128(_mm_and_si128(keep, pixels), _mm_andnot_si128(keep, result)));
+    }
+    return i;
+}
+
+#elif defined(MBGL_PREMULTIPLY_NEON)
+
+inline uint8x8_t divide255(const uint16x8_t x) {
+    return vshrn_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+inline uint8x16_t premultiplyChannel(const uint8x16_t color, const uint8x16_t alpha) {
+    const uint16x8_t bias = vdupq_n_u16(127);
+    const uint16x8_t lo = vaddq_u16(vmull_u8(vget_low_u8(color), vget_low_u8(alpha)), bias);
+    const uint16x8_t hi = vaddq_u16(vmull_high_u8(color, alpha), bias);
+    return vcombine_u8(divide255(lo), divide255(hi));
+}
+
+std::size_t premultiplyVector(uint8_t* data, const std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        uint8x16x4_t pixels = vld4q_u8(data + i);
+        pixels.val[0] = premultiplyChannel(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = premultiplyChannel(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = premultiplyChannel(pixels.val[2], pixels.val[3]);
+        vst4q_u8(data + i, pixels);
+    }
+    return i;
+}
+
+inline uint16x4_t unpremultiplyQuarter(const uint16x4_t color, const uint16x4_t alpha) {
+    const uint32x4_t c = vmovl_u16(color);
+    const uint32x4_t a = vmovl_u16(alpha);
+    const uint32x4_t numerator = vaddq_u32(vsubq_u32(vshlq_n_u32(c, 8), c), vshrq_n_u32(a, 1));
+    const uint32x4_t quotient = vcvtq_u32_f32(vdivq_f32(vcvtq_f32_u32(numerator), vcvtq_f32_u32(a)));
+
+    // Colors greater than alpha overflow; keep the low byte, as the scalar code does.
+    return vmovn_u32(vandq_u32(quotient, vdupq_n_u32(0xFF)));
+}
+
+inline uint8x8_t unpremultiplyHalf(const uint16x8_t color, const uint16x8_t alpha) {
+    return vmovn_u16(vcombine_u16(unpremultiplyQuarter(vget_low_u16(color), vget_low_u16(alpha)),
+                                  unpremultiplyQuarter(vget_high_u16(color), vget_high_u16(alpha))));
+}
+
+inline uint8x16_t unpremultiplyChannel(const uint8x16_t color, const uint8x16_t alpha) {
+    const uint8x16_t result = vcombine_u8(
+        unpremultiplyHalf(vmovl_u8(vget_low_u8(color)), vmovl_u8(vget_low_u8(alpha))),
+        unpremultiplyHalf(vmovl_high_u8(color), vmovl_high_u8(alpha)));
+
+    // Keep the colors of fully transparent pixels.
+    return vbslq_u8(vceqq_u8(alpha, vdupq_n_u8(0)), color, result);
+}
+
+std::size_t unpremultiplyVector(uint8_t* data, const std::size_t bytes) {
+    std::size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        uint8x16x4_t pixels = vld4q_u8(data + i);
+        pixels.val[0] = unpremultiplyChannel(pixels.val[0], pixels.val[3]);
+        pixels.val[1] = unpremultiplyChannel(pixels.val[1], pixels.val[3]);
+        pixels.val[2] = unpremultiplyChannel(pixels.val[2], pixels.val[3]);
+        vst4q_u8(data + i, pixels);
+    }
+    return i;
+}
+
+#else
+
+std::size_t premultiplyVector(uint8_t*, std::size_t) {
+    return 0;
+}
+
+std::size_t unpremultiplyVector(uint8_t*, std::size_t) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
 PremultipliedImage premultiply(UnassociatedImage&& src) {
     PremultipliedImage dst;
 
@@ -13,7 +165,7 @@ PremultipliedImage premultiply(UnassociatedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    for (size_t i = premultiplyVector(data, dst.bytes()); i < dst.bytes(); i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -34,7 +186,7 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
     dst.data = std::move(src.data);
 
     uint8_t* data = dst.data.get();
-    for (size_t i = 0; i < dst.bytes(); i += 4) {
+    for (size_t i = unpremultiplyVector(data, dst.bytes()); i < dst.bytes(); i += 4) {
         uint8_t& r = data[i + 0];
         uint8_t& g = data[i + 1];
         uint8_t& b = data[i + 2];
@@ -49,5 +201,15 @@ UnassociatedImage unpremultiply(PremultipliedImage&& src) {
     return dst;
 }
 
+template <>
+UnassociatedImage convertImage<ImageAlphaMode::Unassociated>(UnassociatedImage&& image) {
+    return std::move(image);
+}
+
+template <>
+PremultipliedImage convertImage<ImageAlphaMode::Premultiplied>(UnassociatedImage&& image) {
+    return premultiply(std::move(image));
+}
+
 } // namespace util
 } // namespace mbgl
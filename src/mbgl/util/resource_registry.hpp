@@ -0,0 +1,98 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace mbgl {
+namespace util {
+
+// A process-wide registry of immutable resources parsed from downloaded data, such as style
+// layers, sprite images and glyphs. Maps that load the same data share the parsed result instead
+// of parsing and storing it again.
+//
+// Resources are keyed by their URL and a hash of the data they were parsed from, so a resource
+// that changed on the server is parsed anew. The registry holds them weakly: a resource stays
+// registered only as long as some map holds on to the pointer returned by find() or insert().
+//
+// The registry is thread-safe. Parsing happens outside of it, so two maps that load the same
+// resource at the same time may both parse it; the first one to be inserted wins.
+template <class T>
+class ResourceRegistry : private util::noncopyable {
+public:
+    class Key {
+    public:
+        template <class... Data>
+        Key(std::string url_, const Data&... data)
+            : url(std::move(url_)) {
+            for (const std::string* d : { &data... }) {
+                boost::hash_combine(hash, d->size());
+                boost::hash_combine(hash, std::hash<std::string>()(*d));
+            }
+        }
+
+        bool operator<(const Key& other) const {
+            return std::tie(hash, url) < std::tie(other.hash, other.url);
+        }
+
+    private:
+        std::string url;
+        std::size_t hash = 0;
+    };
+
+    static ResourceRegistry& get() {
+        static ResourceRegistry registry;
+        return registry;
+    }
+
+    // Returns the resource registered under the key, if any map still uses it.
+    std::shared_ptr<const T> find(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        return it == entries.end() ? nullptr : it->second.lock();
+    }
+
+    // Registers the resource, unless one was registered under the same key in the meantime, and
+    // returns the registered one.
+    std::shared_ptr<const T> insert(const Key& key, T&& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Drop the entries of resources that are no longer used.
+        for (auto it = entries.begin(); it != entries.end();) {
+            it = it->second.expired() ? entries.erase(it) : std::next(it);
+        }
+
+        std::weak_ptr<const T>& entry = entries[key];
+        if (auto existing = entry.lock()) {
+            return existing;
+        }
+
+        auto result = std::make_shared<const T>(std::move(value));
+        entry = result;
+        return result;
+    }
+
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t count = 0;
+        for (const auto& entry : entries) {
+            count += !entry.second.expired();
+        }
+        return count;
+    }
+
+private:
+    ResourceRegistry() = default;
+
+    std::mutex mutex;
+    std::map<Key, std::weak_ptr<const T>> entries;
+};
+
+} // namespace util
+} // namespace mbgl
@@ -281,3 +281,101 @@ TEST(Actor, NonConcurrentMailbox) {
     test.invoke(&Test::end);
     endedFuture.wait();
 }
+
+TEST(Actor, OrderedMailboxesUnderContention) {
+    // Per-mailbox ordering holds when many actors share a pool and
+    // messages are sent from both worker and non-worker threads.
+
+    struct Test {
+        ActorRef<Test> self;
+        int last = 0;
+        std::atomic<int>& remaining;
+        std::promise<void>& promise;
+
+        Test(ActorRef<Test> self_, std::atomic<int>& remaining_, std::promise<void>& promise_)
+            : self(std::move(self_)), remaining(remaining_), promise(promise_) {
+        }
+
+        void receive(int i) {
+            EXPECT_EQ(i, last + 1);
+            last = i;
+            // Self-send from a worker thread to exercise worker-local queues.
+            self.invoke(&Test::done);
+        }
+
+        void done() {
+            if (--remaining == 0) {
+                promise.set_value();
+            }
+        }
+    };
+
+    ThreadPool pool { 4 };
+
+    const int actorCount = 64;
+    const int messageCount = 100;
+    std::atomic<int> remaining { actorCount * messageCount };
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+
+    std::vector<std::unique_ptr<Actor<Test>>> actors;
+    for (int i = 0; i < actorCount; ++i) {
+        actors.emplace_back(std::make_unique<Actor<Test>>(pool, std::ref(remaining), std::ref(endedPromise)));
+    }
+
+    for (int i = 1; i <= messageCount; ++i) {
+        for (auto& actor : actors) {
+            actor->invoke(&Test::receive, i);
+        }
+    }
+
+    ASSERT_EQ(std::future_status::ready, endedFuture.wait_for(std::chrono::seconds(10)));
+}
+
+TEST(Actor, PrioritizedMailbox) {
+    // Higher priority mailboxes are processed before lower priority ones that were
+    // scheduled earlier.
+
+    struct Test {
+        std::vector<int>& order;
+
+        Test(ActorRef<Test>, std::vector<int>& order_)
+            : order(order_) {
+        }
+
+        void block(std::shared_future<void> future) {
+            future.wait();
+        }
+
+        void receive(int i) {
+            order.push_back(i);
+        }
+
+        void end(std::promise<void> promise) {
+            promise.set_value();
+        }
+    };
+
+    ThreadPool pool { 1 };
+
+    std::vector<int> order;
+    std::promise<void> unblockPromise;
+    std::promise<void> endedPromise;
+    std::future<void> endedFuture = endedPromise.get_future();
+
+    Actor<Test> blocker(pool, std::ref(order));
+    Actor<Test> low(pool, std::ref(order));
+    Actor<Test> high(pool, std::ref(order));
+    low.setPriority(Mailbox::Priority::Low);
+    high.setPriority(Mailbox::Priority::High);
+
+    // Occupy the only worker so that both mailboxes are queued before either runs.
+    blocker.invoke(&Test::block, unblockPromise.get_future().share());
+    low.invoke(&Test::receive, 2);
+    low.invoke(&Test::end, std::move(endedPromise));
+    high.invoke(&Test::receive, 1);
+    unblockPromise.set_value();
+
+    endedFuture.wait();
+    EXPECT_EQ((std::vector<int> { 1, 2 }), order);
+}
@@ -0,0 +1,141 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/backend_scope.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/metatile_renderer.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/style/style.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A style whose left and right halves have different colors, so that the position of each
+// slice can be told apart.
+const char* metatileStyle = R"STYLE({
+  "version": 8,
+  "sources": {
+    "geojson": {
+      "type": "geojson",
+      "data": {
+        "type": "Polygon",
+        "coordinates": [[[0, -85], [180, -85], [180, 85], [0, 85], [0, -85]]]
+      }
+    }
+  },
+  "layers": [{
+    "id": "background",
+    "type": "background",
+    "paint": { "background-color": "#f00" }
+  }, {
+    "id": "fill",
+    "type": "fill",
+    "source": "geojson",
+    "paint": { "fill-color": "#00f", "fill-antialias": false }
+  }]
+})STYLE";
+
+std::vector<MetatileRenderer::Tile> renderMetatile(MetatileRenderer& renderer,
+                                                   uint8_t z, uint32_t x, uint32_t y) {
+    util::RunLoop& loop = *util::RunLoop::Get();
+    std::vector<MetatileRenderer::Tile> result;
+    bool done = false;
+    renderer.render(z, x, y, [&](std::exception_ptr error, std::vector<MetatileRenderer::Tile> tiles) {
+        EXPECT_FALSE(error);
+        result = std::move(tiles);
+        done = true;
+    });
+    while (!done) {
+        loop.runOnce();
+    }
+    return result;
+}
+
+// Returns the red and blue components of the pixel at the center of the image.
+std::pair<uint8_t, uint8_t> centerColor(const PremultipliedImage& image) {
+    const uint8_t* pixel = image.data.get() +
+        (image.size.height / 2) * image.stride() + (image.size.width / 2) * 4;
+    return { pixel[0], pixel[2] };
+}
+
+} // namespace
+
+TEST(API, Metatile) {
+    util::RunLoop loop;
+
+    HeadlessBackend backend { test::sharedDisplay() };
+    BackendScope scope { backend };
+    DefaultFileSource fileSource(":memory:", "test/fixtures/api/assets");
+    ThreadPool threadPool(4);
+
+    Map map(backend, { 256, 256 }, 1, fileSource, threadPool, MapMode::Still);
+    map.getStyle().loadJSON(metatileStyle);
+
+    MetatileRenderer renderer(map, backend.getContext(), 1, 2, 256);
+
+    // At zoom level 2, the metatile containing 2/3/1 is made up of tiles 2/2/0 through 2/3/1,
+    // all of which are in the eastern hemisphere.
+    auto tiles = renderMetatile(renderer, 2, 3, 1);
+    ASSERT_EQ(4u, tiles.size());
+    EXPECT_EQ(2u, tiles[0].x);
+    EXPECT_EQ(0u, tiles[0].y);
+    EXPECT_EQ(3u, tiles[1].x);
+    EXPECT_EQ(0u, tiles[1].y);
+    EXPECT_EQ(2u, tiles[2].x);
+    EXPECT_EQ(1u, tiles[2].y);
+    EXPECT_EQ(3u, tiles[3].x);
+    EXPECT_EQ(1u, tiles[3].y);
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(Size(256, 256), tile.image.size);
+        EXPECT_EQ(std::make_pair(uint8_t(0), uint8_t(255)), centerColor(tile.image));
+    }
+
+    // The western half of the world is drawn with the background color.
+    tiles = renderMetatile(renderer, 2, 0, 2);
+    ASSERT_EQ(4u, tiles.size());
+    EXPECT_EQ(0u, tiles[0].x);
+    EXPECT_EQ(2u, tiles[0].y);
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(std::make_pair(uint8_t(255), uint8_t(0)), centerColor(tile.image));
+    }
+
+    // At zoom level 0, the metatile is narrowed to the single tile of the world.
+    tiles = renderMetatile(renderer, 0, 0, 0);
+    ASSERT_EQ(1u, tiles.size());
+    EXPECT_EQ(Size(256, 256), tiles[0].image.size);
+}
+
+TEST(API, MetatileFractionalPixelRatio) {
+    util::RunLoop loop;
+
+    HeadlessBackend backend { test::sharedDisplay() };
+    BackendScope scope { backend };
+    DefaultFileSource fileSource(":memory:", "test/fixtures/api/assets");
+    ThreadPool threadPool(4);
+
+    Map map(backend, { 256, 256 }, 1.5, fileSource, threadPool, MapMode::Still);
+    map.getStyle().loadJSON(metatileStyle);
+
+    // A buffer of 1 pixel would be 1.5 pixels in the rendered image.
+    EXPECT_THROW(MetatileRenderer(map, backend.getContext(), 1.5, 2, 256, 1), std::invalid_argument);
+
+    MetatileRenderer renderer(map, backend.getContext(), 1.5, 2, 256, 2);
+
+    auto tiles = renderMetatile(renderer, 1, 1, 0);
+    ASSERT_EQ(4u, tiles.size());
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(Size(384, 384), tile.image.size);
+    }
+    EXPECT_EQ(std::make_pair(uint8_t(255), uint8_t(0)), centerColor(tiles[0].image));
+    EXPECT_EQ(std::make_pair(uint8_t(0), uint8_t(255)), centerColor(tiles[1].image));
+
+    // Zoom levels beyond the map's maximum, and tiles outside of the world, are rejected.
+    EXPECT_THROW(renderer.render(uint8_t(map.getMaxZoom() + 1), 0, 0, [](std::exception_ptr, std::vector<MetatileRenderer::Tile>) {}),
+                 std::domain_error);
+    EXPECT_THROW(renderer.render(1, 2, 0, [](std::exception_ptr, std::vector<MetatileRenderer::Tile>) {}),
+                 std::domain_error);
+}
@@ -84,6 +84,46 @@ TEST(Query, QueryRenderedFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+    const auto expected = test.map.queryRenderedFeatures(zz, {{{ "layer1", "layer2" }}, {}});
+    ASSERT_EQ(expected.size(), 2u);
+
+    test.map.queryRenderedFeatures(zz, {{{ "layer1", "layer2" }}, {}}, [&] (std::vector<Feature> features) {
+        ASSERT_EQ(expected.size(), features.size());
+        for (std::size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i].properties, features[i].properties);
+        }
+        test.loop.stop();
+    });
+
+    test.loop.run();
+}
+
+TEST(Query, QueryRenderedFeaturesAsyncSnapshot) {
+    QueryTest test;
+
+    auto zz = test.map.pixelForLatLng({ 0, 0 });
+
+    bool received = false;
+    test.map.queryRenderedFeatures(zz, {}, [&] (std::vector<Feature> features) {
+        EXPECT_EQ(features.size(), 4u);
+        received = true;
+        test.loop.stop();
+    });
+
+    // The query covers the layers and tiles as they were when it was issued.
+    test.map.getStyle().loadJSON(R"STYLE({ "version": 8, "sources": {}, "layers": [] })STYLE");
+    test::render(test.map, test.view);
+
+    if (!received) {
+        test.loop.run();
+    }
+    EXPECT_TRUE(received);
+}
+
 TEST(Query, QuerySourceFeatures) {
     QueryTest test;
 
@@ -123,3 +163,57 @@ TEST(Query, QuerySourceFeaturesFilter) {
     EXPECT_EQ(features3.size(), 1u);
 }
 
+TEST(Query, QuerySourceFeaturesBounds) {
+    QueryTest test;
+
+    SourceQueryOptions options;
+    options.bounds = LatLngBounds::hull({ -1, -1 }, { 1, 1 });
+    auto features1 = test.map.querySourceFeatures("source4", options);
+    EXPECT_EQ(features1.size(), 1u);
+
+    options.bounds = LatLngBounds::hull({ 10, 10 }, { 11, 11 });
+    auto features2 = test.map.querySourceFeatures("source4", options);
+    EXPECT_EQ(features2.size(), 0u);
+}
+
+TEST(Query, QuerySourceFeaturesLimit) {
+    QueryTest test;
+
+    SourceQueryOptions options;
+    options.limit = 0;
+    auto features1 = test.map.querySourceFeatures("source4", options);
+    EXPECT_EQ(features1.size(), 0u);
+
+    options.limit = 1;
+    auto features2 = test.map.querySourceFeatures("source4", options);
+    EXPECT_EQ(features2.size(), 1u);
+}
+
+TEST(Query, QuerySourceFeaturesProperties) {
+    QueryTest test;
+
+    SourceQueryOptions options;
+    options.properties = std::vector<std::string> { "key1", "key4", "unknown" };
+    auto features = test.map.querySourceFeatures("source4", options);
+    ASSERT_EQ(features.size(), 1u);
+    EXPECT_EQ(features[0].properties.size(), 2u);
+    EXPECT_EQ(features[0].properties.count("key1"), 1u);
+    EXPECT_EQ(features[0].properties.count("key4"), 1u);
+}
+
+TEST(Query, QuerySourceFeaturesAsync) {
+    QueryTest test;
+
+    const EqualsFilter eqFilter = { "key1", std::string("value1") };
+    test.map.querySourceFeatures("source4", {{}, { eqFilter }}, [&] (std::vector<Feature> features) {
+        EXPECT_EQ(features.size(), 1u);
+
+        // Unknown sources still call back.
+        test.map.querySourceFeatures("foobar", {}, [&] (std::vector<Feature> none) {
+            EXPECT_TRUE(none.empty());
+            test.loop.stop();
+        });
+    });
+
+    test.loop.run();
+}
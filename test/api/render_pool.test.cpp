@@ -0,0 +1,110 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/util/render_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+std::string backgroundStyle(const std::string& color) {
+    return R"STYLE({
+  "version": 8,
+  "sources": {},
+  "layers": [{
+    "id": "background",
+    "type": "background",
+    "paint": { "background-color": ")STYLE" + color + R"STYLE(" }
+  }]
+})STYLE";
+}
+
+} // namespace
+
+TEST(API, RenderPool) {
+    util::RunLoop loop;
+
+    DefaultFileSource fileSource(":memory:", "test/fixtures/api/assets");
+    ThreadPool threadPool(4);
+    RenderPool pool(2, fileSource, threadPool, 2, test::sharedDisplay());
+    EXPECT_EQ(2u, pool.getSize());
+
+    // More jobs than threads, alternating between two styles, so that jobs are queued and
+    // threads switch styles.
+    const std::vector<std::string> styles { backgroundStyle("#f00"), backgroundStyle("#00f") };
+    const size_t count = 6;
+    std::vector<PremultipliedImage> images(count);
+    size_t finished = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        RenderPool::Job job;
+        job.style = styles[i % 2];
+        job.size = { 64, 32 };
+        job.camera.zoom = 1;
+        pool.render(std::move(job), [&, i](std::exception_ptr error, PremultipliedImage image) {
+            EXPECT_FALSE(error);
+            images[i] = std::move(image);
+            finished++;
+        });
+    }
+
+    while (finished < count) {
+        loop.runOnce();
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        // The image size includes the pixel ratio.
+        ASSERT_EQ(Size(128, 64), images[i].size);
+        const uint8_t* pixel = images[i].data.get();
+        EXPECT_EQ(i % 2 ? 0 : 255, pixel[0]);
+        EXPECT_EQ(i % 2 ? 255 : 0, pixel[2]);
+    }
+}
+
+TEST(API, RenderPoolStyleError) {
+    util::RunLoop loop;
+
+    DefaultFileSource fileSource(":memory:", "test/fixtures/api/assets");
+    ThreadPool threadPool(4);
+    RenderPool pool(1, fileSource, threadPool, 1, test::sharedDisplay());
+
+    RenderPool::Job job;
+    job.style = "invalid";
+    bool done = false;
+    pool.render(std::move(job), [&](std::exception_ptr error, PremultipliedImage image) {
+        EXPECT_TRUE(error);
+        EXPECT_FALSE(image.valid());
+        done = true;
+    });
+
+    while (!done) {
+        loop.runOnce();
+    }
+}
+
+TEST(API, RenderPoolDestroy) {
+    util::RunLoop loop;
+
+    DefaultFileSource fileSource(":memory:", "test/fixtures/api/assets");
+    ThreadPool threadPool(4);
+    bool called = false;
+
+    {
+        RenderPool pool(2, fileSource, threadPool, 1, test::sharedDisplay());
+        for (size_t i = 0; i < 4; i++) {
+            RenderPool::Job job;
+            job.style = backgroundStyle("#f00");
+            pool.render(std::move(job), [&](std::exception_ptr, PremultipliedImage) {
+                called = true;
+            });
+        }
+    }
+
+    // Jobs that finished while the pool was being destroyed posted their callbacks to this loop,
+    // but they aren't called.
+    loop.runOnce();
+    EXPECT_FALSE(called);
+}
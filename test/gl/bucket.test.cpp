@@ -93,6 +93,61 @@ TEST(Buckets, SymbolBucket) {
     ASSERT_FALSE(bucket.needsUpload());
 }
 
+TEST(Buckets, SymbolBucketPlace) {
+    style::SymbolLayoutProperties::PossiblyEvaluated layout;
+    bool sdfIcons = false;
+    bool iconsNeedLinear = false;
+
+    gl::Context context;
+    SymbolBucket bucket { layout, {}, 16.0f, 1.0f, 0, sdfIcons, iconsNeedLinear };
+    for (int i = 0; i < 4; ++i) {
+        bucket.text.vertices.emplace_back(SymbolLayoutAttributes::vertex({ 0, 0 }, { 0, 0 }, 0, 0, 0, 1, 0));
+    }
+    bucket.text.triangles.emplace_back(0, 1, 2);
+    bucket.text.triangles.emplace_back(1, 2, 3);
+    bucket.text.segments.emplace_back(0, 0, 4, 6);
+
+    auto placeQuad = [](float labelMinZoom) {
+        SymbolPlacementBuffers placement;
+        for (int i = 0; i < 4; ++i) {
+            placement.text.vertices.emplace_back(SymbolPlacementAttributes::vertex(labelMinZoom));
+        }
+        return placement;
+    };
+
+    bucket.place(placeQuad(0));
+    ASSERT_TRUE(bucket.hasTextData());
+    ASSERT_TRUE(bucket.needsUpload());
+
+    bucket.upload(context);
+    ASSERT_FALSE(bucket.needsUpload());
+    const gl::BufferID vertexBuffer = bucket.text.vertexBuffer->buffer.get();
+    const gl::BufferID placementVertexBuffer = bucket.text.placementVertexBuffer->buffer.get();
+    const gl::BufferID indexBuffer = bucket.text.indexBuffer->buffer.get();
+
+    // Placing the symbols again only updates the placement vertices in place.
+    bucket.place(placeQuad(1));
+    ASSERT_TRUE(bucket.needsUpload());
+
+    bucket.upload(context);
+    ASSERT_FALSE(bucket.needsUpload());
+    ASSERT_EQ(vertexBuffer, bucket.text.vertexBuffer->buffer.get());
+    ASSERT_EQ(placementVertexBuffer, bucket.text.placementVertexBuffer->buffer.get());
+    ASSERT_EQ(indexBuffer, bucket.text.indexBuffer->buffer.get());
+    ASSERT_EQ(1u, bucket.text.segments.size());
+
+    // A placement that reorders the triangles updates them in place as well.
+    SymbolPlacementBuffers placement = placeQuad(2);
+    placement.text.triangles.emplace_back(1, 2, 3);
+    placement.text.triangles.emplace_back(0, 1, 2);
+    bucket.place(std::move(placement));
+    ASSERT_TRUE(bucket.needsUpload());
+
+    bucket.upload(context);
+    ASSERT_FALSE(bucket.needsUpload());
+    ASSERT_EQ(indexBuffer, bucket.text.indexBuffer->buffer.get());
+}
+
 TEST(Buckets, RasterBucket) {
     gl::Context context;
     UnassociatedImage rgba({ 1, 1 });
@@ -439,6 +439,48 @@ TEST(Map, WithoutVAOExtension) {
     test::checkImage("test/fixtures/map/no_vao", test::render(map, test.view), 0.002);
 }
 
+TEST(Map, RenderProfile) {
+    MapTest test;
+
+    Map map(test.backend, test.view.getSize(), 1, test.fileSource, test.threadPool, MapMode::Still);
+    map.getStyle().loadJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    auto layer = std::make_unique<BackgroundLayer>("background");
+    layer->setBackgroundColor({ { 1, 0, 0, 1 } });
+    map.getStyle().addLayer(std::move(layer));
+
+    EXPECT_EQ(0u, map.getRenderProfiling());
+    EXPECT_EQ(0u, map.getRenderProfile().frames);
+
+    map.setRenderProfiling(2);
+    EXPECT_EQ(2u, map.getRenderProfiling());
+
+    test::render(map, test.view);
+    test::render(map, test.view);
+    test::render(map, test.view);
+
+    const RenderProfile profile = map.getRenderProfile();
+    EXPECT_EQ(2u, profile.frames);
+    EXPECT_EQ(2u, profile.total.frames);
+
+    ASSERT_FALSE(profile.passes.empty());
+    EXPECT_EQ("upload", profile.passes.front().name);
+    Duration passes = Duration::zero();
+    for (const auto& pass : profile.passes) {
+        passes += pass.cpuTime;
+    }
+    EXPECT_LE(passes, profile.total.cpuTime);
+
+    ASSERT_EQ(1u, profile.layers.size());
+    EXPECT_EQ("background", profile.layers[0].name);
+    EXPECT_EQ(2u, profile.layers[0].frames);
+
+    EXPECT_NE(std::string::npos, profile.toJSON().find(R"("name":"background")"));
+
+    map.setRenderProfiling(0);
+    EXPECT_EQ(0u, map.getRenderProfile().frames);
+}
+
 TEST(Map, RemoveLayer) {
     MapTest test;
 
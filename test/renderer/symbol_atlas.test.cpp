@@ -0,0 +1,174 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/style/image_impl.hpp>
+#include <mbgl/util/image.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+Immutable<Glyph> makeGlyph(GlyphID id, Size size, uint8_t value) {
+    auto glyph = makeMutable<Glyph>();
+    glyph->id = id;
+    glyph->bitmap = AlphaImage(size);
+    glyph->bitmap.fill(value);
+    return Immutable<Glyph>(std::move(glyph));
+}
+
+Immutable<style::Image::Impl> makeImage(std::string id, Size size) {
+    PremultipliedImage image(size);
+    image.fill(255);
+    return makeMutable<style::Image::Impl>(std::move(id), std::move(image), 1.0f);
+}
+
+} // namespace
+
+TEST(SymbolAtlas, SharesGlyphsAndImages) {
+    SymbolAtlas atlas;
+
+    const FontStack fontStack { "Open Sans Regular" };
+    GlyphMap glyphMap;
+    glyphMap[fontStack][u'a'] = makeGlyph(u'a', { 10, 12 }, 255);
+    glyphMap[fontStack][u'b'] = makeGlyph(u'b', { 8, 12 }, 255);
+
+    ImageMap imageMap;
+    imageMap.emplace("one", makeImage("one", { 16, 16 }));
+
+    GlyphPositions glyphPositions1;
+    ImagePositions imagePositions1;
+    auto reference1 = atlas.add(glyphMap, imageMap, glyphPositions1, imagePositions1);
+
+    GlyphPositions glyphPositions2;
+    ImagePositions imagePositions2;
+    auto reference2 = atlas.add(glyphMap, imageMap, glyphPositions2, imagePositions2);
+
+    EXPECT_EQ(2u, atlas.glyphCount());
+    EXPECT_EQ(1u, atlas.iconCount());
+
+    const auto& a1 = glyphPositions1.at(fontStack).at(u'a').rect;
+    const auto& a2 = glyphPositions2.at(fontStack).at(u'a').rect;
+    EXPECT_EQ(a1, a2);
+    EXPECT_EQ(12, a1.w);
+    EXPECT_EQ(14, a1.h);
+
+    EXPECT_EQ(imagePositions1.at("one").textureRect, imagePositions2.at("one").textureRect);
+    EXPECT_EQ(16, imagePositions1.at("one").textureRect.w);
+
+    reference1.reset();
+    EXPECT_EQ(2u, atlas.glyphCount());
+    EXPECT_EQ(1u, atlas.iconCount());
+
+    reference2.reset();
+    EXPECT_EQ(0u, atlas.glyphCount());
+    EXPECT_EQ(0u, atlas.iconCount());
+}
+
+TEST(SymbolAtlas, ReusesReleasedBins) {
+    SymbolAtlas atlas;
+
+    const FontStack fontStack { "Open Sans Regular" };
+    GlyphPositions positions;
+    ImagePositions imagePositions;
+
+    GlyphMap large;
+    large[fontStack][u'a'] = makeGlyph(u'a', { 10, 10 }, 255);
+    auto largeReference = atlas.add(large, {}, positions, imagePositions);
+    const auto largeRect = positions.at(fontStack).at(u'a').rect;
+
+    // Keeps the atlas from being reset once the large glyph is released.
+    GlyphMap other;
+    other[fontStack][u'c'] = makeGlyph(u'c', { 10, 10 }, 255);
+    auto otherReference = atlas.add(other, {}, positions, imagePositions);
+
+    largeReference.reset();
+    EXPECT_EQ(1u, atlas.glyphCount());
+
+    GlyphMap small;
+    small[fontStack][u'b'] = makeGlyph(u'b', { 6, 6 }, 128);
+    auto smallReference = atlas.add(small, {}, positions, imagePositions);
+    const auto smallRect = positions.at(fontStack).at(u'b').rect;
+
+    EXPECT_EQ(largeRect.x, smallRect.x);
+    EXPECT_EQ(largeRect.y, smallRect.y);
+
+    // The pixels of the released glyph are cleared, but the new glyph is copied in.
+    const AlphaImage image = atlas.getGlyphAtlasImage();
+    auto pixel = [&] (uint32_t x, uint32_t y) {
+        return image.data[(smallRect.y + y) * image.stride() + smallRect.x + x];
+    };
+    EXPECT_EQ(0, pixel(0, 0));
+    EXPECT_EQ(128, pixel(1, 1));
+    EXPECT_EQ(128, pixel(6, 6));
+    EXPECT_EQ(0, pixel(7, 7));
+    EXPECT_EQ(0, pixel(10, 10));
+}
+
+TEST(SymbolAtlas, OutlivesReferences) {
+    const FontStack fontStack { "Open Sans Regular" };
+    GlyphMap glyphMap;
+    glyphMap[fontStack][u'a'] = makeGlyph(u'a', { 10, 12 }, 255);
+
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+
+    std::shared_ptr<const SymbolAtlas::Reference> reference;
+    {
+        SymbolAtlas atlas;
+        reference = atlas.add(glyphMap, {}, glyphPositions, imagePositions);
+    }
+
+    // Releasing a reference after the atlas is gone must not touch freed memory.
+    reference.reset();
+}
+
+TEST(SymbolAtlas, SkipsEntriesOnceFull) {
+    SymbolAtlas atlas(256);
+
+    const FontStack fontStack { "Open Sans Regular" };
+    GlyphMap glyphMap;
+    for (GlyphID id = 0; id < 100; id++) {
+        glyphMap[fontStack][id] = makeGlyph(id, { 30, 30 }, 255);
+    }
+
+    ImageMap imageMap;
+    imageMap.emplace("huge", makeImage("huge", { 300, 10 }));
+
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+    auto reference = atlas.add(glyphMap, imageMap, glyphPositions, imagePositions);
+
+    // 64 glyphs of 32x32 pixels fit into a 256x256 atlas; the image doesn't fit at all.
+    EXPECT_EQ(64u, atlas.glyphCount());
+    EXPECT_EQ(64u, glyphPositions.at(fontStack).size());
+    EXPECT_EQ(0u, atlas.iconCount());
+    EXPECT_TRUE(imagePositions.empty());
+
+    const AlphaImage image = atlas.getGlyphAtlasImage();
+    EXPECT_EQ(Size(256, 256), image.size);
+    for (const auto& position : glyphPositions.at(fontStack)) {
+        EXPECT_LE(position.second.rect.x + position.second.rect.w, 256);
+        EXPECT_LE(position.second.rect.y + position.second.rect.h, 256);
+    }
+}
+
+TEST(SymbolAtlas, ByteSize) {
+    SymbolAtlas atlas;
+
+    const FontStack fontStack { "Open Sans Regular" };
+    GlyphMap glyphMap;
+    glyphMap[fontStack][u'a'] = makeGlyph(u'a', { 8, 8 }, 255);
+
+    ImageMap imageMap;
+    imageMap.emplace("one", makeImage("one", { 8, 8 }));
+
+    GlyphPositions glyphPositions;
+    ImagePositions imagePositions;
+    auto reference1 = atlas.add(glyphMap, imageMap, glyphPositions, imagePositions);
+    EXPECT_EQ(10u * 10u + 10u * 10u * 4u, SymbolAtlas::byteSize(*reference1));
+
+    // Shared entries are divided among the references.
+    auto reference2 = atlas.add(glyphMap, {}, glyphPositions, imagePositions);
+    EXPECT_EQ(10u * 10u / 2u + 10u * 10u * 4u, SymbolAtlas::byteSize(*reference1));
+    EXPECT_EQ(10u * 10u / 2u, SymbolAtlas::byteSize(*reference2));
+}
@@ -52,6 +52,39 @@ TEST(LocalFileSource, NonEmptyFile) {
     loop.run();
 }
 
+TEST(LocalFileSource, MappedTile) {
+    util::RunLoop loop;
+
+    LocalFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, toAbsoluteURL("nonempty") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_FALSE(res.data.get());
+        ASSERT_TRUE(bool(res.mappedData));
+        EXPECT_EQ("content is here\n", res.mappedData->toString());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(LocalFileSource, MappedEmptyTile) {
+    util::RunLoop loop;
+
+    LocalFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, toAbsoluteURL("empty") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(bool(res.mappedData));
+        EXPECT_EQ(0u, res.mappedData->size());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
 TEST(LocalFileSource, NonExistentFile) {
     util::RunLoop loop;
 
@@ -0,0 +1,132 @@
+#include <mbgl/storage/mbtiles_file_source.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <unistd.h>
+#include <climits>
+#include <gtest/gtest.h>
+
+namespace {
+
+std::string toAbsoluteURL(const std::string& path) {
+    char buff[PATH_MAX + 1];
+    char* cwd = getcwd( buff, PATH_MAX + 1 );
+    std::string url = { "mbtiles://" + std::string(cwd) + "/test/fixtures/storage/tiles.mbtiles" + path };
+    assert(url.size() <= PATH_MAX);
+    return url;
+}
+
+} // namespace
+
+using namespace mbgl;
+
+TEST(MBTilesFileSource, AcceptsURL) {
+    EXPECT_TRUE(MBTilesFileSource::acceptsURL("mbtiles:///tiles.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("file:///tiles.mbtiles"));
+    EXPECT_FALSE(MBTilesFileSource::acceptsURL("http://example.com/tiles.mbtiles"));
+}
+
+TEST(MBTilesFileSource, TileJSON) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Source, toAbsoluteURL("") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_NE(std::string::npos, res.data->find("\"tiles\":[\"" + toAbsoluteURL("/{z}/{x}/{y}") + "\"]"));
+        EXPECT_NE(std::string::npos, res.data->find("\"scheme\":\"tms\""));
+        EXPECT_NE(std::string::npos, res.data->find("\"attribution\":\"Test attribution\""));
+        EXPECT_NE(std::string::npos, res.data->find("\"maxzoom\":1"));
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, Tile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, toAbsoluteURL("/1/0/1") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("raw tile 1/0/1", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, GzippedTile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, toAbsoluteURL("/0/0/0") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("gzipped tile 0/0/0", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, MissingTile) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, toAbsoluteURL("/1/1/1") }, [&](Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        EXPECT_TRUE(res.noContent);
+        EXPECT_FALSE(res.data.get());
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, NonExistentArchive) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs;
+
+    std::unique_ptr<AsyncRequest> req = fs.request({ Resource::Tile, "mbtiles:///does/not/exist.mbtiles/0/0/0" }, [&](Response res) {
+        req.reset();
+        ASSERT_NE(nullptr, res.error);
+        EXPECT_EQ(Response::Error::Reason::NotFound, res.error->reason);
+        loop.stop();
+    });
+
+    loop.run();
+}
+
+TEST(MBTilesFileSource, ConcurrentRequests) {
+    util::RunLoop loop;
+
+    MBTilesFileSource fs(4);
+
+    const std::size_t count = 32;
+    std::size_t completed = 0;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const bool gzipped = i % 2;
+        reqs.push_back(fs.request({ Resource::Tile, toAbsoluteURL(gzipped ? "/0/0/0" : "/1/0/1") }, [&, gzipped](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            EXPECT_EQ(gzipped ? "gzipped tile 0/0/0" : "raw tile 1/0/1",
+                      res.data ? *res.data : std::string());
+            if (++completed == count) {
+                loop.stop();
+            }
+        }));
+    }
+
+    loop.run();
+}
@@ -432,6 +432,24 @@ TEST(OfflineDatabase, PutEvictsLeastRecentlyUsedResources) {
     EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
 }
 
+TEST(OfflineDatabase, BatchedPutsEvictLeastRecentlyUsedResources) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:", 1024 * 100);
+    db.setMaximumBatchSize(16);
+
+    Response response;
+    response.data = randomString(1024);
+
+    for (uint32_t i = 1; i <= 100; i++) {
+        Resource resource = Resource::style("http://example.com/"s + util::toString(i));
+        db.put(resource, response);
+        EXPECT_TRUE(bool(db.get(resource))) << i;
+    }
+
+    EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/1"))));
+}
+
 TEST(OfflineDatabase, PutRegionResourceDoesNotEvict) {
     using namespace mbgl;
 
@@ -462,6 +480,101 @@ TEST(OfflineDatabase, PutFailsWhenEvictionInsuffices) {
     EXPECT_FALSE(bool(db.get(Resource::style("http://example.com/big"))));
 }
 
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(BatchedPuts)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+    deleteFile("test/fixtures/offline_database/offline.db-wal");
+    deleteFile("test/fixtures/offline_database/offline.db-shm");
+
+    OfflineDatabase db("test/fixtures/offline_database/offline.db");
+    db.setWriteAheadLog(true);
+    db.setMaximumBatchSize(3);
+
+    // Counts the resources visible to another connection.
+    auto committed = [] {
+        mapbox::sqlite::Database other("test/fixtures/offline_database/offline.db", mapbox::sqlite::ReadOnly);
+        auto stmt = other.prepare("SELECT COUNT(*) FROM resources");
+        stmt.run();
+        return stmt.get<int64_t>(0);
+    };
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+
+    db.put(Resource::style("http://example.com/1"), response);
+    db.put(Resource::style("http://example.com/2"), response);
+    EXPECT_TRUE(db.hasPendingWrites());
+    EXPECT_TRUE(bool(db.get(Resource::style("http://example.com/1"))));
+    EXPECT_EQ(0, committed());
+
+    db.put(Resource::style("http://example.com/3"), response);
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(3, committed());
+
+    db.put(Resource::style("http://example.com/4"), response);
+    EXPECT_TRUE(db.hasPendingWrites());
+    db.flush();
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(4, committed());
+
+    // Region changes commit pending ambient puts.
+    db.put(Resource::style("http://example.com/5"), response);
+    OfflineRegionDefinition definition { "", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_EQ(5, committed());
+
+    // Region reads only commit them when they mark a resource as used by the region.
+    db.put(Resource::style("http://example.com/6"), response);
+    EXPECT_FALSE(bool(db.getRegionResource(region.getID(), Resource::style("http://example.com/7"))));
+    EXPECT_FALSE(bool(db.hasRegionResource(region.getID(), Resource::style("http://example.com/7"))));
+    EXPECT_EQ(5, committed());
+    EXPECT_TRUE(bool(db.getRegionResource(region.getID(), Resource::style("http://example.com/6"))));
+    EXPECT_EQ(6, committed());
+}
+
+TEST(OfflineDatabase, TEST_REQUIRES_WRITE(GetDoesNotWrite)) {
+    using namespace mbgl;
+
+    createDir("test/fixtures/offline_database");
+    deleteFile("test/fixtures/offline_database/offline.db");
+
+    OfflineDatabase db("test/fixtures/offline_database/offline.db");
+
+    Response response;
+    response.data = std::make_shared<std::string>("data");
+    const Resource style = Resource::style("http://example.com/");
+    const Resource tile = Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 0, Tileset::Scheme::XYZ);
+    db.put(style, response);
+    db.put(tile, response);
+
+    // data_version changes whenever another connection commits to the database.
+    mapbox::sqlite::Database other("test/fixtures/offline_database/offline.db", mapbox::sqlite::ReadOnly);
+    auto dataVersion = [&] {
+        auto stmt = other.prepare("PRAGMA data_version");
+        stmt.run();
+        return stmt.get<int64_t>(0);
+    };
+    const int64_t version = dataVersion();
+
+    // Access times were just set by the puts.
+    EXPECT_TRUE(bool(db.get(style)));
+    EXPECT_TRUE(bool(db.get(tile)));
+    EXPECT_FALSE(db.hasPendingWrites());
+
+    db.setAccessTimeGranularity(Seconds(0));
+    EXPECT_TRUE(bool(db.get(style)));
+    EXPECT_TRUE(bool(db.get(tile)));
+    EXPECT_TRUE(db.hasPendingWrites());
+    EXPECT_EQ(version, dataVersion());
+
+    db.flush();
+    EXPECT_FALSE(db.hasPendingWrites());
+    EXPECT_NE(version, dataVersion());
+}
+
 TEST(OfflineDatabase, GetRegionCompletedStatus) {
     using namespace mbgl;
 
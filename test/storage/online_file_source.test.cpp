@@ -1,10 +1,12 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/online_file_source.hpp>
+#include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/network_status.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/string.hpp>
 
 #include <gtest/gtest.h>
 
@@ -405,6 +407,104 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RateLimitDefault)) {
     loop.run();
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(PendingRequestPriority)) {
+    // Once the concurrent request limit is hit, pending non-tile resources go out before tiles,
+    // and higher priority tiles go out before lower priority tiles queued earlier.
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const uint32_t lowPriorityTiles = HTTPFileSource::maximumConcurrentRequests() * 3;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    uint32_t tilesBeforeStyle = 0;
+    uint32_t tilesBeforeHighPriorityTile = 0;
+    uint32_t completedTiles = 0;
+    bool styleLoaded = false;
+    bool highPriorityTileLoaded = false;
+
+    auto checkDone = [&] {
+        if (styleLoaded && highPriorityTileLoaded && completedTiles == lowPriorityTiles) {
+            loop.stop();
+        }
+    };
+
+    for (uint32_t i = 0; i < lowPriorityTiles; ++i) {
+        Resource resource { Resource::Tile, std::string("http://127.0.0.1:3000/load/") + util::toString(i) };
+        resource.priority = Resource::Low;
+        reqs.push_back(fs.request(resource, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            completedTiles++;
+            checkDone();
+        }));
+    }
+
+    Resource highPriorityTile { Resource::Tile, "http://127.0.0.1:3000/load/1000000" };
+    highPriorityTile.priority = Resource::High;
+    reqs.push_back(fs.request(highPriorityTile, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        tilesBeforeHighPriorityTile = completedTiles;
+        highPriorityTileLoaded = true;
+        checkDone();
+    }));
+
+    reqs.push_back(fs.request({ Resource::Style, "http://127.0.0.1:3000/test" }, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        tilesBeforeStyle = completedTiles;
+        styleLoaded = true;
+        checkDone();
+    }));
+
+    loop.run();
+
+    // Only the requests that were already active may finish first.
+    EXPECT_GE(HTTPFileSource::maximumConcurrentRequests(), tilesBeforeStyle);
+    EXPECT_GE(HTTPFileSource::maximumConcurrentRequests() + 1, tilesBeforeHighPriorityTile);
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(PendingRequestReprioritization)) {
+    // A pending tile request that is raised to a higher priority goes out before the requests
+    // that were queued before it.
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const uint32_t otherTiles = HTTPFileSource::maximumConcurrentRequests() * 3;
+    std::vector<std::unique_ptr<AsyncRequest>> reqs;
+    uint32_t tilesBeforeRaisedTile = 0;
+    uint32_t completedTiles = 0;
+    bool raisedTileLoaded = false;
+
+    auto checkDone = [&] {
+        if (raisedTileLoaded && completedTiles == otherTiles) {
+            loop.stop();
+        }
+    };
+
+    for (uint32_t i = 0; i < otherTiles; ++i) {
+        reqs.push_back(fs.request({ Resource::Tile, std::string("http://127.0.0.1:3000/load/") + util::toString(i) }, [&](Response res) {
+            EXPECT_EQ(nullptr, res.error);
+            // By now, every request is either active or pending.
+            if (completedTiles++ == 0) {
+                fs.setPriority(*reqs.back(), Resource::High);
+            }
+            checkDone();
+        }));
+    }
+
+    Resource raisedTile { Resource::Tile, "http://127.0.0.1:3000/load/1000000" };
+    raisedTile.priority = Resource::Low;
+    reqs.push_back(fs.request(raisedTile, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        tilesBeforeRaisedTile = completedTiles;
+        raisedTileLoaded = true;
+        checkDone();
+    }));
+
+    loop.run();
+
+    // Only the requests that were already active, and the one that took the place of the first
+    // completed request, may finish first.
+    EXPECT_GE(HTTPFileSource::maximumConcurrentRequests() + 2, tilesBeforeRaisedTile);
+}
+
 TEST(OnlineFileSource, ChangeAPIBaseURL){
     util::RunLoop loop;
     OnlineFileSource fs;
@@ -4,6 +4,7 @@
 
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/compiled_filter.hpp>
 #include <mbgl/style/rapidjson_conversion.hpp>
 #include <mbgl/style/conversion.hpp>
 #include <mbgl/style/conversion/filter.hpp>
@@ -126,3 +127,68 @@ TEST(Filter, ID) {
 
     ASSERT_FALSE(parse("[\"==\", \"$id\", 1234]")(feature2));
 }
+
+TEST(Filter, Compiled) {
+    const std::vector<const char*> expressions = {
+        R"(["==", "foo", "bar"])",
+        R"(["!=", "foo", 0])",
+        R"(["<", "foo", 1])",
+        R"(["<=", "foo", 1])",
+        R"([">", "foo", "bar"])",
+        R"([">=", "foo", 0])",
+        R"(["in", "foo", "bar", "baz"])",
+        R"(["in", "foo", "bar", 0, false])",
+        R"(["!in", "foo", "bar", "baz"])",
+        R"(["has", "foo"])",
+        R"(["!has", "foo"])",
+        R"(["==", "$type", "Point"])",
+        R"(["!=", "$type", "LineString"])",
+        R"(["in", "$type", "LineString", "Polygon"])",
+        R"(["!in", "$type", "Point"])",
+        R"(["==", "$id", 1234])",
+        R"(["!in", "$id", 1234, "1234"])",
+        R"(["has", "$id"])",
+        R"(["!has", "$id"])",
+        R"(["any"])",
+        R"(["all"])",
+        R"(["none"])",
+        R"(["all", ["==", "foo", "bar"], ["==", "$type", "Point"], ["has", "baz"]])",
+        R"(["any", ["==", "foo", 0], ["in", "$type", "Polygon"], ["!has", "baz"]])",
+        R"(["none", ["==", "foo", "bar"], ["all", ["has", "baz"], ["==", "$type", "Point"]]])",
+        R"(["all", ["any", ["==", "foo", 0], [">", "baz", 1]], ["!in", "baz", 2, 3], ["!=", "$type", "Polygon"]])",
+        R"(["all", ["==", "a", 1], ["==", "b", 1], ["==", "c", 1], ["==", "d", 1], ["==", "e", 1],
+                   ["==", "f", 1], ["==", "g", 1], ["==", "h", 1], ["==", "i", 1], ["==", "foo", 1]])",
+    };
+
+    std::vector<Feature> features;
+    for (const auto& geometry : std::vector<Geometry<double>> { Point<double>(), LineString<double>(), Polygon<double>() }) {
+        for (const auto& value : std::vector<optional<Value>> { {}, { std::string("bar") }, { std::string("baz") },
+                                                                 { int64_t(0) }, { uint64_t(1) }, { double(2) },
+                                                                 { false }, { mapbox::geometry::null_value } }) {
+            Feature f = feature({{ "baz", int64_t(3) }}, geometry);
+            if (value) {
+                f.properties["foo"] = *value;
+            }
+            features.push_back(f);
+            f.id = { uint64_t(1234) };
+            features.push_back(f);
+            f.properties.erase("baz");
+            f.id = { std::string("1234") };
+            features.push_back(f);
+        }
+    }
+
+    Feature allKeys = feature({});
+    for (const char* key : { "a", "b", "c", "d", "e", "f", "g", "h", "i", "foo" }) {
+        allKeys.properties[key] = int64_t(1);
+    }
+    features.push_back(allKeys);
+
+    for (const auto& expression : expressions) {
+        Filter filter = parse(expression);
+        CompiledFilter compiled(filter);
+        for (const auto& f : features) {
+            EXPECT_EQ(filter(f), compiled(f)) << expression;
+        }
+    }
+}
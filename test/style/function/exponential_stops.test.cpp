@@ -18,3 +18,25 @@ TEST(ExponentialStops, NonNumericInput) {
     EXPECT_FALSE(bool(stops.evaluate(Value(std::vector<Value>()))));
     EXPECT_FALSE(bool(stops.evaluate(Value(std::unordered_map<std::string, Value>()))));
 }
+
+TEST(ExponentialStops, Interpolation) {
+    const std::map<float, float> map {{ 0.0f, 1.0f }, { 5.0f, 10.0f }, { 7.5f, 2.0f }, { 12.0f, 20.0f }};
+
+    for (float base : { 1.0f, 1.5f, 0.5f }) {
+        ExponentialStops<float> stops(map, base);
+        EXPECT_EQ(1.0f, *stops.evaluate(-1.0f));
+        EXPECT_EQ(10.0f, *stops.evaluate(5.0f));
+        EXPECT_EQ(20.0f, *stops.evaluate(15.0f));
+
+        // The precomputed tables give the same results as interpolating between the stops.
+        for (float z = 0.0f; z <= 12.0f; z += 0.25f) {
+            auto it = map.upper_bound(z);
+            if (it == map.begin() || it == map.end()) {
+                continue;
+            }
+            const float expected = util::interpolate(std::prev(it)->second, it->second,
+                util::interpolationFactor(base, { std::prev(it)->first, it->first }, z));
+            EXPECT_EQ(expected, *stops.evaluate(z)) << "base " << base << ", z " << z;
+        }
+    }
+}
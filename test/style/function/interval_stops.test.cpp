@@ -18,3 +18,14 @@ TEST(IntervalStops, NonNumericInput) {
     EXPECT_FALSE(bool(stops.evaluate(Value(std::vector<Value>()))));
     EXPECT_FALSE(bool(stops.evaluate(Value(std::unordered_map<std::string, Value>()))));
 }
+
+TEST(IntervalStops, Stops) {
+    IntervalStops<float> stops(std::map<float, float> {{ 0.0f, 1.0f }, { 5.0f, 10.0f }, { 7.5f, 2.0f }});
+    EXPECT_EQ(1.0f, *stops.evaluate(-1.0f));
+    EXPECT_EQ(1.0f, *stops.evaluate(0.0f));
+    EXPECT_EQ(1.0f, *stops.evaluate(4.9f));
+    EXPECT_EQ(10.0f, *stops.evaluate(5.0f));
+    EXPECT_EQ(10.0f, *stops.evaluate(7.4f));
+    EXPECT_EQ(2.0f, *stops.evaluate(7.5f));
+    EXPECT_EQ(2.0f, *stops.evaluate(Value(uint64_t(20))));
+}
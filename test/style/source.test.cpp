@@ -33,6 +33,8 @@
 #include <mbgl/annotation/annotation_source.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <cstdint>
 
@@ -50,6 +52,8 @@ public:
     AnnotationManager annotationManager;
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    SymbolAtlas symbolAtlas;
+    TileCache tileCache;
 
     TileParameters tileParameters {
         1.0,
@@ -60,7 +64,9 @@ public:
         MapMode::Continuous,
         annotationManager,
         imageManager,
-        glyphManager
+        glyphManager,
+        symbolAtlas,
+        tileCache
     };
 
     SourceTest() {
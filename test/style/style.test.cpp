@@ -99,3 +99,37 @@ TEST(Style, RemoveSourceInUse) {
 
     EXPECT_EQ(log->count(logMessage), 1u);
 }
+
+TEST(Style, SharedLayers) {
+    util::RunLoop loop;
+
+    ThreadPool threadPool{ 1 };
+    StubFileSource fileSource;
+    Style::Impl style1 { threadPool, fileSource, 1.0 };
+    Style::Impl style2 { threadPool, fileSource, 1.0 };
+
+    const std::string json = util::read_file("test/fixtures/resources/style-unused-sources.json");
+    style1.loadJSON(json);
+    style2.loadJSON(json);
+
+    // Both styles have their own layers, which share the parsed properties.
+    auto layers1 = style1.getLayers();
+    auto layers2 = style2.getLayers();
+    ASSERT_EQ(layers1.size(), layers2.size());
+    ASSERT_FALSE(layers1.empty());
+    for (size_t i = 0; i < layers1.size(); i++) {
+        EXPECT_NE(layers1[i], layers2[i]);
+        EXPECT_EQ(layers1[i]->baseImpl, layers2[i]->baseImpl);
+    }
+
+    // Changing a layer of one style doesn't affect the other.
+    layers1[0]->setVisibility(VisibilityType::None);
+    EXPECT_NE(layers1[0]->baseImpl, layers2[0]->baseImpl);
+    EXPECT_EQ(VisibilityType::Visible, layers2[0]->getVisibility());
+
+    // A style that differs in content is parsed anew.
+    Style::Impl style3 { threadPool, fileSource, 1.0 };
+    style3.loadJSON(json + " ");
+    ASSERT_FALSE(style3.getLayers().empty());
+    EXPECT_NE(layers2[0]->baseImpl, style3.getLayers()[0]->baseImpl);
+}
@@ -6,7 +6,9 @@
 #include <mbgl/map/transform.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/renderer/render_style.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/geometry/feature_index.hpp>
@@ -14,6 +16,8 @@
 #include <mbgl/annotation/annotation_tile.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/map/backend_scope.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 
@@ -33,6 +37,8 @@ public:
     RenderStyle style { threadPool, fileSource };
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    SymbolAtlas symbolAtlas;
+    TileCache tileCache;
 
     TileParameters tileParameters {
         1.0,
@@ -43,7 +49,9 @@ public:
         MapMode::Continuous,
         annotationManager,
         imageManager,
-        glyphManager
+        glyphManager,
+        symbolAtlas,
+        tileCache
     };
 };
 
@@ -72,8 +80,8 @@ TEST(AnnotationTile, Issue8289) {
 
     tile.onPlacement(GeometryTile::PlacementResult {
         {},
-        std::move(collisionTile),
         {},
+        std::move(collisionTile),
         {},
         0
     });
@@ -86,13 +94,12 @@ TEST(AnnotationTile, Issue8289) {
         0
     });
 
-    std::unordered_map<std::string, std::vector<Feature>> result;
     GeometryCoordinates queryGeometry {{ Point<int16_t>(0, 0) }};
     TransformState transformState;
-    RenderedQueryOptions options;
+    RenderedFeatureQuery query({}, transformState.getAngle());
 
-    tile.queryRenderedFeatures(result, queryGeometry, transformState, test.style, options);
+    tile.queryRenderedFeatures(query, queryGeometry, transformState);
 
-    EXPECT_TRUE(result.empty());
+    EXPECT_TRUE(query.run().empty());
 }
 
@@ -8,10 +8,17 @@
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/renderer/buckets/circle_bucket.hpp>
+#include <mbgl/renderer/feature_query.hpp>
+#include <mbgl/renderer/render_layer.hpp>
+#include <mbgl/renderer/transition_parameters.hpp>
+#include <mbgl/renderer/property_evaluation_parameters.hpp>
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <memory>
 
@@ -27,6 +34,8 @@ public:
     AnnotationManager annotationManager;
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    SymbolAtlas symbolAtlas;
+    TileCache tileCache;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -38,7 +47,9 @@ public:
         MapMode::Continuous,
         annotationManager,
         imageManager,
-        glyphManager
+        glyphManager,
+        symbolAtlas,
+        tileCache
     };
 };
 
@@ -74,3 +85,155 @@ TEST(GeoJSONTile, Issue7648) {
         test.loop.runOnce();
     }
 }
+
+namespace {
+
+mapbox::geometry::feature_collection<int16_t> kindFeatures() {
+    mapbox::geometry::feature_collection<int16_t> features;
+    for (const auto& kind : { "a", "b" }) {
+        mapbox::geometry::feature<int16_t> feature { mapbox::geometry::point<int16_t>(0, 0) };
+        feature.properties["kind"] = std::string(kind);
+        features.push_back(std::move(feature));
+    }
+    return features;
+}
+
+void layOut(GeoJSONTileTest& test, GeoJSONTile& tile, const std::vector<Immutable<Layer::Impl>>& layers) {
+    tile.setLayers(layers);
+    tile.setPlacementConfig({});
+    while (!tile.isComplete()) {
+        test.loop.runOnce();
+    }
+}
+
+} // namespace
+
+TEST(GeoJSONTile, RelayoutReusesUnchangedBuckets) {
+    GeoJSONTileTest test;
+    const auto features = kindFeatures();
+
+    CircleLayer layer("circle", "source");
+    GeoJSONTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+    layOut(test, tile, {{ layer.baseImpl }});
+
+    auto* bucket = static_cast<CircleBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, bucket);
+    EXPECT_EQ(8u, bucket->vertices.vertexSize());
+
+    // A paint-only change keeps the bucket, which matches the one of a fresh layout.
+    layer.setCircleColor(Color::red());
+    layOut(test, tile, {{ layer.baseImpl }});
+    EXPECT_EQ(bucket, tile.getBucket(*layer.baseImpl));
+
+    GeoJSONTile freshTile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+    layOut(test, freshTile, {{ layer.baseImpl }});
+    auto* freshBucket = static_cast<CircleBucket*>(freshTile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, freshBucket);
+    EXPECT_EQ(freshBucket->vertices.vertexSize(), bucket->vertices.vertexSize());
+    EXPECT_EQ(freshBucket->triangles.indexSize(), bucket->triangles.indexSize());
+    EXPECT_EQ(freshBucket->segments.size(), bucket->segments.size());
+
+    // A filter change rebuilds it.
+    layer.setFilter(EqualsFilter { "kind", std::string("a") });
+    layOut(test, tile, {{ layer.baseImpl }});
+    auto* filteredBucket = static_cast<CircleBucket*>(tile.getBucket(*layer.baseImpl));
+    ASSERT_NE(nullptr, filteredBucket);
+    EXPECT_NE(bucket, filteredBucket);
+    EXPECT_EQ(4u, filteredBucket->vertices.vertexSize());
+
+    // So does a change to a data-driven paint property, which needs new vertex attributes.
+    layer.setCircleRadius(SourceFunction<float>("radius", ExponentialStops<float>({{ 0.0f, 1.0f }, { 10.0f, 10.0f }}, 1.0f)));
+    layOut(test, tile, {{ layer.baseImpl }});
+    EXPECT_NE(filteredBucket, tile.getBucket(*layer.baseImpl));
+}
+
+TEST(GeoJSONTile, ParallelLayoutMatchesSerialLayout) {
+    GeoJSONTileTest test;
+
+    mapbox::geometry::feature_collection<int16_t> features;
+    for (uint64_t i = 0; i < 60; ++i) {
+        mapbox::geometry::feature<int16_t> feature {
+            mapbox::geometry::point<int16_t>(int16_t(i * 131 % 8192), int16_t(i * 977 % 8192))
+        };
+        feature.id = i;
+        feature.properties["kind"] = std::string(i % 3 == 0 ? "a" : i % 3 == 1 ? "b" : "c");
+        features.push_back(std::move(feature));
+    }
+
+    // Layers with different filters end up in separate layout groups.
+    std::vector<std::unique_ptr<CircleLayer>> layers;
+    std::vector<Immutable<Layer::Impl>> impls;
+    for (const auto& kind : { "a", "b", "c" }) {
+        for (const auto& prefix : { "x", "y" }) {
+            auto layer = std::make_unique<CircleLayer>(std::string(prefix) + kind, "source");
+            if (std::string(prefix) == "x") {
+                layer->setFilter(EqualsFilter { "kind", std::string(kind) });
+            } else {
+                layer->setFilter(NotEqualsFilter { "kind", std::string(kind) });
+            }
+            impls.push_back(layer->baseImpl);
+            layers.push_back(std::move(layer));
+        }
+    }
+
+    ThreadPool threadPool { 4 };
+    TileParameters parallelParameters {
+        1.0,
+        MapDebugOptions(),
+        test.transformState,
+        threadPool,
+        test.fileSource,
+        MapMode::Continuous,
+        test.annotationManager,
+        test.imageManager,
+        test.glyphManager,
+        test.symbolAtlas,
+        test.tileCache,
+        0,
+        true
+    };
+
+    GeoJSONTile serialTile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, features);
+    GeoJSONTile parallelTile(OverscaledTileID(0, 0, 0), "source", parallelParameters, features);
+    layOut(test, serialTile, impls);
+    layOut(test, parallelTile, impls);
+
+    for (const auto& impl : impls) {
+        auto* serialBucket = static_cast<CircleBucket*>(serialTile.getBucket(*impl));
+        auto* parallelBucket = static_cast<CircleBucket*>(parallelTile.getBucket(*impl));
+        ASSERT_NE(nullptr, serialBucket);
+        ASSERT_NE(nullptr, parallelBucket);
+        EXPECT_EQ(serialBucket->vertices.vertexSize(), parallelBucket->vertices.vertexSize());
+        EXPECT_EQ(serialBucket->triangles.indexSize(), parallelBucket->triangles.indexSize());
+        EXPECT_EQ(serialBucket->segments.size(), parallelBucket->segments.size());
+    }
+
+    // Both feature indexes return the same features, in the same order, for every layer.
+    std::vector<std::unique_ptr<RenderLayer>> renderLayers;
+    for (const auto& impl : impls) {
+        renderLayers.push_back(RenderLayer::create(impl));
+        renderLayers.back()->transition(TransitionParameters { Clock::now(), {} });
+        renderLayers.back()->evaluate(PropertyEvaluationParameters(0));
+    }
+
+    auto query = [&] (GeoJSONTile& tile) {
+        RenderedFeatureQuery featureQuery({}, test.transformState.getAngle());
+        for (const auto& renderLayer : renderLayers) {
+            featureQuery.addLayer(*renderLayer);
+        }
+        GeometryCoordinates queryGeometry {
+            { -100, -100 }, { 8300, -100 }, { 8300, 8300 }, { -100, 8300 }, { -100, -100 }
+        };
+        tile.queryRenderedFeatures(featureQuery, queryGeometry, test.transformState);
+
+        std::vector<uint64_t> ids;
+        for (const auto& feature : featureQuery.run()) {
+            ids.push_back(feature.id->get<uint64_t>());
+        }
+        return ids;
+    };
+
+    const auto serialIDs = query(serialTile);
+    EXPECT_EQ(180u, serialIDs.size());
+    EXPECT_EQ(serialIDs, query(parallelTile));
+}
@@ -11,6 +11,8 @@
 #include <mbgl/renderer/buckets/raster_bucket.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 using namespace mbgl;
 
@@ -23,6 +25,8 @@ public:
     AnnotationManager annotationManager;
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    SymbolAtlas symbolAtlas;
+    TileCache tileCache;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -34,7 +38,9 @@ public:
         MapMode::Continuous,
         annotationManager,
         imageManager,
-        glyphManager
+        glyphManager,
+        symbolAtlas,
+        tileCache
     };
 };
 
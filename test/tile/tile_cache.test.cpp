@@ -0,0 +1,149 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_cache.hpp>
+#include <mbgl/tile/tile.hpp>
+#include <mbgl/renderer/tile_pyramid.hpp>
+
+#include <memory>
+
+using namespace mbgl;
+
+class FakeTile : public Tile {
+public:
+    FakeTile(const OverscaledTileID& id_, std::size_t size_, bool renderable_ = true)
+        : Tile(id_), size(size_) {
+        renderable = renderable_;
+    }
+
+    void setNecessity(Necessity) override {}
+    void cancel() override {}
+    void upload(gl::Context&) override {}
+    Bucket* getBucket(const style::Layer::Impl&) const override {
+        return nullptr;
+    }
+
+    std::size_t byteSize() const override {
+        return size;
+    }
+
+    // Simulates a layout that finishes while the tile is cached.
+    void resize(std::size_t size_) {
+        size = size_;
+        observer->onTileChanged(*this);
+    }
+
+private:
+    std::size_t size;
+};
+
+static std::unique_ptr<Tile> makeTile(const OverscaledTileID& id, std::size_t size, bool renderable = true) {
+    return std::make_unique<FakeTile>(id, size, renderable);
+}
+
+TEST(TileCache, AddGet) {
+    TilePyramid pyramid;
+    TileCache cache(100);
+
+    const OverscaledTileID id { 1, 0, 0 };
+    cache.add(pyramid, id, makeTile(id, 10));
+    EXPECT_TRUE(cache.has(pyramid, id));
+    EXPECT_EQ(10u, cache.getCurrentSize());
+
+    auto tile = cache.get(pyramid, id);
+    ASSERT_TRUE(tile);
+    EXPECT_EQ(id, tile->id);
+    EXPECT_FALSE(cache.has(pyramid, id));
+    EXPECT_EQ(0u, cache.getCurrentSize());
+    EXPECT_FALSE(cache.get(pyramid, id));
+}
+
+TEST(TileCache, SkipsUnrenderableAndOversizedTiles) {
+    TilePyramid pyramid;
+    TileCache cache(100);
+
+    const OverscaledTileID a { 1, 0, 0 };
+    const OverscaledTileID b { 1, 0, 1 };
+    cache.add(pyramid, a, makeTile(a, 10, false));
+    cache.add(pyramid, b, makeTile(b, 101));
+    EXPECT_EQ(0u, cache.getCount());
+    EXPECT_EQ(0u, cache.getCurrentSize());
+}
+
+TEST(TileCache, EvictsLeastRecentlyUsedByteSize) {
+    TilePyramid pyramid;
+    TileCache cache(100);
+
+    const OverscaledTileID a { 1, 0, 0 };
+    const OverscaledTileID b { 1, 0, 1 };
+    const OverscaledTileID c { 1, 1, 0 };
+    cache.add(pyramid, a, makeTile(a, 40));
+    cache.add(pyramid, b, makeTile(b, 40));
+
+    // Re-adding a tile makes it the most recently used one, and replaces its size.
+    cache.add(pyramid, a, makeTile(a, 50));
+    EXPECT_EQ(90u, cache.getCurrentSize());
+
+    cache.add(pyramid, c, makeTile(c, 30));
+    EXPECT_TRUE(cache.has(pyramid, a));
+    EXPECT_FALSE(cache.has(pyramid, b));
+    EXPECT_TRUE(cache.has(pyramid, c));
+    EXPECT_EQ(80u, cache.getCurrentSize());
+
+    cache.setSize(40);
+    EXPECT_FALSE(cache.has(pyramid, a));
+    EXPECT_TRUE(cache.has(pyramid, c));
+    EXPECT_EQ(30u, cache.getCurrentSize());
+
+    cache.setSize(0);
+    EXPECT_EQ(0u, cache.getCount());
+    EXPECT_EQ(0u, cache.getCurrentSize());
+}
+
+TEST(TileCache, SharedBetweenPyramids) {
+    TilePyramid first;
+    TilePyramid second;
+    TileCache cache(100);
+
+    const OverscaledTileID id { 1, 0, 0 };
+    cache.add(first, id, makeTile(id, 60));
+    EXPECT_FALSE(cache.has(second, id));
+
+    // Tiles of all pyramids count against the same budget.
+    cache.add(second, id, makeTile(id, 60));
+    EXPECT_FALSE(cache.has(first, id));
+    EXPECT_TRUE(cache.has(second, id));
+
+    const OverscaledTileID other { 1, 0, 1 };
+    cache.add(first, other, makeTile(other, 20));
+    cache.clear(second);
+    EXPECT_FALSE(cache.has(second, id));
+    EXPECT_TRUE(cache.has(first, other));
+    EXPECT_EQ(20u, cache.getCurrentSize());
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getCount());
+    EXPECT_EQ(0u, cache.getCurrentSize());
+}
+
+TEST(TileCache, MeasuresChangedTiles) {
+    TilePyramid pyramid;
+    TileCache cache(100);
+
+    const OverscaledTileID a { 1, 0, 0 };
+    const OverscaledTileID b { 1, 0, 1 };
+    cache.add(pyramid, a, makeTile(a, 10));
+    auto tile = std::make_unique<FakeTile>(b, 10);
+    FakeTile& cachedTile = *tile;
+    cache.add(pyramid, b, std::move(tile));
+    EXPECT_EQ(20u, cache.getCurrentSize());
+
+    // A tile that grows while it's cached is measured again, and evicts older tiles to stay
+    // within the budget.
+    cachedTile.resize(95);
+    EXPECT_EQ(95u, cache.getCurrentSize());
+    EXPECT_FALSE(cache.has(pyramid, a));
+    EXPECT_TRUE(cache.has(pyramid, b));
+
+    EXPECT_TRUE(cache.get(pyramid, b));
+    EXPECT_EQ(0u, cache.getCurrentSize());
+}
@@ -2,19 +2,25 @@
 #include <mbgl/test/fake_file_source.hpp>
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
+#include <mbgl/tile/vector_tile_data.hpp>
 
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/mapped_file.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/map/query.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/renderer/tile_parameters.hpp>
+#include <mbgl/renderer/feature_query.hpp>
 #include <mbgl/renderer/buckets/symbol_bucket.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/renderer/image_manager.hpp>
 #include <mbgl/text/glyph_manager.hpp>
+#include <mbgl/renderer/symbol_atlas.hpp>
+#include <mbgl/tile/tile_cache.hpp>
 
 #include <memory>
 
@@ -29,6 +35,8 @@ public:
     AnnotationManager annotationManager;
     ImageManager imageManager;
     GlyphManager glyphManager { fileSource };
+    SymbolAtlas symbolAtlas;
+    TileCache tileCache;
     Tileset tileset { { "https://example.com" }, { 0, 22 }, "none" };
 
     TileParameters tileParameters {
@@ -40,7 +48,9 @@ public:
         MapMode::Continuous,
         annotationManager,
         imageManager,
-        glyphManager
+        glyphManager,
+        symbolAtlas,
+        tileCache
     };
 };
 
@@ -80,8 +90,8 @@ TEST(VectorTile, Issue7615) {
             symbolLayer.getID(),
             symbolBucket
         }},
-        nullptr,
         {},
+        nullptr,
         {},
         0
     });
@@ -102,6 +112,62 @@ TEST(VectorTile, Issue8542) {
     VectorTile tile(OverscaledTileID(0, 0, 0), "source", test.tileParameters, test.tileset);
 
     // Query before data is set
-    std::vector<Feature> result;
-    tile.querySourceFeatures(result, { { {"layer"} }, {} });
+    SourceFeatureQuery query({ { {"layer"} }, {} });
+    tile.querySourceFeatures(query);
+    EXPECT_TRUE(query.run().empty());
+}
+
+TEST(VectorTile, SharedDecodedLayer) {
+    auto data = std::make_shared<std::string>(util::read_file("test/fixtures/api/assets/streets/10-163-395.vector.pbf"));
+
+    VectorTileData shared(data);
+    auto first = shared.getLayer("road");
+    auto second = shared.getLayer("road");
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    auto reference = VectorTileData(data).getLayer("road");
+    ASSERT_TRUE(reference);
+    ASSERT_EQ(reference->featureCount(), first->featureCount());
+    ASSERT_EQ(reference->featureCount(), second->featureCount());
+
+    for (std::size_t i = 0; i < reference->featureCount(); i++) {
+        auto expected = reference->getFeature(i);
+        for (const auto& layer : { first.get(), second.get() }) {
+            auto feature = layer->getFeature(i);
+            EXPECT_EQ(expected->getType(), feature->getType());
+            EXPECT_EQ(expected->getID(), feature->getID());
+            EXPECT_EQ(expected->getProperties(), feature->getProperties());
+            EXPECT_EQ(expected->getValue("class"), feature->getValue("class"));
+            EXPECT_EQ(expected->getGeometries(), feature->getGeometries());
+        }
+    }
+
+    // Features keep the decoded layer alive after the layer object is gone.
+    auto feature = first->getFeature(0);
+    first.reset();
+    second.reset();
+    EXPECT_EQ(reference->getFeature(0)->getGeometries(), feature->getGeometries());
+}
+
+TEST(VectorTile, MappedData) {
+    const std::string path = "test/fixtures/api/assets/streets/10-163-395.vector.pbf";
+    VectorTileData reference(std::make_shared<std::string>(util::read_file(path)));
+    auto data = VectorTileData(util::MappedData(std::make_shared<const util::MappedFile>(path))).clone();
+
+    EXPECT_EQ(reference.layerNames(), static_cast<VectorTileData&>(*data).layerNames());
+
+    auto expected = reference.getLayer("road");
+    auto layer = data->getLayer("road");
+    ASSERT_TRUE(expected);
+    ASSERT_TRUE(layer);
+    ASSERT_EQ(expected->featureCount(), layer->featureCount());
+    for (std::size_t i = 0; i < expected->featureCount(); i++) {
+        EXPECT_EQ(expected->getFeature(i)->getProperties(), layer->getFeature(i)->getProperties());
+        EXPECT_EQ(expected->getFeature(i)->getGeometries(), layer->getFeature(i)->getGeometries());
+    }
+
+    // The layer keeps the mapping alive.
+    data.reset();
+    EXPECT_EQ(expected->getFeature(0)->getGeometries(), layer->getFeature(0)->getGeometries());
 }
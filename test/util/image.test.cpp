@@ -163,3 +163,58 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(0u, rgba.size.width);
     EXPECT_EQ(0u, rgba.size.height);
 }
+
+namespace {
+
+// Fills an image with every combination of color and alpha values.
+template <class Image>
+Image allValues() {
+    Image image({ 256, 256 });
+    for (uint32_t a = 0; a < 256; ++a) {
+        for (uint32_t c = 0; c < 256; ++c) {
+            uint8_t* pixel = image.data.get() + (a * 256 + c) * 4;
+            pixel[0] = c;
+            pixel[1] = 255 - c;
+            pixel[2] = c / 2;
+            pixel[3] = a;
+        }
+    }
+    return image;
+}
+
+} // namespace
+
+TEST(Image, PremultiplyAllValues) {
+    const UnassociatedImage rgba = allValues<UnassociatedImage>();
+    const PremultipliedImage image = util::premultiply(rgba.clone());
+
+    for (size_t i = 0; i < rgba.bytes(); i += 4) {
+        const uint8_t a = rgba.data[i + 3];
+        for (size_t j = 0; j < 3; ++j) {
+            ASSERT_EQ((rgba.data[i + j] * a + 127) / 255, image.data[i + j]) << i;
+        }
+        ASSERT_EQ(a, image.data[i + 3]);
+    }
+}
+
+TEST(Image, UnpremultiplyAllValues) {
+    const PremultipliedImage rgba = allValues<PremultipliedImage>();
+    const UnassociatedImage image = util::unpremultiply(rgba.clone());
+
+    for (size_t i = 0; i < rgba.bytes(); i += 4) {
+        const uint8_t a = rgba.data[i + 3];
+        for (size_t j = 0; j < 3; ++j) {
+            // Colors greater than alpha are invalid, and overflow.
+            const uint8_t expected = a ? (255 * rgba.data[i + j] + a / 2) / a : rgba.data[i + j];
+            ASSERT_EQ(expected, image.data[i + j]) << i;
+        }
+        ASSERT_EQ(a, image.data[i + 3]);
+    }
+}
+
+TEST(Image, DecodeUnassociated) {
+    for (const auto& name : { "tile.png", "tile.jpeg", "profile_alpha.png", "no_profile_alpha.png" }) {
+        const std::string data = util::read_file(std::string("test/fixtures/image/") + name);
+        EXPECT_EQ(decodeImage(data), util::premultiply(decodeUnassociatedImage(data))) << name;
+    }
+}
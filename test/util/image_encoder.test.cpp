@@ -0,0 +1,100 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/image_encoder.hpp>
+#include <mbgl/util/premultiply.hpp>
+
+#include <cstring>
+
+using namespace mbgl;
+
+namespace {
+
+// An image with gradients, transparent areas and more than 256 colors.
+PremultipliedImage makeImage() {
+    UnassociatedImage image({ 64, 48 });
+    for (uint32_t y = 0; y < image.size.height; y++) {
+        for (uint32_t x = 0; x < image.size.width; x++) {
+            uint8_t* pixel = image.data.get() + y * image.stride() + x * 4;
+            pixel[0] = x * 4;
+            pixel[1] = y * 5;
+            pixel[2] = (x * y) % 256;
+            pixel[3] = x < 8 ? 0 : 255 - y;
+        }
+    }
+    return util::premultiply(std::move(image));
+}
+
+PremultipliedImage makeFewColorsImage() {
+    PremultipliedImage image({ 40, 30 });
+    for (uint32_t y = 0; y < image.size.height; y++) {
+        for (uint32_t x = 0; x < image.size.width; x++) {
+            uint8_t* pixel = image.data.get() + y * image.stride() + x * 4;
+            const uint8_t value = (x / 10 + y / 10) * 40;
+            pixel[0] = value;
+            pixel[1] = 0;
+            pixel[2] = value / 2;
+            pixel[3] = y < 10 ? 128 : 255;
+        }
+    }
+    return image;
+}
+
+void expectEqual(const PremultipliedImage& a, const PremultipliedImage& b) {
+    ASSERT_EQ(a.size, b.size);
+    EXPECT_EQ(0, std::memcmp(a.data.get(), b.data.get(), a.bytes()));
+}
+
+} // namespace
+
+TEST(ImageEncoder, MatchesEncodePNG) {
+    const PremultipliedImage image = makeImage();
+    const PremultipliedImage expected = decodeImage(encodePNG(image));
+
+    for (auto filter : { ImageEncoder::PNGFilter::None, ImageEncoder::PNGFilter::Sub,
+                         ImageEncoder::PNGFilter::Up, ImageEncoder::PNGFilter::Adaptive }) {
+        ImageEncoder::Options options;
+        options.filter = filter;
+        ImageEncoder encoder(options);
+
+        // The encoder state is reused between images.
+        expectEqual(expected, decodeImage(encoder.encodePNG(image)));
+        expectEqual(expected, decodeImage(encoder.encodePNG(image)));
+    }
+}
+
+TEST(ImageEncoder, CompressionLevel) {
+    const PremultipliedImage image = makeImage();
+
+    ImageEncoder::Options store;
+    store.compressionLevel = 0;
+    ImageEncoder::Options best;
+    best.compressionLevel = 9;
+
+    const std::string stored = ImageEncoder(store).encodePNG(image);
+    const std::string compressed = ImageEncoder(best).encodePNG(image);
+    EXPECT_LT(compressed.size(), stored.size());
+    expectEqual(decodeImage(stored), decodeImage(compressed));
+}
+
+TEST(ImageEncoder, Palette) {
+    ImageEncoder::Options options;
+    options.palette = true;
+    ImageEncoder encoder(options);
+
+    // Images with at most 256 colors are encoded losslessly.
+    const PremultipliedImage image = makeFewColorsImage();
+    const PremultipliedImage expected = decodeImage(encodePNG(image));
+    const std::string png = encoder.encodePNG(image);
+    EXPECT_EQ(3, png[25]); // IHDR color type == indexed
+    expectEqual(expected, decodeImage(png));
+
+    // Other images are quantized to 256 colors.
+    const PremultipliedImage many = makeImage();
+    const PremultipliedImage quantized = decodeImage(encoder.encodePNG(many));
+    ASSERT_EQ(many.size, quantized.size);
+    const PremultipliedImage reference = decodeImage(encodePNG(many));
+    for (std::size_t i = 0; i < reference.bytes(); i++) {
+        EXPECT_NEAR(reference.data[i], quantized.data[i], 64) << i;
+    }
+}
@@ -28,6 +28,38 @@ TEST(OffscreenTexture, EmptyRed) {
     test::checkImage("test/fixtures/offscreen_texture/empty-red", image, 0, 0);
 }
 
+TEST(OffscreenTexture, PendingReads) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    BackendScope scope { backend };
+    OffscreenView view(backend.getContext(), { 512, 256 });
+
+    view.bind();
+
+    MBGL_CHECK_ERROR(glClearColor(1.0f, 0.0f, 0.0f, 1.0f));
+    MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+    view.startStillImageRead();
+
+    // Drawing after starting a read must not change the pixels it returns.
+    MBGL_CHECK_ERROR(glClearColor(0.0f, 0.0f, 1.0f, 1.0f));
+    MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+    view.startStillImageRead();
+
+    MBGL_CHECK_ERROR(glClearColor(1.0f, 0.0f, 0.0f, 1.0f));
+    MBGL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+
+    auto image = view.readStillImage();
+    test::checkImage("test/fixtures/offscreen_texture/empty-red", image, 0, 0);
+
+    image = view.readStillImage(false);
+    ASSERT_EQ(Size(512, 256), image.size);
+    EXPECT_EQ(0, image.data[0]);
+    EXPECT_EQ(255, image.data[2]);
+
+    // Without pending reads, the current contents of the view are returned.
+    image = view.readStillImage();
+    test::checkImage("test/fixtures/offscreen_texture/empty-red", image, 0, 0);
+}
+
 struct Shader {
     Shader(const GLchar* vertex, const GLchar* fragment) {
         program = MBGL_CHECK_ERROR(glCreateProgram());
@@ -0,0 +1,62 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/parallel_for.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/actor/actor.hpp>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ParallelFor, CallsEachIndexOnce) {
+    ThreadPool pool(4);
+
+    std::vector<std::size_t> calls(100, 0);
+    util::parallelFor(pool, calls.size(), 3, [&] (std::size_t i) {
+        ++calls[i];
+    });
+
+    EXPECT_EQ(std::vector<std::size_t>(100, 1), calls);
+}
+
+TEST(ParallelFor, CompletesWhenSchedulerIsBusy) {
+    ThreadPool pool(1);
+    std::promise<void> done;
+
+    // Call from the pool's only thread, so that no helper can run until the caller returns.
+    struct Caller {
+        Caller(ActorRef<Caller>, Scheduler& scheduler_) : scheduler(scheduler_) {}
+
+        void run(std::promise<void> promise) {
+            std::size_t sum = 0;
+            util::parallelFor(scheduler, 10, 3, [&] (std::size_t i) {
+                sum += i;
+            });
+            EXPECT_EQ(45u, sum);
+            promise.set_value();
+        }
+
+        Scheduler& scheduler;
+    };
+
+    Actor<Caller> caller(pool, pool);
+    std::future<void> result = done.get_future();
+    caller.invoke(&Caller::run, std::move(done));
+    result.get();
+}
+
+TEST(ParallelFor, RethrowsAfterCompletion) {
+    ThreadPool pool(2);
+
+    std::atomic<std::size_t> calls { 0 };
+    EXPECT_THROW(util::parallelFor(pool, 10, 1, [&] (std::size_t i) {
+        ++calls;
+        if (i == 3) {
+            throw std::runtime_error("failure");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(10u, calls);
+}
@@ -0,0 +1,41 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/resource_registry.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+struct Parsed {
+    std::string value;
+};
+
+} // namespace
+
+TEST(ResourceRegistry, Share) {
+    using Registry = util::ResourceRegistry<Parsed>;
+    auto& registry = Registry::get();
+    EXPECT_EQ(&registry, &Registry::get());
+
+    const Registry::Key key { "mapbox://sprites/a", std::string("image"), std::string("json") };
+    EXPECT_FALSE(registry.find(key));
+
+    auto a = registry.insert(key, Parsed { "a" });
+    EXPECT_EQ("a", a->value);
+    EXPECT_EQ(a, registry.find(key));
+    EXPECT_EQ(1u, registry.size());
+
+    // A second insert for the same key, e.g. by a map that parsed it concurrently, yields the
+    // registered resource.
+    EXPECT_EQ(a, registry.insert(key, Parsed { "b" }));
+
+    // Different data or URL are different keys.
+    EXPECT_FALSE(registry.find({ "mapbox://sprites/a", std::string("image"), std::string("json2") }));
+    EXPECT_FALSE(registry.find({ "mapbox://sprites/a", std::string("imagejson"), std::string() }));
+    EXPECT_FALSE(registry.find({ "mapbox://sprites/b", std::string("image"), std::string("json") }));
+
+    // Resources are released once no longer used.
+    a.reset();
+    EXPECT_FALSE(registry.find(key));
+    EXPECT_EQ(0u, registry.size());
+}